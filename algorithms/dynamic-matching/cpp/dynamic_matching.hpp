@@ -0,0 +1,401 @@
+/*
+ * Dynamic Maximum Matching - batched edge updates with localized repair
+ *
+ * A long-lived engine that holds a general graph (matching/dynamic_graph.hpp)
+ * and a maximum matching of it, and takes batches of edge deletions and
+ * insertions. The first matching comes from gabow_optimized::solve().
+ * After that, the matching is never recomputed: each update is repaired at
+ * once by single-source augmenting-path searches that start at the vertices
+ * it affects. Since the matching is maximum before every update, the
+ * searches below keep it maximum (Berge, plus Edmonds' observation that all
+ * new augmenting paths must use the changed edge):
+ *
+ *   erase a matched edge uv     u and v are exposed. The deletion lowers the
+ *                               maximum by at most one, so one augmenting
+ *                               path is enough: search from u and v at once
+ *                               (two trees; a path may also join them).
+ *   erase an unmatched edge     nothing to do.
+ *   insert uv, both free        match uv.
+ *   insert uv, u free           any new augmenting path uses uv and ends at
+ *                               u: search from u.
+ *   insert uv, both matched     to mates u', v'. A new augmenting path looks
+ *                               like x..u'=u-v=v'..y. Swap uu', vv' for uv,
+ *                               then search from u' with v' blocked (finds
+ *                               the x..u' half if the path exists) and then
+ *                               from v'. Without v' the graph has no matching
+ *                               larger than the old one, so the second search
+ *                               succeeds whenever the maximum grew. If the
+ *                               first search fails, swap back.
+ *
+ * Searches are Gabow-style (union-find bases, no physical contraction,
+ * bridges for augmenting through blossoms; see gabow-simple) over one or
+ * two alternating trees. They reset only the vertices they labeled, so a search
+ * costs the size of the tree it grows, not O(n).
+ *
+ * A search that fails has to explore everything reachable from its root,
+ * which in a large, nearly perfectly matched graph is most of the graph.
+ * Local searches therefore stop after `budget` arcs (default: a quarter of
+ * the edge count, so a batch wastes at most that). The first one that
+ * runs out marks the batch dirty: the remaining updates in it only fix the
+ * matching up (unmatch erased edges, match new edges between free
+ * vertices), and the batch ends with settle(), a search from every free
+ * vertex in which failed trees stay dead, so it costs O(m) plus the
+ * augmenting trees. A batch costs the smaller of its local repairs and
+ * about one pass over the graph, and the matching is maximum after every
+ * batch.
+ *
+ * Vertices are added on demand: inserting an edge with a new endpoint grows
+ * the graph.
+ *
+ * All integers, no hash containers, fully deterministic.
+ */
+#pragma once
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include "matching/dynamic_graph.hpp"
+#include "matching/graph.hpp"
+#include "matching/solver.hpp"
+#include "../../gabow-optimized/cpp/gabow_optimized.hpp"
+
+namespace dynamic_matching {
+
+using matching::NIL;
+static const int UNLABELED = 0;
+static const int EVEN = 1;
+static const int ODD = 2;
+static const long long MIN_BUDGET = 1 << 14;
+
+struct Batch {
+    matching::EdgeList erase;    /* applied first */
+    matching::EdgeList insert;
+};
+
+struct BatchStats {
+    int erased = 0;              /* edges actually removed */
+    int inserted = 0;            /* edges actually added */
+    int exposed = 0;             /* matched edges among the erased ones */
+    int searches = 0;            /* single-source searches run */
+    int augmented = 0;           /* searches that found a path */
+    long long scanned = 0;       /* arcs scanned by the searches */
+    int settled = 0;             /* 1 if the batch ended in settle() */
+    double ms = 0;
+};
+
+struct DynamicMatching {
+    matching::DynamicGraph graph;
+    std::vector<int> mate;
+    int size = 0;                /* matched edges */
+
+    /* Search state; only `touched` vertices differ from the reset values */
+    std::vector<int> label, parent, base, root, bridge_src, bridge_tgt;
+    std::vector<size_t> lca_tag1, lca_tag2;
+    size_t lca_epoch = 0;
+    std::vector<int> touched, queue;
+    std::vector<char> dead;      /* failed trees, during settle() */
+    std::vector<int> dead_list;
+    long long scanned = 0;
+    long long budget = 0;        /* arcs per local search; 0: auto */
+    bool aborted = false;        /* last search hit its budget */
+    bool dirty = false;          /* this batch needs settle() */
+
+    explicit DynamicMatching(const matching::Graph& g, const matching::Options& opt = {})
+        : graph(g) {
+        grow(g.num_vertices());
+        for (const auto& e : gabow_optimized::solve(g, opt).matching) {
+            mate[e.first] = e.second;
+            mate[e.second] = e.first;
+            size++;
+        }
+    }
+
+    int num_vertices() const { return graph.num_vertices(); }
+
+    matching::Matching get_matching() const {
+        matching::Matching m;
+        for (int u = 0; u < num_vertices(); u++)
+            if (mate[u] > u) m.push_back({u, mate[u]});
+        return m;
+    }
+
+    /* ---- updates ---- */
+
+    BatchStats apply(const Batch& b) {
+        BatchStats st;
+        auto t0 = std::chrono::steady_clock::now();
+        long long scanned0 = scanned;
+        dirty = false;
+        for (const auto& e : b.erase) erase(e.first, e.second, st);
+        for (const auto& e : b.insert) insert(e.first, e.second, st);
+        if (dirty) settle(st);
+        st.scanned = scanned - scanned0;
+        st.ms = matching::ms_since(t0);
+        return st;
+    }
+
+    /* Exact repair from any matching: one search from every free vertex.
+       A tree that fails stays dead for the rest of the pass (Edmonds): the
+       matching only changes outside it, so no later path can enter it. */
+    void settle(BatchStats& st) {
+        st.settled = 1;
+        for (int r = 0; r < num_vertices(); r++)
+            if (mate[r] == NIL && !dead[r]) augment_from(r, NIL, NIL, st, -1);
+        for (int v : dead_list) dead[v] = 0;
+        dead_list.clear();
+        dirty = false;
+    }
+
+    /* Local search; a search that runs out of budget leaves the batch
+       to settle(), and later updates in it skip their searches */
+    bool local_search(int r, int r2, int blocked, BatchStats& st) {
+        if (dirty) return false;
+        long long limit = budget > 0 ? budget : std::max(MIN_BUDGET, graph.num_edges() / 4);
+        bool found = augment_from(r, r2, blocked, st, limit);
+        if (aborted) dirty = true;
+        return found;
+    }
+
+    void erase(int u, int v, BatchStats& st) {
+        if (!graph.erase(u, v)) return;
+        st.erased++;
+        if (mate[u] != v) return;
+        st.exposed++;
+        mate[u] = mate[v] = NIL;
+        size--;
+        local_search(u, v, NIL, st);
+    }
+
+    void insert(int u, int v, BatchStats& st) {
+        if (u < 0 || v < 0) return;
+        grow(std::max(u, v) + 1);
+        if (!graph.insert(u, v)) return;
+        st.inserted++;
+        if (mate[u] != NIL && mate[v] == NIL) std::swap(u, v);
+        if (mate[u] == NIL) {
+            if (mate[v] == NIL) match(u, v);
+            else local_search(u, NIL, NIL, st);
+            return;
+        }
+        if (dirty) return;
+        /* Both matched: try x..u'=u-v=v'..y */
+        int mu = mate[u], mv = mate[v];
+        match(u, v);
+        mate[mu] = mate[mv] = NIL;
+        size -= 2;
+        if (!local_search(mu, NIL, mv, st)) {
+            match(u, mu);
+            match(v, mv);
+            size--;
+            return;
+        }
+        local_search(mv, NIL, NIL, st);
+    }
+
+    /* ---- single-source search ---- */
+
+    void grow(int n) {
+        graph.resize(n);
+        if ((int)mate.size() >= n) return;
+        mate.resize(n, NIL);
+        label.resize(n, UNLABELED);
+        parent.resize(n, NIL);
+        root.resize(n, NIL);
+        bridge_src.resize(n, NIL);
+        bridge_tgt.resize(n, NIL);
+        lca_tag1.resize(n, 0);
+        lca_tag2.resize(n, 0);
+        dead.resize(n, 0);
+        int old = (int)base.size();
+        base.resize(n);
+        for (int i = old; i < n; i++) base[i] = i;
+    }
+
+    void match(int u, int v) {
+        mate[u] = v;
+        mate[v] = u;
+        size++;
+    }
+
+    /* Bases and bridges only change on labeled vertices, so recording the
+       first labeling is enough for reset_search() */
+    void touch(int v, int lab) {
+        if (label[v] == UNLABELED) touched.push_back(v);
+        label[v] = lab;
+    }
+
+    void reset_search() {
+        for (int v : touched) {
+            label[v] = UNLABELED;
+            parent[v] = NIL;
+            root[v] = NIL;
+            base[v] = v;
+            bridge_src[v] = bridge_tgt[v] = NIL;
+        }
+        touched.clear();
+        queue.clear();
+    }
+
+    int find_base(int v) {
+        while (base[v] != v) { base[v] = base[base[v]]; v = base[v]; }
+        return v;
+    }
+
+    /* Interleaved LCA with epoch tags, for u and v in the same tree; its
+       root is the only free vertex on the way up */
+    int find_lca(int u, int v) {
+        size_t ep = ++lca_epoch;
+        int hx = find_base(u), hy = find_base(v);
+        lca_tag1[hx] = ep;
+        lca_tag2[hy] = ep;
+        while (true) {
+            if (lca_tag1[hy] == ep) return hy;
+            if (lca_tag2[hx] == ep) return hx;
+            if (mate[hx] != NIL) { hx = find_base(parent[mate[hx]]); lca_tag1[hx] = ep; }
+            if (mate[hy] != NIL) { hy = find_base(parent[mate[hy]]); lca_tag2[hy] = ep; }
+        }
+    }
+
+    /* Walk from x up to lca, merging bases and turning ODD vertices EVEN
+       with bridge (x, y) */
+    void shrink_path(int lca, int x, int y) {
+        int v = find_base(x);
+        while (v != lca) {
+            int mv = mate[v];
+            base[find_base(v)] = lca;
+            base[find_base(mv)] = lca;
+            base[lca] = lca;
+            bridge_src[mv] = x;
+            bridge_tgt[mv] = y;
+            if (label[mv] != EVEN) {
+                label[mv] = EVEN;
+                queue.push_back(mv);
+            }
+            v = find_base(parent[mv]);
+        }
+    }
+
+    /* Alternating path from v down to u (u == NIL: to the root) as the
+       pairs to match; same scheme as gabow_simple::trace_path */
+    void trace_path(int v, int u, std::vector<std::pair<int,int>>& pairs) {
+        struct Frame { int v, u, phase, sb, tb; };
+        std::vector<Frame> stk;
+        stk.push_back({v, u, 0, 0, 0});
+        while (!stk.empty()) {
+            auto& f = stk.back();
+            if (f.v == f.u) { stk.pop_back(); continue; }
+            if (f.phase == 0) {
+                if (bridge_src[f.v] == NIL) {
+                    if (mate[f.v] == NIL) { stk.pop_back(); continue; }
+                    int mv = mate[f.v];
+                    int pmv = parent[mv];
+                    pairs.push_back({mv, pmv});
+                    f.v = pmv;
+                    continue;
+                }
+                f.sb = bridge_src[f.v];
+                f.tb = bridge_tgt[f.v];
+                f.phase = 1;
+                stk.push_back({f.sb, mate[f.v], 0, 0, 0});
+                continue;
+            }
+            if (f.phase == 1) {
+                pairs.push_back({f.sb, f.tb});
+                f.phase = 2;
+                stk.push_back({f.tb, f.u, 0, 0, 0});
+                continue;
+            }
+            stk.pop_back();
+        }
+    }
+
+    /* Grow alternating trees from free r (and free r2 unless NIL), never
+       entering `blocked` or a dead vertex. Augments and returns true at the
+       first free vertex reached or the first edge joining the two trees. Gives up (aborted) after `limit` arcs unless limit < 0; a
+       tree that fails without giving up is marked dead during settle(). */
+    bool augment_from(int r, int r2, int blocked, BatchStats& st, long long limit) {
+        st.searches++;
+        long long stop = scanned + limit;
+        aborted = false;
+        for (int x : {r, r2}) {
+            if (x == NIL) continue;
+            touch(x, EVEN);
+            root[x] = x;
+            queue.push_back(x);
+        }
+        bool found = false;
+        for (size_t qh = 0; qh < queue.size() && !found && !aborted; qh++) {
+            int u = queue[qh];
+            if (label[find_base(u)] != EVEN) continue;
+            const std::vector<int>& nb = graph.neighbors(u);
+            for (size_t k = 0; k < nb.size(); k++) {
+                int v = nb[k];
+                if (++scanned > stop && limit >= 0) { aborted = true; break; }
+                if (v == blocked || v == mate[u] || dead[v]) continue;
+                int bu = find_base(u), bv = find_base(v);
+                if (bu == bv) continue;
+                bool join = label[bv] == EVEN && root[v] != root[u];
+                if ((label[bv] == UNLABELED && mate[v] == NIL) || join) {
+                    std::vector<std::pair<int,int>> pairs;
+                    pairs.push_back({u, v});
+                    trace_path(u, NIL, pairs);
+                    if (join) trace_path(v, NIL, pairs);
+                    for (auto& [a, c] : pairs) { mate[a] = c; mate[c] = a; }
+                    size++;
+                    found = true;
+                    break;
+                }
+                if (label[bv] == UNLABELED) {
+                    int w = mate[v];
+                    touch(v, ODD);
+                    parent[v] = u;
+                    root[v] = root[w] = root[u];
+                    touch(w, EVEN);
+                    queue.push_back(w);
+                } else if (label[bv] == EVEN) {
+                    int lca = find_lca(u, v);
+                    shrink_path(lca, u, v);
+                    shrink_path(lca, v, u);
+                }
+            }
+        }
+        if (!found && limit < 0)
+            for (int v : touched) { dead[v] = 1; dead_list.push_back(v); }
+        reset_search();
+        if (found) st.augmented++;
+        return found;
+    }
+};
+
+/* Update file: one change per line, "+ u v" inserts and "- u v" erases;
+   a line "=" ends a batch, and so does the end of the file. Within a batch
+   erases are applied before inserts. */
+inline bool read_updates(const char* path, std::vector<Batch>& out) {
+    FILE* f = fopen(path, "r");
+    if (!f) { fprintf(stderr, "Cannot open file: %s\n", path); return false; }
+    out.assign(1, Batch());
+    char line[256];
+    int lineno = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof line, f)) {
+        lineno++;
+        char op;
+        int u, v;
+        int got = sscanf(line, " %c %d %d", &op, &u, &v);
+        if (got <= 0) continue;
+        if (op == '=' && got == 1) { out.push_back(Batch()); continue; }
+        if ((op == '+' || op == '-') && got == 3) {
+            (op == '+' ? out.back().insert : out.back().erase).push_back({u, v});
+            continue;
+        }
+        fprintf(stderr, "Bad update at %s:%d\n", path, lineno);
+        ok = false;
+    }
+    fclose(f);
+    if (out.back().erase.empty() && out.back().insert.empty()) out.pop_back();
+    return ok;
+}
+
+} // namespace dynamic_matching
@@ -0,0 +1,652 @@
+/*
+ * Edmonds' Blossom Algorithm (Optimized) — Unweighted Maximum Cardinality Matching
+ *
+ * Forest BFS: each stage labels ALL free vertices as S-roots simultaneously
+ * and grows a search forest. An augmenting path is found when two different
+ * trees meet (S-S edge across trees). The two trees are augmented and
+ * retired for the rest of the stage, and the search keeps growing the
+ * others, so a stage finds a maximal set of vertex-disjoint augmenting
+ * paths. Then all blossoms are expanded and the next stage starts, until
+ * a stage finds nothing.
+ *
+ * Same blossom machinery as edmonds-simple (NetworkX-derived), just with
+ * forest search instead of single-source tree search.
+ *
+ * Blossom IDs reset to n each stage. All indices are 32-bit signed int.
+ * Blossom cycles live in per-stage pools and all per-blossom arrays are
+ * allocated once, for 2n IDs, so a stage allocates nothing.
+ *
+ * Complexity: O(V * E) worst case (each stage O(E), at least one augmentation
+ * per stage); in practice only a handful of stages.
+ *
+ * Built with -DMATCHING_STATS=1 (matching/stats.hpp) it counts stages,
+ * arcs scanned, blossoms created and expanded, and augmentations.
+ *
+ * The arrays live in a Workspace, which solve_in() keeps for the next
+ * graph (matching/workspace.hpp). Every stage starts with
+ * resetBlossoms() and a new blossom sets all of its fields, so only the
+ * mates need to go back idle.
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <memory>
+
+#include "matching/graph.hpp"
+#include "matching/karp_sipser.hpp"
+#include "matching/solver.hpp"
+#include "matching/stats.hpp"
+#include "matching/warm_start.hpp"
+#include "matching/workspace.hpp"
+
+namespace edmonds_blossom_optimized {
+
+// Solver's arrays, reusable across solves. Idle: mate -1; everything else
+// is rewritten by resetBlossoms() or addBlossom() before it is read.
+struct Workspace {
+    std::vector<int> mate;
+    std::vector<int> cycle_begin, cycle_len, cycle_child;
+    std::vector<std::pair<int,int>> cycle_edge;
+    std::vector<int> inblossom, blossomparent, blossombase;
+    std::vector<int> label;
+    std::vector<std::pair<int,int>> labeledge;
+    std::vector<int> queue, leaf_buf, path_buf, tree;
+    std::vector<char> dead;
+};
+
+struct Solver {
+    std::unique_ptr<Workspace> own_ws;   // when the caller lends none
+    Workspace& ws;
+
+    int n;
+    const matching::Graph& adj;
+    std::vector<int>& mate = ws.mate; // mate[v] = matched partner, or -1
+
+    // Blossom storage. IDs 0..n-1 are trivial (one vertex each, no data).
+    // Non-trivial blossoms have id in [n, nblos). Reset each BFS.
+    // Blossom b owns the slice [cycle_begin[b], cycle_begin[b] + cycle_len[b])
+    // of both pools. Blossoms are only created during a search and all of
+    // them are expanded at its end, so the pools are simply cleared.
+    std::vector<int>& cycle_begin = ws.cycle_begin;
+    std::vector<int>& cycle_len = ws.cycle_len;                  // 0 once expanded
+    std::vector<int>& cycle_child = ws.cycle_child;              // sub-blossom IDs in cycle order
+    std::vector<std::pair<int,int>>& cycle_edge = ws.cycle_edge; // edge i connects child i to child (i+1)%k
+    int nblos;                     // next blossom ID to allocate
+
+    std::vector<int>& inblossom = ws.inblossom;         // inblossom[v] = top-level blossom containing v
+    std::vector<int>& blossomparent = ws.blossomparent; // blossomparent[b] = parent blossom, or -1
+    std::vector<int>& blossombase = ws.blossombase;     // blossombase[b] = base vertex of blossom b
+
+    // Per-search state (sized to nblos, reset each BFS)
+    std::vector<int>& label = ws.label;                        // 0=unlabeled, 1=S, 2=T (5=breadcrumb)
+    std::vector<std::pair<int,int>>& labeledge = ws.labeledge; // label edge for tree structure
+    std::vector<int>& queue = ws.queue;                        // BFS queue of S-vertices
+    std::vector<int>& leaf_buf = ws.leaf_buf;                  // scratch for leaves()
+    std::vector<int>& path_buf = ws.path_buf;                  // scratch for scanBlossom()
+
+    // --stats=json (stats.hpp); the counters only move under MATCHING_STATS
+    matching::StageTimes times;
+    long long stat_stages = 0, stat_arcs = 0, stat_created = 0, stat_expanded = 0, stat_paths = 0;
+    std::vector<int>& tree = ws.tree;                          // tree[b] = root vertex of labeled blossom b
+    std::vector<char>& dead = ws.dead;                         // dead[r]: tree of root r augmented this stage
+
+    // Binds `g` to *w (grown if g is larger than any graph before), or to
+    // a workspace of its own
+    explicit Solver(const matching::Graph& g, Workspace* w = nullptr)
+        : own_ws(w ? nullptr : new Workspace), ws(w ? *w : *own_ws), n(g.num_vertices()), adj(g) {
+        MATCHING_STAT_TIMER(times.setup);
+        matching::grow_idle(mate, (size_t)n, -1);
+        // Each contraction merges at least 3 top-level blossoms into one, so
+        // a search creates at most (n - 1) / 2 blossoms and every ID is below
+        // 2n. Their cycles hold at most n - 1 + (n - 1) / 2 entries in total.
+        size_t nb = 2 * (size_t)n;
+        matching::grow_identity(inblossom, n);
+        matching::grow_idle(blossombase, nb, -1);
+        matching::grow_idle(blossomparent, nb, -1);
+        matching::grow_idle(label, nb, 0);
+        matching::grow_idle(labeledge, nb, std::make_pair(-1, -1));
+        matching::grow_idle(tree, nb, -1);
+        matching::grow_idle(dead, (size_t)n, (char)0);
+        matching::grow_idle(cycle_begin, nb, 0);
+        matching::grow_idle(cycle_len, nb, 0);
+        cycle_child.reserve(nb);
+        cycle_edge.reserve(nb);
+        nblos = n;
+    }
+
+    // A lent workspace goes back with nothing matched
+    ~Solver() {
+        if (own_ws) return;
+        std::fill(mate.begin(), mate.begin() + n, -1);
+    }
+
+    Solver(const Solver&) = delete;
+    Solver& operator=(const Solver&) = delete;
+
+    int& child(int b, int i) { return cycle_child[cycle_begin[b] + i]; }
+    std::pair<int,int>& edge(int b, int i) { return cycle_edge[cycle_begin[b] + i]; }
+
+    bool isBlossom(int b) const { return b >= n; }
+
+    void leaves(int b, std::vector<int>& out) {
+        if (!isBlossom(b)) { out.push_back(b); return; }
+        for (int i = 0; i < cycle_len[b]; i++) leaves(child(b, i), out);
+    }
+
+    // Reset blossom state for a new BFS. All blossoms from the previous search
+    // have already been expanded, so every vertex is its own top-level blossom.
+    void resetBlossoms() {
+        for (int i = 0; i < n; i++) {
+            inblossom[i] = i;
+            blossombase[i] = i;
+            blossomparent[i] = -1;
+        }
+        // IDs up to the old nblos may carry labels from the previous search
+        std::fill(label.begin(), label.begin() + nblos, 0);
+        std::fill(labeledge.begin(), labeledge.begin() + nblos, std::make_pair(-1, -1));
+        std::fill(tree.begin(), tree.begin() + nblos, -1);
+        std::fill(dead.begin(), dead.begin() + n, 0);
+        nblos = n;
+        cycle_child.clear();
+        cycle_edge.clear();
+        queue.clear();
+    }
+
+    // ---- Tree building ----
+
+    void assignLabel(int w, int t, int v) {
+        int b = inblossom[w];
+        label[b] = t;
+        label[w] = t;
+        tree[b] = (v == -1) ? w : tree[inblossom[v]];
+        if (v != -1) {
+            labeledge[w] = labeledge[b] = {v, w};
+        } else {
+            labeledge[w] = labeledge[b] = {-1, -1};
+        }
+        if (t == 1) {
+            // S-blossom: add its leaves to the BFS queue
+            leaf_buf.clear();
+            leaves(b, leaf_buf);
+            for (int u : leaf_buf) queue.push_back(u);
+        } else if (t == 2) {
+            // T-blossom: label the mate of its base as S
+            int base = blossombase[b];
+            assignLabel(mate[base], 1, base);
+        }
+    }
+
+    // ---- Blossom detection ----
+
+    // Trace from two S-vertices to find their LCA (blossom base).
+    // Returns base vertex, or -2 if they belong to different trees
+    // (augmenting path — should not occur in single-source mode).
+    int scanBlossom(int v, int w) {
+        std::vector<int>& path = path_buf;
+        path.clear();
+        int base = -2;
+        while (v != -2 || w != -2) {
+            if (v != -2) {
+                int b = inblossom[v];
+                if (label[b] & 4) { base = blossombase[b]; break; }
+                path.push_back(b);
+                label[b] = 5; // breadcrumb
+                auto& le = labeledge[b];
+                if (le.first == -1) {
+                    v = -2; // reached root
+                } else {
+                    v = le.first;
+                    int bt = inblossom[v];
+                    v = labeledge[bt].first;
+                }
+                if (w != -2) std::swap(v, w);
+            } else {
+                std::swap(v, w);
+            }
+        }
+        for (int b : path) label[b] = 1; // restore breadcrumbs
+        return base;
+    }
+
+    // ---- Blossom contraction ----
+
+    void addBlossom(int base, int v, int w) {
+        MATCHING_STAT(stat_created++;)
+        int bb = inblossom[base];
+        int bv = inblossom[v];
+        int bw = inblossom[w];
+
+        int bid = nblos++;
+        blossombase[bid] = base;
+        blossomparent[bid] = -1;
+        blossomparent[bb] = bid;
+
+        // The cycle is built at the end of the pools
+        auto& childs = cycle_child;
+        auto& edges = cycle_edge;
+        int first = (int)childs.size();
+        edges.push_back({v, w}); // bridge edge
+
+        // Trace from v back to base
+        while (bv != bb) {
+            blossomparent[bv] = bid;
+            childs.push_back(bv);
+            edges.push_back(labeledge[bv]);
+            v = labeledge[bv].first;
+            bv = inblossom[v];
+        }
+        childs.push_back(bb);
+        std::reverse(childs.begin() + first, childs.end());
+        std::reverse(edges.begin() + first, edges.end());
+
+        // Trace from w back to base
+        while (bw != bb) {
+            blossomparent[bw] = bid;
+            childs.push_back(bw);
+            auto le = labeledge[bw];
+            edges.push_back({le.second, le.first}); // reversed
+            w = labeledge[bw].first;
+            bw = inblossom[w];
+        }
+        cycle_begin[bid] = first;
+        cycle_len[bid] = (int)childs.size() - first;
+
+        label[bid] = 1;
+        labeledge[bid] = labeledge[bb];
+        tree[bid] = tree[bb];
+
+        // Relabel: T-vertices inside the blossom become S
+        leaf_buf.clear();
+        leaves(bid, leaf_buf);
+        for (int u : leaf_buf) {
+            if (label[inblossom[u]] == 2) queue.push_back(u);
+            inblossom[u] = bid;
+        }
+    }
+
+    // ---- Blossom expansion ----
+
+    void expandBlossom(int b, bool endstage) {
+        struct Frame { int b; bool endstage; int idx; };
+        std::vector<Frame> stack;
+        stack.push_back({b, endstage, 0});
+
+        while (!stack.empty()) {
+            auto& f = stack.back();
+            if (f.idx < cycle_len[f.b]) {
+                int s = child(f.b, f.idx);
+                f.idx++;
+                blossomparent[s] = -1;
+                if (isBlossom(s)) {
+                    if (f.endstage) {
+                        // Recursively expand sub-blossoms at end of stage
+                        stack.push_back({s, true, 0});
+                        continue;
+                    } else {
+                        leaf_buf.clear();
+                        leaves(s, leaf_buf);
+                        for (int u : leaf_buf) inblossom[u] = s;
+                    }
+                } else {
+                    inblossom[s] = s;
+                }
+            } else {
+                // All children processed
+                if (!f.endstage && label[f.b] == 2) {
+                    // Mid-stage T-blossom expansion: relabel children
+                    int entrychild = inblossom[labeledge[f.b].second];
+                    int k = cycle_len[f.b];
+                    int j = 0;
+                    for (; j < k; j++) if (child(f.b, j) == entrychild) break;
+                    int jstep;
+                    if (j & 1) { j -= k; jstep = 1; } else { jstep = -1; }
+                    int lv_ = labeledge[f.b].first, lw_ = labeledge[f.b].second;
+                    while (j != 0) {
+                        int pp, qq;
+                        if (jstep == 1) {
+                            pp = edge(f.b, ((j % k) + k) % k).first;
+                            qq = edge(f.b, ((j % k) + k) % k).second;
+                        } else {
+                            int ei = (((j - 1) % k) + k) % k;
+                            qq = edge(f.b, ei).first;
+                            pp = edge(f.b, ei).second;
+                        }
+                        label[lw_] = 0;
+                        label[qq] = 0;
+                        assignLabel(lw_, 2, lv_);
+                        j += jstep;
+                        if (jstep == 1) {
+                            lv_ = edge(f.b, ((j % k) + k) % k).first;
+                            lw_ = edge(f.b, ((j % k) + k) % k).second;
+                        } else {
+                            int ei = (((j - 1) % k) + k) % k;
+                            lw_ = edge(f.b, ei).first;
+                            lv_ = edge(f.b, ei).second;
+                        }
+                        j += jstep;
+                    }
+                    int bwi = child(f.b, ((j % k) + k) % k);
+                    label[lw_] = label[bwi] = 2;
+                    labeledge[lw_] = labeledge[bwi] = {lv_, lw_};
+                    j += jstep;
+                    while (child(f.b, ((j % k) + k) % k) != entrychild) {
+                        int bvi = child(f.b, ((j % k) + k) % k);
+                        if (label[bvi] == 1) { j += jstep; continue; }
+                        int found_v = -1;
+                        if (isBlossom(bvi)) {
+                            leaf_buf.clear();
+                            leaves(bvi, leaf_buf);
+                            for (int u : leaf_buf) if (label[u]) { found_v = u; break; }
+                        } else {
+                            found_v = bvi;
+                        }
+                        if (found_v != -1 && label[found_v]) {
+                            label[found_v] = 0;
+                            label[mate[blossombase[bvi]]] = 0;
+                            assignLabel(found_v, 2, labeledge[found_v].first);
+                        }
+                        j += jstep;
+                    }
+                }
+                label[f.b] = 0;
+                cycle_len[f.b] = 0;
+                stack.pop_back();
+                MATCHING_STAT(stat_expanded++;)
+            }
+        }
+    }
+
+    // ---- Augmentation through blossoms ----
+
+    void augmentBlossom(int b, int v) {
+        struct Frame { int b; int v; int phase; int i; int j; int jstep; };
+        std::vector<Frame> stack;
+        stack.push_back({b, v, 0, 0, 0, 0});
+
+        while (!stack.empty()) {
+            auto& f = stack.back();
+            if (f.phase == 0) {
+                // Find sub-blossom containing v
+                int t = f.v;
+                while (blossomparent[t] != f.b) t = blossomparent[t];
+                int k = cycle_len[f.b];
+                f.i = 0;
+                for (; f.i < k; f.i++) if (child(f.b, f.i) == t) break;
+                if (isBlossom(t)) {
+                    f.phase = 1;
+                    stack.push_back({t, f.v, 0, 0, 0, 0});
+                    continue;
+                }
+                f.phase = 2;
+                if (f.i & 1) { f.j = f.i - k; f.jstep = 1; }
+                else          { f.j = f.i;     f.jstep = -1; }
+                continue;
+            }
+            if (f.phase == 1) {
+                // After recursion into sub-blossom
+                f.phase = 2;
+                int k = cycle_len[f.b];
+                if (f.i & 1) { f.j = f.i - k; f.jstep = 1; }
+                else          { f.j = f.i;     f.jstep = -1; }
+                continue;
+            }
+            if (f.phase == 2) {
+                // Main loop: walk from position i toward position 0
+                int k = cycle_len[f.b];
+                if (f.j == 0) {
+                    // Done: rotate childs/edges so new base is first
+                    if (f.i > 0) {
+                        int* c = &child(f.b, 0);
+                        std::pair<int,int>* e = &edge(f.b, 0);
+                        std::rotate(c, c + f.i, c + k);
+                        std::rotate(e, e + f.i, e + k);
+                    }
+                    blossombase[f.b] = f.v;
+                    stack.pop_back();
+                    continue;
+                }
+                // Step to next pair of sub-blossoms
+                f.j += f.jstep;
+                int idx1 = ((f.j % k) + k) % k;
+                int c1 = child(f.b, idx1);
+                int ww, xx;
+                if (f.jstep == 1) {
+                    ww = edge(f.b, idx1).first;
+                    xx = edge(f.b, idx1).second;
+                } else {
+                    int ei = (((f.j - 1) % k) + k) % k;
+                    xx = edge(f.b, ei).first;
+                    ww = edge(f.b, ei).second;
+                }
+                if (isBlossom(c1)) {
+                    f.phase = 3;
+                    stack.push_back({c1, ww, 0, 0, 0, 0});
+                    continue;
+                }
+                f.phase = 3;
+            }
+            if (f.phase == 3) {
+                // After optional recursion for c1, step to c2
+                int k = cycle_len[f.b];
+                int idx1 = ((f.j % k) + k) % k;
+                int ww, xx;
+                if (f.jstep == 1) {
+                    ww = edge(f.b, idx1).first;
+                    xx = edge(f.b, idx1).second;
+                } else {
+                    int ei = (((f.j - 1) % k) + k) % k;
+                    xx = edge(f.b, ei).first;
+                    ww = edge(f.b, ei).second;
+                }
+                f.j += f.jstep;
+                int idx2 = ((f.j % k) + k) % k;
+                int c2 = child(f.b, idx2);
+                if (isBlossom(c2)) {
+                    f.phase = 4;
+                    stack.push_back({c2, xx, 0, 0, 0, 0});
+                    continue;
+                }
+                f.phase = 4;
+            }
+            if (f.phase == 4) {
+                // After optional recursion for c2, set mate pair
+                int k = cycle_len[f.b];
+                int prev_j = f.j - f.jstep;
+                int idx1 = ((prev_j % k) + k) % k;
+                int ww, xx;
+                if (f.jstep == 1) {
+                    ww = edge(f.b, idx1).first;
+                    xx = edge(f.b, idx1).second;
+                } else {
+                    int ei = (((prev_j - 1) % k) + k) % k;
+                    xx = edge(f.b, ei).first;
+                    ww = edge(f.b, ei).second;
+                }
+                mate[ww] = xx;
+                mate[xx] = ww;
+                f.phase = 2; // continue loop
+            }
+        }
+    }
+
+    // ---- Augmenting path: trace both sides back to their roots ----
+
+    void augmentMatching(int v, int w) {
+        MATCHING_STAT_TIMER_IN(times.augment, times.search);
+        MATCHING_STAT(stat_paths++;)
+        // v and w are S-vertices in different trees. Edge (v,w) completes
+        // an augmenting path. Trace from each side back to its root,
+        // flipping matched/unmatched edges and augmenting through blossoms.
+        for (int iter = 0; iter < 2; iter++) {
+            int s = (iter == 0) ? v : w;
+            int j = (iter == 0) ? w : v;
+            while (true) {
+                int bs = inblossom[s];
+                if (isBlossom(bs)) augmentBlossom(bs, s);
+                mate[s] = j;
+                auto& le = labeledge[bs];
+                if (le.first == -1) break; // root
+                int t = le.first;          // T-vertex
+                int bt = inblossom[t];
+                auto& le2 = labeledge[bt];
+                s = le2.first;
+                j = le2.second;
+                if (isBlossom(bt)) augmentBlossom(bt, j);
+                mate[j] = s;
+            }
+        }
+    }
+
+    // ---- Greedy initialization ----
+
+    int greedy_size = 0;
+    double greedy_ms = 0;
+    int init_threads = 1;   /* threads for the Karp-Sipser initializer */
+
+    int greedy_init() {
+        int cnt = 0;
+        for (int u = 0; u < n; u++) {
+            if (mate[u] != -1) continue;
+            for (int v : adj.neighbors(u)) {
+                if (mate[v] == -1) { mate[u] = v; mate[v] = u; cnt++; break; }
+            }
+        }
+        return cnt;
+    }
+
+    int greedy_init_md() {
+        int cnt = 0;
+        std::vector<int> deg(n, 0);
+        for (int u = 0; u < n; u++) for (int v : adj.neighbors(u)) deg[v]++;
+        std::vector<int> order(n);
+        for (int i = 0; i < n; i++) order[i] = i;
+        std::sort(order.begin(), order.end(),
+                  [&](int a, int b) { return deg[a] < deg[b] || (deg[a] == deg[b] && a < b); });
+        for (int u : order) {
+            if (mate[u] != -1) continue;
+            int best = -1, bd = INT_MAX;
+            for (int v : adj.neighbors(u))
+                if (mate[v] == -1 && deg[v] < bd) { best = v; bd = deg[v]; }
+            if (best >= 0) { mate[u] = best; mate[best] = u; cnt++; }
+        }
+        return cnt;
+    }
+
+    // ---- Main solver ----
+
+    std::vector<std::pair<int,int>> solve(int greedy_mode = 0) {
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            MATCHING_STAT_TIMER(times.init);
+            if (greedy_mode == 1) greedy_size = greedy_init();
+            else if (greedy_mode == 2) greedy_size = greedy_init_md();
+            else if (greedy_mode == matching::GREEDY_KARP_SIPSER) greedy_size = matching::karp_sipser(adj, mate, init_threads);
+        }
+        greedy_ms = matching::ms_since(t0);
+
+        while (true) {
+            MATCHING_STAT_TIMER(times.search);
+            MATCHING_STAT(stat_stages++;)
+            // New stage: reset all blossom state
+            resetBlossoms();
+
+            // Label ALL free vertices as S-roots
+            for (int v = 0; v < n; v++) {
+                if (mate[v] == -1 && label[inblossom[v]] == 0) {
+                    assignLabel(v, 1, -1);
+                }
+            }
+
+            // BFS: grow the forest until exhaustion, retiring trees as they augment
+            bool augmented = false;
+            while (!queue.empty()) {
+                int v = queue.back(); queue.pop_back();
+                if (label[inblossom[v]] != 1) continue; // stale
+                if (dead[tree[inblossom[v]]]) continue;  // tree already augmented
+                MATCHING_STAT(stat_arcs += adj.degree(v);)
+                for (int w : adj.neighbors(v)) {
+                    int bv = inblossom[v];
+                    int bw = inblossom[w];
+                    if (bv == bw) continue;
+                    // Labels in an augmented tree are stale: its path was flipped
+                    if (label[bw] != 0 && dead[tree[bw]]) continue;
+                    if (label[bw] == 0) {
+                        // w is unlabeled: grow the tree
+                        assignLabel(w, 2, v);
+                    } else if (label[bw] == 1) {
+                        // S-S edge: blossom or augmenting path
+                        int base = scanBlossom(v, w);
+                        if (base >= 0) {
+                            addBlossom(base, v, w);
+                        } else {
+                            // base == -2: two different trees met → augmenting path
+                            int rv = tree[bv], rw = tree[bw];
+                            augmentMatching(v, w);
+                            dead[rv] = dead[rw] = 1;
+                            augmented = true;
+                            break;
+                        }
+                    }
+                    // label[bw]==2: T-blossom edge, ignore
+                }
+            }
+
+            // Expand all remaining blossoms (end of stage)
+            for (int b = n; b < nblos; b++) {
+                if (cycle_len[b] > 0 && blossomparent[b] == -1) {
+                    expandBlossom(b, true);
+                }
+            }
+
+            if (!augmented) break; // no augmenting path found: matching is maximum
+        }
+
+        std::vector<std::pair<int,int>> result;
+        for (int u = 0; u < n; u++)
+            if (mate[u] > u) result.push_back({u, mate[u]});
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Counters and stage times for --stats=json
+    matching::Stats collect_stats() const {
+        matching::Stats st;
+        st.add("stages", stat_stages);
+        st.add("arcs", stat_arcs);
+        st.add("blossoms_created", stat_created);
+        st.add("blossoms_expanded", stat_expanded);
+        st.add("augmentations", stat_paths);
+        times.add_to(st);
+        return st;
+    }
+};
+
+inline matching::Result run(Solver& sol, const matching::Options& opt) {
+    const matching::Graph& g = sol.adj;
+    sol.init_threads = matching::init_threads(opt);
+    matching::Result r;
+    if (opt.initial) {
+        MATCHING_STAT_TIMER(sol.times.init);
+        r.initial_size = matching::seed_matching(g, *opt.initial, sol.mate);
+    }
+    r.matching = sol.solve(opt.greedy_mode);
+    r.greedy_size = sol.greedy_size;
+    r.greedy_ms = sol.greedy_ms;
+    MATCHING_STAT(r.stats = sol.collect_stats();)
+    return r;
+}
+
+inline matching::Result solve(const matching::Graph& g, const matching::Options& opt = {}) {
+    Solver sol(g);
+    return run(sol, opt);
+}
+
+// solve() in `ws`, left idle for the next graph
+inline matching::Result solve_in(const matching::Graph& g, Workspace& ws, const matching::Options& opt = {}) {
+    Solver sol(g, &ws);
+    return run(sol, opt);
+}
+
+} // namespace edmonds_blossom_optimized
@@ -0,0 +1,763 @@
+/*
+ * Gabow's Scaling Algorithm (Optimized) - O(E√V) Maximum Matching
+ *
+ * Pure cardinality (unweighted) version — integer weights conceptually all 1.
+ *
+ * Phase 1: BFS by levels (Delta), detect blossoms.
+ *          Build contracted graph H: edges connecting different dbase
+ *          components that were processed during BFS.
+ * Phase 2: Find all shortest augmenting paths in H (iterative DFS
+ *          with blossom contraction), unfold to G via bridges.
+ *
+ * Based on LEDA-7's mc_matching_gabow architecture, stripped of weighted
+ * dual machinery (dval, bd, bDelta, priority queue) which is incorrect
+ * for pure cardinality at large Delta.
+ *
+ * With --epsilon E phase 1 stops at the first Delta level whose paths
+ * are long enough to guarantee 1 - E of a maximum matching (solver.hpp,
+ * epsilon_path_length), and no further phase runs.
+ *
+ * Built with -DMATCHING_STATS=1 (matching/stats.hpp) it counts phases,
+ * the Delta levels phase 1 sweeps (summed over phases), the arcs it
+ * scans and the blossoms it shrinks, and the size of H in phase 2: H-nodes
+ * (dbase representatives), DFS searches in H and paths found.
+ *
+ * The per-vertex arrays live in a Workspace, which solve_in() keeps for
+ * the next graph (matching/workspace.hpp). Every phase restores what it
+ * changed through tree_nodes, so the destructor hands the workspace back
+ * idle at the cost of the last tree plus the mates.
+ *
+ * All integers, no hash containers, fully deterministic.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <memory>
+
+#include "matching/graph.hpp"
+#include "matching/karp_sipser.hpp"
+#include "matching/solver.hpp"
+#include "matching/stats.hpp"
+#include "matching/warm_start.hpp"
+#include "matching/workspace.hpp"
+
+namespace gabow_optimized {
+
+using matching::NIL;
+static const int UNLABELED = 0;
+static const int EVEN = 1;
+static const int ODD = 2;
+
+/* phase_1 sweeps the last tree's id range [lo, hi) once more than
+   (hi - lo) / RESET_SWEEP of its vertices were in the tree */
+static const int RESET_SWEEP = 64;
+
+/* GabowOptimized's scratch arrays, reusable across solves. Idle values:
+   NIL mates, parents, bridges and mateH; UNLABELED labels; identity
+   union-finds; false in_tree; empty level buckets and contracted_into. */
+struct Workspace {
+    std::vector<int> mate, label, parent, source_bridge, target_bridge;
+    std::vector<int> base_par, dbase_par;
+    std::vector<std::vector<std::pair<int,int>>> level_queue;
+    std::vector<size_t> lca_tag1, lca_tag2;
+    size_t lca_epoch = 0;
+    std::vector<bool> in_tree;
+    std::vector<int> tree_nodes, free_vertices;
+    /* phase 2, written for the tree vertices before each use */
+    std::vector<int> rep, mateH, labelH, parentH_src, parentH_tgt, bridgeH_src, bridgeH_tgt;
+    std::vector<int> dirH, even_timeH, dbase2_par;
+    std::vector<std::vector<int>> contracted_into;
+};
+
+struct GabowOptimized {
+    std::unique_ptr<Workspace> own_ws;   /* when the caller lends none */
+    Workspace& ws;
+
+    int n;
+    int greedy_size = 0;
+    double greedy_ms = 0;
+    int init_threads = 1;   /* threads for the Karp-Sipser initializer */
+    int path_limit = INT_MAX;   /* --epsilon: stop before a Delta level with paths this long */
+    int path_bound = 0;         /* set when it did: no augmenting path is shorter */
+    const matching::Graph& graph;
+    std::vector<int>& mate = ws.mate;
+
+    /* phase_1 BFS tree */
+    std::vector<int>& label = ws.label;
+    std::vector<int>& parent = ws.parent;
+    std::vector<int>& source_bridge = ws.source_bridge;
+    std::vector<int>& target_bridge = ws.target_bridge;
+
+    /* base union-find (immediate unions during shrink_path) */
+    std::vector<int>& base_par = ws.base_par;
+
+    /* dbase union-find (deferred unions at Delta boundaries) */
+    std::vector<int>& dbase_par = ws.dbase_par;
+
+    /* BFS level queue: edges to process at each Delta */
+    std::vector<std::vector<std::pair<int,int>>>& level_queue = ws.level_queue;
+
+    /* interleaved LCA with epoch (size_t to avoid overflow) */
+    std::vector<size_t>& lca_tag1 = ws.lca_tag1;
+    std::vector<size_t>& lca_tag2 = ws.lca_tag2;
+    size_t& lca_epoch = ws.lca_epoch;
+
+    /* tree membership; every per-phase write lands on a tree vertex, so
+       the next phase only restores these */
+    std::vector<bool>& in_tree = ws.in_tree;
+    std::vector<int>& tree_nodes = ws.tree_nodes;
+    std::vector<int>& free_vertices = ws.free_vertices;   /* exposed vertices, ascending */
+
+    int Delta = 0;
+
+    /* phase_2 / H state */
+    std::vector<int>& rep = ws.rep;         /* rep[v] = dbase(v) at start of phase_2 */
+    std::vector<int>& mateH = ws.mateH;
+    std::vector<int>& labelH = ws.labelH;
+    std::vector<int>& parentH_src = ws.parentH_src;
+    std::vector<int>& parentH_tgt = ws.parentH_tgt;
+    std::vector<int>& bridgeH_src = ws.bridgeH_src;
+    std::vector<int>& bridgeH_tgt = ws.bridgeH_tgt;
+    std::vector<int>& dirH = ws.dirH;
+    std::vector<int>& even_timeH = ws.even_timeH;
+    int tH = 0;
+    std::vector<int>& dbase2_par = ws.dbase2_par;  /* blossoms in H */
+    std::vector<std::vector<int>>& contracted_into = ws.contracted_into;
+
+    /* --stats=json (stats.hpp); the counters only move under MATCHING_STATS */
+    matching::StageTimes times;
+    long long stat_phases = 0, stat_levels = 0, stat_arcs = 0, stat_blossoms = 0;
+    long long stat_h_nodes = 0, stat_h_searches = 0, stat_paths = 0;
+
+    /* Binds `g` to *w (grown if g is larger than any graph before), or to
+       a workspace of its own */
+    explicit GabowOptimized(const matching::Graph& g, Workspace* w = nullptr)
+        : own_ws(w ? nullptr : new Workspace), ws(w ? *w : *own_ws), n(g.num_vertices()), graph(g) {
+        MATCHING_STAT_TIMER(times.setup);
+        size_t nv = n;
+        for (auto* a : {&mate, &parent, &source_bridge, &target_bridge, &mateH, &parentH_src,
+                        &parentH_tgt, &bridgeH_src, &bridgeH_tgt})
+            matching::grow_idle(*a, nv, NIL);
+        matching::grow_idle(label, nv, UNLABELED);
+        matching::grow_idle(labelH, nv, UNLABELED);
+        for (auto* a : {&rep, &dirH, &even_timeH}) matching::grow_idle(*a, nv, 0);
+        matching::grow_identity(base_par, nv);
+        matching::grow_identity(dbase_par, nv);
+        matching::grow_identity(dbase2_par, nv);
+        matching::grow_idle(lca_tag1, nv, (size_t)0);
+        matching::grow_idle(lca_tag2, nv, (size_t)0);
+        matching::grow_idle(in_tree, nv, false);
+        if (contracted_into.size() < nv) contracted_into.resize(nv);
+        if (level_queue.size() < nv + 2) level_queue.resize(nv + 2);
+    }
+
+    /* A lent workspace goes back idle: the last tree and the mates */
+    ~GabowOptimized() {
+        if (own_ws) return;
+        reset_tree();
+        std::fill(mate.begin(), mate.begin() + n, NIL);
+    }
+
+    GabowOptimized(const GabowOptimized&) = delete;
+    GabowOptimized& operator=(const GabowOptimized&) = delete;
+
+    /* ---- union-find: base ---- */
+    int find_base(int v) {
+        while (base_par[v] != v) { base_par[v] = base_par[base_par[v]]; v = base_par[v]; }
+        return v;
+    }
+    void union_base(int a, int b, int r) {
+        a = find_base(a); b = find_base(b);
+        base_par[a] = r; base_par[b] = r;
+    }
+
+    /* ---- union-find: dbase ---- */
+    int find_dbase(int v) {
+        while (dbase_par[v] != v) { dbase_par[v] = dbase_par[dbase_par[v]]; v = dbase_par[v]; }
+        return v;
+    }
+    void union_dbase(int a, int b) {
+        a = find_dbase(a); b = find_dbase(b);
+        if (a != b) dbase_par[a] = b;
+    }
+    void make_rep_dbase(int v) {
+        int r = find_dbase(v);
+        if (r != v) { dbase_par[r] = v; dbase_par[v] = v; }
+    }
+
+    /* ---- union-find: dbase2 (blossoms in H) ---- */
+    int find_db2(int v) {
+        while (dbase2_par[v] != v) { dbase2_par[v] = dbase2_par[dbase2_par[v]]; v = dbase2_par[v]; }
+        return v;
+    }
+    void union_db2(int a, int b) {
+        a = find_db2(a); b = find_db2(b);
+        if (a != b) dbase2_par[a] = b;
+    }
+    void make_rep_db2(int v) {
+        int r = find_db2(v);
+        if (r != v) { dbase2_par[r] = v; dbase2_par[v] = v; }
+    }
+
+    /* ---- interleaved LCA ---- */
+    int find_lca(int u, int v) {
+        ++lca_epoch;
+        size_t ep = lca_epoch;
+        int hx = find_base(u), hy = find_base(v);
+        lca_tag1[hx] = ep;
+        lca_tag2[hy] = ep;
+        while (true) {
+            if (lca_tag1[hy] == ep) return hy;
+            if (lca_tag2[hx] == ep) return hx;
+            bool hxr = (mate[hx] == NIL || parent[mate[hx]] == NIL);
+            bool hyr = (mate[hy] == NIL || parent[mate[hy]] == NIL);
+            if (hxr && hyr) return NIL;
+            if (!hxr) { hx = find_base(parent[mate[hx]]); lca_tag1[hx] = ep; }
+            if (!hyr) { hy = find_base(parent[mate[hy]]); lca_tag2[hy] = ep; }
+        }
+    }
+
+    /* Called during phase_1 when processing a non-matching edge (z, u) 
+       that connects different dbase components */
+
+    /* ---- shrink_path ---- */
+    void shrink_path(int b, int x, int y,
+                     std::vector<std::pair<int,int>>& dunions) {
+        int v = find_base(x);
+        while (v != b) {
+            union_base(v, b, b);
+            dunions.push_back({v, b});
+            int mv = mate[v];
+            union_base(mv, b, b);
+            dunions.push_back({mv, b});
+            base_par[b] = b;
+            source_bridge[mv] = x;
+            target_bridge[mv] = y;
+            /* Scan newly-EVEN vertex for edges at next Delta level */
+            for (int w : graph.neighbors(mv)) {
+                if (w == mate[mv]) continue;
+                int bw = find_base(w);
+                if (label[bw] == ODD) continue;
+                if (label[bw] == UNLABELED) {
+                    level_queue[Delta + 1].push_back({mv, w});
+                } else if (label[bw] == EVEN) {
+                    level_queue[Delta].push_back({mv, w});
+                }
+            }
+            v = find_base(parent[mv]);
+        }
+        dunions.push_back({b, b});
+    }
+
+    /* ================================================================ */
+    /*                          PHASE 1                                 */
+    /* ================================================================ */
+    /* Undo the previous phase: only its tree vertices changed, and edges
+       were only queued up to level Delta + 1 */
+    void reset_tree() {
+        for (int d = 0; d <= Delta + 1 && d < (int)level_queue.size(); d++) level_queue[d].clear();
+        int lo = n, hi = 0;
+        for (int v : tree_nodes) { lo = std::min(lo, v); hi = std::max(hi, v + 1); }
+        if (tree_nodes.size() > (size_t)(hi - lo) / RESET_SWEEP) {
+            /* dense: a linear sweep over [lo, hi) beats scattered writes */
+            for (int i = lo; i < hi; i++) {
+                base_par[i] = i;
+                dbase_par[i] = i;
+            }
+            std::fill(label.begin() + lo, label.begin() + hi, UNLABELED);
+            std::fill(parent.begin() + lo, parent.begin() + hi, NIL);
+            std::fill(source_bridge.begin() + lo, source_bridge.begin() + hi, NIL);
+            std::fill(target_bridge.begin() + lo, target_bridge.begin() + hi, NIL);
+            std::fill(in_tree.begin() + lo, in_tree.begin() + hi, false);
+        }
+        else {
+            for (int i : tree_nodes) {
+                base_par[i] = i;
+                dbase_par[i] = i;
+                label[i] = UNLABELED;
+                parent[i] = NIL;
+                source_bridge[i] = NIL;
+                target_bridge[i] = NIL;
+                in_tree[i] = false;
+            }
+        }
+        tree_nodes.clear();
+    }
+
+    bool phase_1() {
+        MATCHING_STAT_TIMER(times.search);
+        reset_tree();
+        Delta = 0;
+        std::vector<std::pair<int,int>> dunions;
+
+        /* Initialize: free vertices are EVEN roots at Delta=0; drop the
+           ones matched since the last phase */
+        int k = 0;
+        for (int v : free_vertices) {
+            if (mate[v] == NIL) {
+                free_vertices[k++] = v;
+                label[v] = EVEN;
+                in_tree[v] = true;
+                tree_nodes.push_back(v);
+                MATCHING_STAT(stat_arcs += graph.degree(v);)
+                for (int u : graph.neighbors(v)) {
+                    if (u == mate[v]) continue;
+                    int bu = find_base(u);
+                    if (label[bu] == ODD) continue;
+                    if (label[bu] == UNLABELED)
+                        level_queue[1].push_back({v, u});  /* grows at Delta=1 */
+                    else if (label[bu] == EVEN)
+                        level_queue[0].push_back({v, u});  /* EVEN-EVEN at Delta=0 */
+                }
+            }
+        }
+        free_vertices.resize(k);
+
+        bool found_sap = false;
+
+        while (Delta <= n) {
+            /* An EVEN vertex of level t is 2t edges from its root, so with
+               nothing found below Delta every augmenting path has at least
+               2 * Delta + 1 edges */
+            if (2 * Delta + 1 >= path_limit) {
+                path_bound = 2 * Delta + 1;
+                MATCHING_STAT(stat_levels += Delta;)
+                return false;
+            }
+            while (!level_queue[Delta].empty()) {
+                auto [z, u] = level_queue[Delta].back();
+                level_queue[Delta].pop_back();
+
+                int bz = find_base(z), bu = find_base(u);
+                if (label[bz] != EVEN) { std::swap(z, u); std::swap(bz, bu); }
+                if (bz == bu || label[bz] != EVEN) continue;
+                if (u == mate[z] || label[bu] == ODD) continue;
+
+                if (label[bu] == UNLABELED) {
+                    int mv = mate[u];
+                    if (mv == NIL) continue;
+                    parent[u] = z;
+                    parent[mv] = u;
+                    label[u] = ODD;
+                    label[mv] = EVEN;
+                    in_tree[u] = true;
+                    in_tree[mv] = true;
+                    tree_nodes.push_back(u);
+                    tree_nodes.push_back(mv);
+                    /* Record the grow edge as H-edge */
+                    /* Scan from newly EVEN vertex mv */
+                    MATCHING_STAT(stat_arcs += graph.degree(mv);)
+                    for (int w : graph.neighbors(mv)) {
+                        if (w == mate[mv]) continue;
+                        int bw = find_base(w);
+                        if (label[bw] == ODD) continue;
+                        if (label[bw] == UNLABELED)
+                            level_queue[Delta + 1].push_back({mv, w});
+                        else if (label[bw] == EVEN)
+                            level_queue[Delta].push_back({mv, w});
+                    }
+
+                } else if (label[bu] == EVEN) {
+                    int lca = find_lca(z, u);
+                    if (lca != NIL) {
+                        /* Blossom — record the shrink edge as H-edge */
+                        MATCHING_STAT(stat_blossoms++;)
+                        shrink_path(lca, z, u, dunions);
+                        shrink_path(lca, u, z, dunions);
+                    } else {
+                        /* Augmenting path found */
+                        found_sap = true;
+                        /* DON'T break — continue all edges at this Delta */
+                    }
+                }
+            }
+
+            if (found_sap) {
+                MATCHING_STAT(stat_levels += Delta + 1;)
+                /* Build H: contracted_into and mateH */
+                for (int v : tree_nodes) {
+                    int db = find_dbase(v);
+                    contracted_into[db].push_back(v);
+                    mateH[v] = NIL;
+                }
+                /* Set mateH for matching edges between different dbase components */
+                for (int u : tree_nodes) {
+                    int uh = find_dbase(u);
+                    int mv = mate[u];
+                    if (mv != NIL && in_tree[mv]) {
+                        int vh = find_dbase(mv);
+                        if (uh != vh) {
+                            mateH[uh] = vh;
+                            mateH[vh] = uh;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            /* Execute deferred dbase unions for this Delta */
+            for (auto& [a, b] : dunions) {
+                if (a == b) make_rep_dbase(a);
+                else union_dbase(a, b);
+            }
+            dunions.clear();
+            Delta++;
+            /* edges are only queued at Delta and Delta + 1, so an empty
+               next level means the search is exhausted */
+            if (level_queue[Delta].empty()) break;
+        }
+        MATCHING_STAT(stat_levels += Delta;)
+        return false;
+    }
+
+    /* ================================================================ */
+    /*                          PHASE 2                                 */
+    /* ================================================================ */
+
+    /* find_apHG: ITERATIVE DFS in H to find augmenting path.
+     * Returns the free H-node found, or NIL.
+     * Uses explicit stack to handle 500k+ vertices. */
+    int find_apHG(int root_vh) {
+        /* Stack frame for iterative DFS */
+        struct Frame {
+            int vh;           /* current H-node being scanned */
+            int ci_idx;       /* index into contracted_into[vh] */
+            int adj_idx;      /* index into graph.neighbors(v) */
+            int v;            /* current G-vertex being scanned */
+        };
+        std::vector<Frame> stk;
+        stk.push_back({root_vh, 0, 0, -1});
+
+        while (!stk.empty()) {
+            auto& f = stk.back();
+            int vh = f.vh;
+
+            /* Iterate through G-vertices in this H-node */
+            while (f.ci_idx < (int)contracted_into[vh].size()) {
+                f.v = contracted_into[vh][f.ci_idx];
+                int v = f.v;
+
+                /* Iterate through edges from this G-vertex */
+                while (f.adj_idx < graph.degree(v)) {
+                    int w = graph.neighbors(v)[f.adj_idx];
+                    f.adj_idx++;
+
+                    if (!in_tree[w]) continue;
+                    if (mate[v] == w) continue;  /* skip matching edges */
+                    int wh = find_dbase(w);
+                    if (wh == find_dbase(v)) continue;  /* same H-node */
+                    int uh = find_db2(rep[w]);
+                    if (mateH[vh] == uh) continue;  /* skip mate (raw, not through db2) */
+
+                    if (labelH[uh] == ODD) continue;  /* already ODD */
+
+                    if (labelH[uh] == UNLABELED) {
+                        int muh = mateH[uh];
+                        if (muh == NIL) {
+                            /* Free node — augmenting path found! */
+                            labelH[uh] = ODD;
+                            parentH_src[uh] = w;
+                            parentH_tgt[uh] = v;
+                            return uh;
+                        }
+                        /* Grow step: extend by two edges */
+                        labelH[uh] = ODD;
+                        parentH_src[uh] = w;
+                        parentH_tgt[uh] = v;
+                        labelH[muh] = EVEN;
+                        even_timeH[muh] = tH++;
+                        /* Push current state and recurse into muh */
+                        stk.push_back({muh, 0, 0, -1});
+                        goto next_frame;
+
+                    } else if (labelH[uh] == EVEN) {
+                        /* Blossom step */
+                        int bh = find_db2(vh);
+                        int zh = find_db2(uh);
+                        if (even_timeH[bh] < even_timeH[zh]) {
+                            std::vector<int> tmp, endpoints;
+                            int cur = zh;
+                            while (cur != bh) {
+                                endpoints.push_back(cur);
+                                int mc = mateH[cur];
+                                endpoints.push_back(mc);
+                                tmp.push_back(mc);
+                                int ps = parentH_src[mc], pt = parentH_tgt[mc];
+                                int next = rep[rep[ps] == mc ? pt : ps];
+                                cur = find_db2(next);
+                            }
+                            for (int nd : endpoints) union_db2(nd, bh);
+                            make_rep_db2(bh);
+
+                            for (int mc : tmp) {
+                                bridgeH_src[mc] = v;
+                                bridgeH_tgt[mc] = w;
+                                dirH[mc] = -1;
+                            }
+                            /* Push each new ODD node for scanning */
+                            for (int i = (int)tmp.size() - 1; i >= 0; i--) {
+                                stk.push_back({tmp[i], 0, 0, -1});
+                            }
+                            goto next_frame;
+                        }
+                    }
+                }
+                /* Done with this G-vertex, move to next */
+                f.ci_idx++;
+                f.adj_idx = 0;
+            }
+            /* Done with all G-vertices in vh — backtrack */
+            stk.pop_back();
+            continue;
+
+            next_frame:;
+        }
+        return NIL;
+    }
+
+    /* trace_H_path: iterative, collects non-matching G-edges along H-path */
+    void trace_H_path(int vh, int uh, std::vector<std::pair<int,int>>& edges_out) {
+        struct Frame { int vh, uh, phase, bs, bt, side_a, side_b; };
+        std::vector<Frame> stk;
+        stk.push_back({vh, uh, 0, 0, 0, 0, 0});
+
+        while (!stk.empty()) {
+            auto& f = stk.back();
+            if (f.vh == f.uh) { stk.pop_back(); continue; }
+
+            if (labelH[f.vh] == EVEN) {
+                int mvh = mateH[f.vh];
+                int ps = parentH_src[mvh], pt = parentH_tgt[mvh];
+                edges_out.push_back({ps, pt});
+                f.vh = rep[rep[ps] == mvh ? pt : ps];
+                continue;
+            }
+            if (f.phase == 0) {
+                f.bs = bridgeH_src[f.vh];
+                f.bt = bridgeH_tgt[f.vh];
+                if (dirH[f.vh] == 1) {
+                    f.side_a = rep[f.bs];
+                    f.side_b = rep[f.bt];
+                } else {
+                    f.side_a = rep[f.bt];
+                    f.side_b = rep[f.bs];
+                }
+                f.phase = 1;
+                int mt = (mateH[f.vh] != NIL) ? rep[mateH[f.vh]] : f.vh;
+                stk.push_back({f.side_a, mt, 0, 0, 0, 0, 0});
+                continue;
+            }
+            if (f.phase == 1) {
+                edges_out.push_back({f.bs, f.bt});
+                f.phase = 2;
+                stk.push_back({f.side_b, f.uh, 0, 0, 0, 0, 0});
+                continue;
+            }
+            stk.pop_back();
+        }
+    }
+
+    /* find_path_in_G: iterative unfold within single H-node */
+    void find_path_in_G(int v, int u, std::vector<std::pair<int,int>>& pairs) {
+        struct Frame { int v, u, phase, sb, tb; };
+        std::vector<Frame> stk;
+        stk.push_back({v, u, 0, 0, 0});
+
+        while (!stk.empty()) {
+            auto& f = stk.back();
+            if (f.v == f.u) { stk.pop_back(); continue; }
+            if (f.phase == 0) {
+                if (label[f.v] == EVEN) {
+                    int mv = mate[f.v], pmv = parent[mv];
+                    pairs.push_back({mv, pmv});
+                    f.v = pmv;
+                    continue;
+                }
+                f.sb = source_bridge[f.v];
+                f.tb = target_bridge[f.v];
+                f.phase = 1;
+                stk.push_back({f.sb, mate[f.v], 0, 0, 0});
+                continue;
+            }
+            if (f.phase == 1) {
+                pairs.push_back({f.sb, f.tb});
+                f.phase = 2;
+                stk.push_back({f.tb, f.u, 0, 0, 0});
+                continue;
+            }
+            stk.pop_back();
+        }
+    }
+
+    /* augmentG: unfold H-edges to G and augment */
+    void augmentG(const std::vector<std::pair<int,int>>& h_edges) {
+        std::vector<std::pair<int,int>> pairs;
+        for (auto& [u, v] : h_edges) {
+            pairs.push_back({u, v});
+            find_path_in_G(u, rep[u], pairs);
+            find_path_in_G(v, rep[v], pairs);
+        }
+        for (auto& [a, b] : pairs) {
+            mate[a] = b;
+            mate[b] = a;
+        }
+    }
+
+    /* phase_2: find all SAPs in H, unfold and augment */
+    void phase_2() {
+        MATCHING_STAT(stat_phases++;)
+        std::vector<std::vector<std::pair<int,int>>> all_paths;
+        {
+            MATCHING_STAT_TIMER(times.search);
+            for (int v : tree_nodes) {
+                rep[v] = find_dbase(v);
+                labelH[v] = UNLABELED;
+                parentH_src[v] = parentH_tgt[v] = NIL;
+                bridgeH_src[v] = bridgeH_tgt[v] = NIL;
+                dirH[v] = 0;
+                even_timeH[v] = 0;
+                dbase2_par[v] = v;
+            }
+            tH = 0;
+
+            for (int vh : tree_nodes) {
+                if (vh != rep[vh]) continue;
+                MATCHING_STAT(stat_h_nodes++;)
+                if (labelH[vh] != UNLABELED || mateH[vh] != NIL) continue;
+                MATCHING_STAT(stat_h_searches++;)
+
+                labelH[vh] = EVEN;
+                even_timeH[vh] = tH++;
+
+                int free_node = find_apHG(vh);
+                if (free_node != NIL) {
+                    std::vector<std::pair<int,int>> h_nm;
+                    int ps = parentH_src[free_node], pt = parentH_tgt[free_node];
+                    h_nm.push_back({ps, pt});
+                    int next = rep[rep[ps] == free_node ? pt : ps];
+                    trace_H_path(next, vh, h_nm);
+                    all_paths.push_back(std::move(h_nm));
+                }
+            }
+        }
+
+        MATCHING_STAT_TIMER(times.augment);
+        MATCHING_STAT(stat_paths += (long long)all_paths.size();)
+        for (auto& he : all_paths) augmentG(he);
+
+        /* Clean up */
+        for (int v : tree_nodes) {
+            int db = find_dbase(v);
+            contracted_into[db].clear();
+            contracted_into[v].clear();
+            mateH[v] = NIL;
+        }
+    }
+
+    /* ================================================================ */
+    /*                      MAIN ENTRY POINT                            */
+    /* Min-degree greedy: match each exposed vertex with its lowest-degree unmatched neighbor */
+    int greedy_init_md() {
+        int cnt = 0;
+        std::vector<int> deg(n, 0);
+        for (int u = 0; u < n; u++)
+            for (int v : graph.neighbors(u))
+                deg[v]++;
+        std::vector<int> order(n);
+        for (int i = 0; i < n; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b){ return deg[a] < deg[b] || (deg[a] == deg[b] && a < b); });
+        for (int u : order) {
+            if (mate[u] != NIL) continue;
+            int best = -1, best_deg = INT_MAX;
+            for (int v : graph.neighbors(u)) {
+                if (mate[v] == NIL && deg[v] < best_deg) {
+                    best = v; best_deg = deg[v];
+                }
+            }
+            if (best >= 0) { mate[u] = best; mate[best] = u; cnt++; }
+        }
+        return cnt;
+    }
+
+    /* ================================================================ */
+    std::vector<std::pair<int,int>> maximum_matching(int greedy_mode = 0) {
+        int greedy_count = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            MATCHING_STAT_TIMER(times.init);
+            if (greedy_mode == 1) {
+                for (int u = 0; u < n; u++) {
+                    if (mate[u] != NIL) continue;
+                    for (int v : graph.neighbors(u)) {
+                        if (mate[v] == NIL) { mate[u] = v; mate[v] = u; greedy_count++; break; }
+                    }
+                }
+            } else if (greedy_mode == 2) {
+                greedy_count = greedy_init_md();
+            } else if (greedy_mode == matching::GREEDY_KARP_SIPSER) {
+                greedy_count = matching::karp_sipser(graph, mate, init_threads);
+            }
+        }
+        greedy_size = greedy_count;
+        greedy_ms = matching::ms_since(t0);
+        free_vertices.clear();
+        for (int v = 0; v < n; v++)
+            if (mate[v] == NIL) free_vertices.push_back(v);
+        while (phase_1()) phase_2();
+
+        std::vector<std::pair<int,int>> result;
+        for (int u = 0; u < n; u++)
+            if (mate[u] != NIL && mate[u] > u)
+                result.push_back({u, mate[u]});
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /* Counters and stage times for --stats=json */
+    matching::Stats collect_stats() const {
+        matching::Stats st;
+        st.add("phases", stat_phases);
+        st.add("delta_levels", stat_levels);
+        st.add("phase1_arcs", stat_arcs);
+        st.add("blossoms", stat_blossoms);
+        st.add("h_nodes", stat_h_nodes);
+        st.add("h_searches", stat_h_searches);
+        st.add("augmentations", stat_paths);
+        times.add_to(st);
+        return st;
+    }
+};
+
+inline matching::Result run(GabowOptimized& gabow, const matching::Options& opt) {
+    const matching::Graph& g = gabow.graph;
+    gabow.init_threads = matching::init_threads(opt);
+    matching::Result r;
+    if (opt.initial) {
+        MATCHING_STAT_TIMER(gabow.times.init);
+        r.initial_size = matching::seed_matching(g, *opt.initial, gabow.mate);
+    }
+    gabow.path_limit = matching::epsilon_path_length(opt.epsilon);
+    r.matching = gabow.maximum_matching(opt.greedy_mode);
+    r.greedy_size = gabow.greedy_size;
+    r.greedy_ms = gabow.greedy_ms;
+    r.path_bound = gabow.path_bound;
+    MATCHING_STAT(r.stats = gabow.collect_stats();)
+    return r;
+}
+
+inline matching::Result solve(const matching::Graph& g, const matching::Options& opt = {}) {
+    GabowOptimized gabow(g);
+    return run(gabow, opt);
+}
+
+/* solve() in `ws`, left idle for the next graph */
+inline matching::Result solve_in(const matching::Graph& g, Workspace& ws, const matching::Options& opt = {}) {
+    GabowOptimized gabow(g, &ws);
+    return run(gabow, opt);
+}
+
+} // namespace gabow_optimized
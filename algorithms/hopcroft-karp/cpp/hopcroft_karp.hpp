@@ -0,0 +1,844 @@
+/*
+ * Hopcroft-Karp Algorithm - O(E√V) Maximum Bipartite Matching
+ *
+ * BFS to find shortest augmenting path length, then DFS to find
+ * all vertex-disjoint augmenting paths of that length.
+ *
+ * Runs on the shared bipartite CSR graph (matching::Graph::bipartite).
+ *
+ * With more than one thread the BFS phase is level-synchronous and
+ * direction-optimizing (bfs_parallel); it computes the same layering as
+ * the serial sweep. The augmenting phase then searches from many free
+ * vertices at once: by default threads claim vertices with CAS
+ * (augment_claimed, fastest, matching may differ from the serial one);
+ * with `deterministic` set, speculative searches are committed in serial
+ * order (augment_ordered) and the matching equals the serial one exactly.
+ *
+ * HopcroftKarpT is a template over the adjacency: matching::Graph, or
+ * matching::CompressedGraph for --compressed (gap-encoded rows,
+ * compressed_graph.hpp). Compressed rows have no random access by arc, so
+ * dfs() keeps a group cursor per left vertex next to it[], and the
+ * compressed instantiation runs the serial BFS and DFS only. Both come in
+ * a 64-bit offset flavor (Graph64, CompressedGraph64) for inputs past
+ * 2^31 - 1 arcs; arc indices (it[], search stacks) take the graph's
+ * arc_type, everything per vertex stays int.
+ *
+ * With --epsilon E the loop stops before the first phase whose paths are
+ * long enough to guarantee 1 - E of a maximum matching (solver.hpp,
+ * epsilon_path_length): the long-path tail is the part it skips.
+ *
+ * Built with -DMATCHING_STATS=1 (matching/stats.hpp) it counts phases,
+ * BFS passes, DFS searches, augmentations and the arcs each side scans;
+ * search_ns is the BFS layering and augment_ns the DFS phase, which finds
+ * and flips its paths in one pass.
+ *
+ * With --numa (matching/numa.hpp) the parallel solve places pair_left,
+ * pair_right, dist and the reverse CSR by vertex range on the nodes of
+ * the threads that scan them, and first-touches its atomic arrays from
+ * the same threads. The BFS frontier is one queue per socket: threads
+ * expand their own socket's queue and fill it with what they find.
+ *
+ * The serial arrays live in a Workspace, which solve_in() keeps for the
+ * next graph (matching/workspace.hpp); the destructor hands it back with
+ * no vertex matched. The parallel state is the solve's own.
+ *
+ * All integers, no hash containers; the serial and --deterministic runs are
+ * fully deterministic.
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <type_traits>
+
+#include "matching/compressed_graph.hpp"
+#include "matching/frontier_scan.hpp"
+#include "matching/graph.hpp"
+#include "matching/karp_sipser.hpp"
+#include "matching/numa.hpp"
+#include "matching/parallel.hpp"
+#include "matching/solver.hpp"
+#include "matching/stats.hpp"
+#include "matching/warm_start.hpp"
+#include "matching/workspace.hpp"
+
+namespace hopcroft_karp {
+
+using matching::NIL;
+
+/* HopcroftKarpT's serial arrays, reusable across solves on graphs with
+   the same arc type. Idle: NIL pairs; the rest is written before use. */
+template <class Arc>
+struct Workspace {
+    std::vector<int> pair_left, pair_right, dist;
+    std::vector<Arc> it;
+    std::vector<typename matching::BasicCompressedGraph<Arc>::Cursor> group;
+    std::vector<int> dfs_stack, bfs_queue;
+};
+
+template <class G>
+struct HopcroftKarpT {
+    using Arc = typename G::arc_type;
+    using Csr = matching::BasicGraph<Arc>;
+    using Cursor = typename matching::BasicCompressedGraph<Arc>::Cursor;
+    /* Flat CSR: arcs addressed by index, parallel phases available */
+    static constexpr bool CSR = std::is_same<G, Csr>::value;
+
+    std::unique_ptr<Workspace<Arc>> own_ws;   /* when the caller lends none */
+    Workspace<Arc>& ws;
+
+    const G& graph;               /* graph.neighbors(u) = right nodes of left u */
+    const Csr& csr;               /* the same graph as a CSR, for Karp-Sipser */
+    int left_count;
+    int greedy_size = 0;
+    double greedy_ms = 0;
+    int path_limit = INT_MAX;   /* --epsilon: stop before a phase with paths this long */
+    int path_bound = 0;         /* set when it did: the paths the next phase would take */
+    int right_count;
+    std::vector<int>& pair_left = ws.pair_left;
+    std::vector<int>& pair_right = ws.pair_right;
+    std::vector<int>& dist = ws.dist;
+    std::vector<Arc>& it = ws.it;             /* next arc of each left vertex, kept for a whole phase */
+    std::vector<Cursor>& group = ws.group;    /* compressed: group holding it[x] */
+    std::vector<int>& dfs_stack = ws.dfs_stack;   /* left vertices on the current search path */
+    std::vector<int>& bfs_queue = ws.bfs_queue;
+    matching::ScanFn scan = matching::scan_scalar;   /* serial BFS kernel, frontier_scan.hpp */
+
+    /* --stats=json (stats.hpp); the counters only move under MATCHING_STATS */
+    matching::StageTimes times;
+    long long stat_phases = 0, stat_bfs = 0, stat_dfs = 0, stat_paths = 0;
+    long long stat_bfs_arcs = 0, stat_dfs_arcs = 0;
+
+    /* Parallel BFS state, allocated only when threads > 1 */
+    int threads;
+    int numa = matching::NUMA_NONE;              /* --numa: placement of the parallel solve's arrays */
+    std::unique_ptr<matching::ThreadPool> pool;
+    Csr reverse;                                 /* right -> left arcs, for bottom-up steps */
+    std::unique_ptr<std::atomic<int>[]> level;   /* BFS level per left vertex */
+    matching::SocketGroups sockets;              /* pool threads by node */
+    std::vector<std::vector<int>> frontiers;     /* per-socket frontier queues */
+    size_t frontier_size = 0;                    /* of all queues */
+    std::vector<std::vector<int>> next_local;    /* per-thread next-frontier buffers */
+    std::vector<long long> next_arcs;            /* per-thread arc count of those buffers */
+
+    /* Parallel DFS state (see augment_phase) */
+    bool deterministic;
+    int phase = 0;
+    long long round_base = 0;                               /* deterministic rounds: base of this round's ids */
+    std::unique_ptr<std::atomic<int>[]> claim_left;         /* phase in which the left vertex was claimed */
+    std::unique_ptr<std::atomic<int>[]> claim_right;        /* phase in which the free right vertex was claimed */
+    std::unique_ptr<std::atomic<long long>[]> spec_dead;    /* id of the speculative search that failed here */
+    std::unique_ptr<std::atomic<long long>[]> writer_left;  /* lowest round id changing dist[x] */
+    std::unique_ptr<std::atomic<long long>[]> writer_right; /* lowest round id changing pair_right[v] */
+    std::vector<int> free_list;
+
+    struct SearchStack { std::vector<int> vertex; std::vector<Arc> edge; long long arcs = 0; };
+    /* A speculative search: its outcome, writes (path, dead) and reads (scanned) */
+    struct Trace {
+        bool ok = false;
+        std::vector<Arc> path;      /* flattened (left, arc) pairs */
+        std::vector<int> dead;      /* left vertices whose dist becomes INT_MAX */
+        std::vector<int> scanned;   /* right vertices whose pair_right was read */
+    };
+    std::vector<SearchStack> stacks;                /* per thread */
+    std::vector<std::vector<int>> found_paths;      /* per thread, flattened (left, right) pairs */
+    std::vector<Trace> traces;                      /* per slot of a deterministic round */
+
+    static const int DFS_GRAIN = 256;    /* free vertices below which a phase augments serially */
+    static const int DFS_CHUNK = 64;     /* free vertices taken per grab in augment_claimed */
+    static const int DFS_BATCH = 32;     /* searches per thread in one augment_ordered round */
+
+    static const int BFS_ALPHA = 14;     /* go bottom-up when frontier arcs > unexplored / ALPHA */
+    static const int BFS_BETA = 24;      /* back to top-down when frontier < left / BETA */
+    static const int BFS_GRAIN = 8192;   /* frontier arcs below which a level runs on one thread */
+    static const int SCAN_DEGREE = 16;   /* degree from which bfs() uses the scan kernel */
+
+    explicit HopcroftKarpT(const Csr& g, int num_threads = 1, bool deterministic_dfs = false,
+                           Workspace<Arc>* w = nullptr)
+        : HopcroftKarpT(g, g, num_threads, deterministic_dfs, w) {}
+
+    /* `g` encodes the CSR `source`; CompressedGraph runs on one thread.
+       Binds to *w (grown if needed), or to a workspace of its own. */
+    HopcroftKarpT(const G& g, const Csr& source, int num_threads, bool deterministic_dfs,
+                  Workspace<Arc>* w = nullptr)
+        : own_ws(w ? nullptr : new Workspace<Arc>), ws(w ? *w : *own_ws),
+          graph(g), csr(source), left_count(g.num_vertices()), right_count(g.num_right()),
+          threads(CSR ? matching::resolve_threads(num_threads) : 1), deterministic(deterministic_dfs) {
+        MATCHING_STAT_TIMER(times.setup);
+        matching::grow_idle(pair_left, (size_t)left_count, NIL);
+        matching::grow_idle(pair_right, (size_t)right_count, NIL);
+        if (dist.size() < (size_t)left_count + 1) dist.resize(left_count + 1);
+        if (it.size() < (size_t)left_count) it.resize(left_count);
+        if (bfs_queue.size() < (size_t)left_count) bfs_queue.resize(left_count);
+        if (!CSR && group.size() < (size_t)left_count) group.resize(left_count);
+    }
+
+    /* A lent workspace goes back with nothing matched */
+    ~HopcroftKarpT() {
+        if (own_ws) return;
+        std::fill(pair_left.begin(), pair_left.begin() + left_count, NIL);
+        std::fill(pair_right.begin(), pair_right.begin() + right_count, NIL);
+    }
+
+    HopcroftKarpT(const HopcroftKarpT&) = delete;
+    HopcroftKarpT& operator=(const HopcroftKarpT&) = delete;
+
+    bool bfs() {
+        MATCHING_STAT_TIMER(times.search);
+        MATCHING_STAT(stat_bfs++;)
+        std::vector<int>& queue = bfs_queue;
+        int qh = 0, qt = 0;
+
+        for (int u = 0; u < left_count; u++) {
+            if (pair_left[u] == NIL) { dist[u] = 0; queue[qt++] = u; }
+            else dist[u] = INT_MAX;
+        }
+        dist[left_count] = INT_MAX; /* NIL sentinel */
+
+        int buf[matching::SCAN_BLOCK];
+        int row[CSR ? 1 : matching::SCAN_BLOCK];   /* compressed: decoded block */
+        while (qh < qt) {
+            int u = queue[qh++];
+            if (dist[u] < dist[left_count]) {
+                auto nb = graph.neighbors(u);
+                MATCHING_STAT(stat_bfs_arcs += nb.size();)
+                if (nb.size() < SCAN_DEGREE) {
+                    for (int v : nb) visit(u, v, queue, qt);
+                    continue;
+                }
+                /* High degree: gather-check blocks of neighbors, visit the
+                   ones still unvisited at load time */
+                Cursor cur{};
+                if constexpr (!CSR) cur = graph.cursor(u);
+                for (int off = 0; off < nb.size(); off += matching::SCAN_BLOCK) {
+                    int len = std::min(matching::SCAN_BLOCK, nb.size() - off);
+                    const int* block;
+                    if constexpr (CSR) block = nb.begin() + off;
+                    else { graph.read(cur, len, row); block = row; }
+                    int cnt = scan(block, len, pair_right.data(), left_count,
+                                   dist.data(), INT_MAX, buf);
+                    for (int i = 0; i < cnt; i++) visit(u, buf[i], queue, qt);
+                }
+            }
+        }
+        return dist[left_count] != INT_MAX;
+    }
+
+    void visit(int u, int v, std::vector<int>& queue, int& qt) {
+        int pn = (pair_right[v] == NIL) ? left_count : pair_right[v];
+        if (dist[pn] == INT_MAX) {
+            dist[pn] = dist[u] + 1;
+            if (pair_right[v] != NIL) queue[qt++] = pair_right[v];
+        }
+    }
+
+    /* ---- Parallel level-synchronous BFS ----
+       BFS distances are unique, so this assigns exactly the dist[] values of
+       bfs(): every vertex at layer <= dist[NIL], INT_MAX elsewhere. A level
+       is expanded either top-down (frontier scans its arcs and claims
+       unvisited mates by CAS) or bottom-up (each unvisited matched left
+       right vertex looks for a frontier neighbor in the reverse graph and
+       hands the level on to its mate), switching on the frontier-edge heuristic of Beamer et al. */
+    void setup_parallel() {
+        MATCHING_STAT_TIMER(times.setup);
+        pool.reset(new matching::ThreadPool(threads));
+        reverse = graph.transposed(threads);
+        matching::numa_place_graph(reverse, numa, pool->size());
+        level.reset(new std::atomic<int>[left_count > 0 ? left_count : 1]);
+        sockets = matching::socket_groups(pool->size());
+        frontiers.assign(sockets.count, {});
+        if (sockets.count == 1) frontiers[0].reserve(left_count);
+        next_local.assign(pool->size(), {});
+        next_arcs.assign(pool->size(), 0);
+
+        size_t nl = left_count > 0 ? left_count : 1, nr = right_count > 0 ? right_count : 1;
+        stacks.assign(pool->size(), {});
+        if (deterministic) {
+            spec_dead.reset(new std::atomic<long long>[nl]);
+            writer_left.reset(new std::atomic<long long>[nl]);
+            writer_right.reset(new std::atomic<long long>[nr]);
+            fill_parallel(spec_dead.get(), nl, -1LL);
+            fill_parallel(writer_left.get(), nl, -1LL);
+            fill_parallel(writer_right.get(), nr, -1LL);
+            traces.resize((size_t)DFS_BATCH * pool->size());
+        } else {
+            claim_left.reset(new std::atomic<int>[nl]);
+            claim_right.reset(new std::atomic<int>[nr]);
+            fill_parallel(claim_left.get(), nl, 0);
+            fill_parallel(claim_right.get(), nr, 0);
+            found_paths.assign(pool->size(), {});
+        }
+    }
+
+    /* a[i] = x, each thread its own vertex range: first touch puts the
+       pages on the thread's node */
+    template <class T>
+    void fill_parallel(std::atomic<T>* a, size_t n, T x) {
+        pool->run([&](int t) {
+            size_t hi = matching::chunk_begin(n, pool->size(), t + 1);
+            for (size_t i = matching::chunk_begin(n, pool->size(), t); i < hi; i++)
+                a[i].store(x, std::memory_order_relaxed);
+        });
+    }
+
+    /* --numa: the mates and distances by vertex range on the nodes of the
+       threads that scan them, before Karp-Sipser writes them */
+    void place_arrays() {
+        matching::numa_place(pair_left.data(), (size_t)left_count, numa, threads);
+        matching::numa_place(pair_right.data(), (size_t)right_count, numa, threads);
+        matching::numa_place(dist.data(), (size_t)left_count + 1, numa, threads);
+    }
+
+    /* Run fn(t, parts) on the pool, or on the caller alone for small work */
+    template <class F>
+    void run_step(bool parallel, F&& fn) {
+        if (parallel) { int parts = pool->size(); pool->run([&](int t) { fn(t, parts); }); }
+        else fn(0, 1);
+    }
+
+    /* Concatenate the per-thread buffers of each socket into its queue
+       (thread order); returns the frontier's arc count. With several
+       sockets each queue is sized by a thread of its own socket, so its
+       pages stay there. */
+    long long gather_frontier(int parts) {
+        std::vector<size_t> off(parts), len(sockets.count, 0);
+        long long arcs = 0;
+        for (int t = 0; t < parts; t++) {
+            int s = sockets.socket[t];
+            off[t] = len[s];
+            len[s] += next_local[t].size();
+            arcs += next_arcs[t];
+        }
+        frontier_size = 0;
+        for (size_t l : len) frontier_size += l;
+        if (sockets.count == 1) frontiers[0].resize(len[0]);
+        else run_step(parts > 1, [&](int t, int p) {
+            for (int s = 0; s < sockets.count; s++)
+                if (p == 1 || sockets.leader[s] == t) frontiers[s].resize(len[s]);
+        });
+        run_step(parts > 1, [&](int t, int) {
+            std::copy(next_local[t].begin(), next_local[t].end(), frontiers[sockets.socket[t]].begin() + off[t]);
+        });
+        return arcs;
+    }
+
+    bool bfs_parallel() {
+        MATCHING_STAT_TIMER(times.search);
+        MATCHING_STAT(stat_bfs++; std::atomic<long long> up_arcs(0);)
+        const int INF = INT_MAX;
+        std::atomic<int>* lv = level.get();
+        std::atomic<bool> found(false);
+        int parts = pool->size();
+
+        run_step(true, [&](int t, int p) {
+            next_local[t].clear();
+            next_arcs[t] = 0;
+            for (int u = (int)matching::chunk_begin(left_count, p, t); u < (int)matching::chunk_begin(left_count, p, t + 1); u++) {
+                if (pair_left[u] == NIL) {
+                    lv[u].store(0, std::memory_order_relaxed);
+                    next_local[t].push_back(u);
+                    next_arcs[t] += graph.degree(u);
+                } else {
+                    lv[u].store(INF, std::memory_order_relaxed);
+                }
+            }
+        });
+        long long frontier_arcs = gather_frontier(parts);
+        long long unexplored = graph.num_arcs();
+        bool bottom_up = false;
+        int L = 0;
+
+        while (frontier_size > 0 && !found.load(std::memory_order_relaxed)) {
+            if (!bottom_up && frontier_arcs > unexplored / BFS_ALPHA) bottom_up = true;
+            else if (bottom_up && (long long)frontier_size < left_count / BFS_BETA) bottom_up = false;
+            unexplored -= frontier_arcs;
+            MATCHING_STAT(if (!bottom_up) stat_bfs_arcs += frontier_arcs;)
+            bool wide = bottom_up || frontier_arcs >= BFS_GRAIN;
+            int used = wide ? parts : 1;
+
+            if (!bottom_up) {
+                run_step(wide, [&](int t, int p) {
+                    std::vector<int>& out = next_local[t];
+                    out.clear();
+                    next_arcs[t] = 0;
+                    auto expand = [&](const std::vector<int>& queue, int k, int r) {
+                        size_t lo = matching::chunk_begin(queue.size(), k, r);
+                        size_t hi = matching::chunk_begin(queue.size(), k, r + 1);
+                        for (size_t i = lo; i < hi; i++) {
+                            for (int v : graph.neighbors(queue[i])) {
+                                int w = pair_right[v];
+                                if (w == NIL) { found.store(true, std::memory_order_relaxed); continue; }
+                                int expected = INF;
+                                if (lv[w].load(std::memory_order_relaxed) == INF &&
+                                    lv[w].compare_exchange_strong(expected, L + 1, std::memory_order_relaxed)) {
+                                    out.push_back(w);
+                                    next_arcs[t] += graph.degree(w);
+                                }
+                            }
+                        }
+                    };
+                    if (p == 1) {
+                        for (const std::vector<int>& queue : frontiers) expand(queue, 1, 0);
+                    } else {
+                        int s = sockets.socket[t];   /* this socket's queue, split among its threads */
+                        expand(frontiers[s], sockets.size[s], sockets.rank[t]);
+                    }
+                });
+            } else {
+                run_step(true, [&](int t, int p) {
+                    std::vector<int>& out = next_local[t];
+                    out.clear();
+                    next_arcs[t] = 0;
+                    MATCHING_STAT(long long scanned = 0;)
+                    for (int v = (int)matching::chunk_begin(right_count, p, t); v < (int)matching::chunk_begin(right_count, p, t + 1); v++) {
+                        int w = pair_right[v];
+                        if (w != NIL && lv[w].load(std::memory_order_relaxed) != INF) continue;
+                        for (int u : reverse.neighbors(v)) {
+                            MATCHING_STAT(scanned++;)
+                            if (lv[u].load(std::memory_order_relaxed) != L) continue;
+                            if (w == NIL) {
+                                found.store(true, std::memory_order_relaxed);
+                            } else {
+                                lv[w].store(L + 1, std::memory_order_relaxed);
+                                out.push_back(w);
+                                next_arcs[t] += graph.degree(w);
+                            }
+                            break;
+                        }
+                    }
+                    MATCHING_STAT(up_arcs.fetch_add(scanned, std::memory_order_relaxed);)
+                });
+            }
+            L++;
+            frontier_arcs = gather_frontier(used);
+        }
+
+        run_step(true, [&](int t, int p) {
+            for (int u = (int)matching::chunk_begin(left_count, p, t); u < (int)matching::chunk_begin(left_count, p, t + 1); u++)
+                dist[u] = lv[u].load(std::memory_order_relaxed);
+        });
+        dist[left_count] = found.load() ? L : INF;
+        MATCHING_STAT(stat_bfs_arcs += up_arcs.load();)
+        return found.load();
+    }
+
+    /* Iterative DFS from free left `root` along the layered graph. it[x]
+       survives the whole phase (Dinic's current-arc trick): an arc is
+       skipped once it fails, and after an augmentation it[x] stays on the
+       path arc. Each arc is thus passed once per phase, O(E), and the
+       explicit stack allows paths of any length. */
+    bool dfs(int root) {
+        dfs_stack.assign(1, root);
+        while (!dfs_stack.empty()) {
+            int x = dfs_stack.back();
+            if (it[x] == graph.adj_start(x + 1)) {
+                dist[x] = INT_MAX;
+                dfs_stack.pop_back();
+                continue;
+            }
+            MATCHING_STAT(stat_dfs_arcs++;)
+            int v = arc_target(x);
+            int pn = (pair_right[v] == NIL) ? left_count : pair_right[v];
+            if (dist[pn] != dist[x] + 1) { next_arc(x); continue; }
+            if (pn == left_count) {
+                for (int y : dfs_stack) {
+                    int w = arc_target(y);
+                    pair_right[w] = y;
+                    pair_left[y] = w;
+                }
+                return true;
+            }
+            dfs_stack.push_back(pn);
+        }
+        return false;
+    }
+
+    /* Target of x's current arc it[x]. Compressed rows decode the group
+       holding it, group[x], again on every call. */
+    int arc_target(int x) const {
+        if constexpr (CSR) {
+            return graph.targets()[it[x]];
+        } else {
+            Cursor c = group[x];
+            int vals[4];
+            graph.read_group(c, vals);
+            return vals[(int)(it[x] - graph.adj_start(x)) & 3];
+        }
+    }
+
+    void next_arc(int x) {
+        it[x]++;
+        if constexpr (!CSR) {
+            if (((int)(it[x] - graph.adj_start(x)) & 3) == 0 && it[x] != graph.adj_start(x + 1)) {
+                int vals[4];
+                graph.read_group(group[x], vals);
+            }
+        }
+    }
+
+    /* ---- Parallel augmentation ----
+       Augmenting paths of one phase are vertex-disjoint shortest paths in
+       the layered graph, so searches from different free vertices can run
+       at once as long as no two of them use the same vertex. Paths found in
+       a round are applied after it, keeping pair_left/pair_right read-only
+       while threads search. Searches use an explicit stack. */
+    void augment_phase() {
+        MATCHING_STAT_TIMER(times.augment);
+        MATCHING_STAT(stat_phases++;)
+        if constexpr (!CSR) {
+            for (int u = 0; u < left_count; u++) { it[u] = graph.adj_start(u); group[u] = graph.cursor(u); }
+        } else {
+            std::copy(graph.offsets(), graph.offsets() + left_count, it.begin());
+        }
+        if constexpr (CSR) {
+            if (threads > 1) {
+                free_list.clear();
+                for (int u = 0; u < left_count; u++)
+                    if (pair_left[u] == NIL) free_list.push_back(u);
+                if ((int)free_list.size() >= DFS_GRAIN) {
+                    if (deterministic) augment_ordered();
+                    else augment_claimed();
+                    MATCHING_STAT(
+                        stat_dfs += (long long)free_list.size();
+                        for (SearchStack& st : stacks) { stat_dfs_arcs += st.arcs; st.arcs = 0; }
+                    )
+                    return;
+                }
+            }
+        }
+        for (int u = 0; u < left_count; u++) {
+            if (pair_left[u] == NIL) { MATCHING_STAT(stat_dfs++;) dfs(u); }
+        }
+    }
+
+    static bool claim(std::atomic<int>& slot, int stamp) {
+        int old = slot.load(std::memory_order_relaxed);
+        return old != stamp && slot.compare_exchange_strong(old, stamp, std::memory_order_relaxed);
+    }
+
+    /* Search from free left `root`, claiming every left vertex entered and
+       the free right vertex that ends the path, so concurrent searches stay
+       vertex-disjoint. A claimed vertex that fails stays claimed, playing
+       the role of dist[u] = INT_MAX in dfs(). Appends the path to `out`. */
+    bool dfs_claim(int root, SearchStack& st, std::vector<int>& out) {
+        const int* adj = graph.targets();
+        st.vertex.assign(1, root);
+        st.edge.assign(1, graph.adj_start(root));
+        while (!st.vertex.empty()) {
+            int x = st.vertex.back();
+            Arc& e = st.edge.back();
+            if (e == graph.adj_start(x + 1)) { st.vertex.pop_back(); st.edge.pop_back(); continue; }
+            int v = adj[e++];
+            MATCHING_STAT(st.arcs++;)
+            int w = pair_right[v];
+            if (w == NIL) {
+                if (dist[left_count] == dist[x] + 1 && claim(claim_right[v], phase)) {
+                    for (size_t i = 0; i < st.vertex.size(); i++) {
+                        out.push_back(st.vertex[i]);
+                        out.push_back(adj[st.edge[i] - 1]);
+                    }
+                    return true;
+                }
+            } else if (dist[w] == dist[x] + 1 && claim(claim_left[w], phase)) {
+                st.vertex.push_back(w);
+                st.edge.push_back(graph.adj_start(w));
+            }
+        }
+        return false;
+    }
+
+    void augment_claimed() {
+        phase++;
+        size_t n = free_list.size();
+        std::atomic<size_t> next(0);
+        pool->run([&](int t) {
+            std::vector<int>& out = found_paths[t];
+            out.clear();
+            for (;;) {
+                size_t lo = next.fetch_add(DFS_CHUNK, std::memory_order_relaxed);
+                if (lo >= n) break;
+                size_t hi = std::min(n, lo + (size_t)DFS_CHUNK);
+                for (size_t i = lo; i < hi; i++) dfs_claim(free_list[i], stacks[t], out);
+            }
+        });
+        pool->run([&](int t) {
+            const std::vector<int>& out = found_paths[t];
+            for (size_t k = 0; k < out.size(); k += 2) {
+                pair_left[out[k]] = out[k + 1];
+                pair_right[out[k + 1]] = out[k];
+            }
+        });
+    }
+
+    /* Replay dfs(root) without writing shared state: the outcome and the
+       writes dfs() would make go to `tr`, along with every right vertex
+       whose mate (and so the mate's dist and it[]) was read. Failed
+       vertices are marked with this search's id in spec_dead; a mark
+       overwritten by another search only costs a re-scan, never a
+       different outcome. */
+    void speculate(int root, long long id, SearchStack& st, Trace& tr) {
+        const int* adj = graph.targets();
+        tr.ok = false;
+        tr.path.clear();
+        tr.dead.clear();
+        tr.scanned.clear();
+        st.vertex.assign(1, root);
+        st.edge.assign(1, it[root]);
+        while (!st.vertex.empty()) {
+            int x = st.vertex.back();
+            Arc& e = st.edge.back();
+            if (e == graph.adj_start(x + 1)) {
+                tr.dead.push_back(x);
+                spec_dead[x].store(id, std::memory_order_relaxed);
+                st.vertex.pop_back();
+                st.edge.pop_back();
+                continue;
+            }
+            int v = adj[e++];
+            MATCHING_STAT(st.arcs++;)
+            tr.scanned.push_back(v);
+            int w = pair_right[v];
+            int dw = w == NIL ? dist[left_count]
+                   : spec_dead[w].load(std::memory_order_relaxed) == id ? INT_MAX : dist[w];
+            if (dw != dist[x] + 1) continue;
+            if (w == NIL) {
+                for (size_t i = 0; i < st.vertex.size(); i++) {
+                    tr.path.push_back(st.vertex[i]);
+                    tr.path.push_back(st.edge[i] - 1);
+                }
+                tr.ok = true;
+                return;
+            }
+            st.vertex.push_back(w);
+            st.edge.push_back(it[w]);
+        }
+    }
+
+    static void atomic_min(std::atomic<long long>& slot, long long id, long long base) {
+        long long cur = slot.load(std::memory_order_relaxed);
+        while ((cur < base || cur > id) &&
+               !slot.compare_exchange_weak(cur, id, std::memory_order_relaxed)) {}
+    }
+
+    /* Deterministic reservations: speculate a window of free vertices in
+       parallel against the current state, record the lowest window slot
+       writing each vertex, then commit the longest prefix whose searches
+       read nothing written by an earlier slot. Those replays are exactly
+       what serial dfs() calls in this order would do, and their writes are
+       disjoint. The window restarts at the first conflicting slot. */
+    void augment_ordered() {
+        const int* adj = graph.targets();
+        size_t n = free_list.size();
+        size_t max_window = traces.size();
+        size_t window = pool->size();
+        size_t lo = 0;
+        while (lo < n) {
+            size_t cnt = std::min(window, n - lo);
+            long long base = round_base;
+            round_base += (long long)cnt;
+            std::atomic<size_t> next(0);
+            pool->run([&](int t) {
+                for (;;) {
+                    size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                    if (i >= cnt) break;
+                    Trace& tr = traces[i];
+                    speculate(free_list[lo + i], base + (long long)i, stacks[t], tr);
+                    for (int x : tr.dead) atomic_min(writer_left[x], base + (long long)i, base);
+                    for (size_t k = 1; k < tr.path.size(); k += 2)
+                        atomic_min(writer_right[adj[tr.path[k]]], base + (long long)i, base);
+                }
+            });
+
+            std::atomic<size_t> first_conflict(cnt);
+            pool->run([&](int t) {
+                int parts = pool->size();
+                for (size_t i = matching::chunk_begin(cnt, parts, t); i < matching::chunk_begin(cnt, parts, t + 1); i++) {
+                    long long mine = base + (long long)i;
+                    auto earlier = [&](const std::atomic<long long>& slot) {
+                        long long w = slot.load(std::memory_order_relaxed);
+                        return w >= base && w < mine;
+                    };
+                    for (int v : traces[i].scanned) {
+                        int w = pair_right[v];
+                        if (earlier(writer_right[v]) || (w != NIL && earlier(writer_left[w]))) {
+                            size_t cur = first_conflict.load(std::memory_order_relaxed);
+                            while (i < cur && !first_conflict.compare_exchange_weak(cur, i, std::memory_order_relaxed)) {}
+                            break;
+                        }
+                    }
+                }
+            });
+
+            size_t valid = first_conflict.load();
+            pool->run([&](int t) {
+                int parts = pool->size();
+                for (size_t i = matching::chunk_begin(valid, parts, t); i < matching::chunk_begin(valid, parts, t + 1); i++) {
+                    const Trace& tr = traces[i];
+                    for (int x : tr.dead) dist[x] = INT_MAX;
+                    for (size_t k = 0; k < tr.path.size(); k += 2) {
+                        int u = (int)tr.path[k], v = adj[tr.path[k + 1]];
+                        it[u] = tr.path[k + 1];
+                        pair_left[u] = v;
+                        pair_right[v] = u;
+                    }
+                }
+            });
+            lo += valid;
+            /* Grow the window while it commits whole, shrink it to what
+               committed otherwise: long searches late in the run collide */
+            window = valid == cnt ? std::min(max_window, 2 * window) : std::max<size_t>(1, valid);
+        }
+    }
+
+    /* Greedy initial matching: iterate left vertices, pick first available right neighbor */
+    int greedy_init() {
+        int cnt = 0;
+        for (int u = 0; u < left_count; u++) {
+            if (pair_left[u] != NIL) continue;
+            for (int v : graph.neighbors(u)) {
+                if (pair_right[v] == NIL) { pair_left[u] = v; pair_right[v] = u; cnt++; break; }
+            }
+        }
+        return cnt;
+    }
+
+    /* Min-degree greedy: match each exposed left vertex with its lowest-degree unmatched right neighbor */
+    int greedy_init_md() {
+        int cnt = 0;
+        std::vector<int> deg(right_count, 0);
+        for (int u = 0; u < left_count; u++)
+            for (int v : graph.neighbors(u))
+                deg[v]++;
+        std::vector<int> order(left_count);
+        for (int i = 0; i < left_count; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b){
+            return graph.degree(a) < graph.degree(b) ||
+                   (graph.degree(a) == graph.degree(b) && a < b);
+        });
+        for (int u : order) {
+            if (pair_left[u] != NIL) continue;
+            int best = -1, best_deg = INT_MAX;
+            for (int v : graph.neighbors(u)) {
+                if (pair_right[v] == NIL && deg[v] < best_deg) {
+                    best = v; best_deg = deg[v];
+                }
+            }
+            if (best >= 0) { pair_left[u] = best; pair_right[best] = u; cnt++; }
+        }
+        return cnt;
+    }
+
+
+    /* The layering just built gives the shortest augmenting paths
+       2 * dist[NIL] - 1 edges; --epsilon stops once that reaches path_limit */
+    bool stop_early() {
+        int len = 2 * dist[left_count] - 1;
+        if (len < path_limit) return false;
+        path_bound = len;
+        return true;
+    }
+
+    std::vector<std::pair<int,int>> maximum_matching(int greedy_mode = 0) {
+        int greedy_count = 0;
+        if constexpr (CSR)
+            if (threads > 1) place_arrays();
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            MATCHING_STAT_TIMER(times.init);
+            if (greedy_mode == 1) greedy_count = greedy_init();
+            else if (greedy_mode == 2) greedy_count = greedy_init_md();
+            else if (greedy_mode == matching::GREEDY_KARP_SIPSER)
+                greedy_count = matching::karp_sipser_bipartite(csr, pair_left, pair_right, deterministic ? 1 : threads);
+        }
+        greedy_size = greedy_count;
+        greedy_ms = matching::ms_since(t0);
+        MATCHING_STAT(long long start_size = 0;
+                      for (int u = 0; u < left_count; u++) start_size += pair_left[u] != NIL;)
+        if constexpr (CSR) {
+            if (threads > 1) setup_parallel();
+            while ((threads > 1 ? bfs_parallel() : bfs()) && !stop_early()) augment_phase();
+        } else {
+            while (bfs() && !stop_early()) augment_phase();
+        }
+
+        std::vector<std::pair<int,int>> matching;
+        for (int u = 0; u < left_count; u++) {
+            if (pair_left[u] != NIL) matching.push_back({u, pair_left[u]});
+        }
+        std::sort(matching.begin(), matching.end());
+        MATCHING_STAT(stat_paths = (long long)matching.size() - start_size;)
+        return matching;
+    }
+
+    /* Counters and stage times for --stats=json */
+    matching::Stats collect_stats() const {
+        matching::Stats st;
+        st.add("phases", stat_phases);
+        st.add("bfs_passes", stat_bfs);
+        st.add("dfs_searches", stat_dfs);
+        st.add("augmentations", stat_paths);
+        st.add("bfs_arcs", stat_bfs_arcs);
+        st.add("dfs_arcs", stat_dfs_arcs);
+        times.add_to(st);
+        return st;
+    }
+};
+
+using HopcroftKarp = HopcroftKarpT<matching::Graph>;
+
+template <class G>
+inline matching::Result run(HopcroftKarpT<G>& hk, const matching::Options& opt) {
+    hk.scan = matching::scan_kernel(matching::resolve_scan(opt.scan));
+    hk.numa = opt.numa;
+    matching::Result r;
+    if (opt.initial) {
+        MATCHING_STAT_TIMER(hk.times.init);
+        r.initial_size = matching::seed_matching(hk.csr, *opt.initial, hk.pair_left, hk.pair_right);
+    }
+    hk.path_limit = matching::epsilon_path_length(opt.epsilon);
+    r.matching = hk.maximum_matching(opt.greedy_mode);
+    r.greedy_size = hk.greedy_size;
+    r.greedy_ms = hk.greedy_ms;
+    r.path_bound = hk.path_bound;
+    MATCHING_STAT(r.stats = hk.collect_stats();)
+    return r;
+}
+
+/* With opt.compressed, g is gap-encoded first and searched serially;
+   Karp-Sipser and the warm start still read g. Arc is int, or int64_t for
+   matching::Graph64. */
+template <class Arc>
+inline matching::Result solve_with(const matching::BasicGraph<Arc>& g, Workspace<Arc>* ws,
+                                   const matching::Options& opt) {
+    if (!opt.compressed) {
+        HopcroftKarpT<matching::BasicGraph<Arc>> hk(g, matching::solve_threads(opt), opt.deterministic, ws);
+        return run(hk, opt);
+    }
+    using Compressed = matching::BasicCompressedGraph<Arc>;
+    auto t0 = std::chrono::steady_clock::now();
+    Compressed cg = Compressed::compress(g, opt.threads, matching::resolve_decode(opt.scan));
+    double compress_ms = matching::ms_since(t0);
+    HopcroftKarpT<Compressed> hk(cg, g, 1, opt.deterministic, ws);
+    matching::Result r = run(hk, opt);
+    r.compress_ms = compress_ms;
+    r.csr_bytes = (long long)matching::csr_bytes(g);
+    r.compressed_bytes = (long long)cg.bytes();
+    return r;
+}
+
+template <class Arc>
+inline matching::Result solve(const matching::BasicGraph<Arc>& g, const matching::Options& opt = {}) {
+    return solve_with(g, (Workspace<Arc>*)nullptr, opt);
+}
+
+/* solve() in `ws`, left idle for the next graph */
+template <class Arc>
+inline matching::Result solve_in(const matching::BasicGraph<Arc>& g, Workspace<Arc>& ws,
+                                 const matching::Options& opt = {}) {
+    return solve_with(g, &ws, opt);
+}
+
+} // namespace hopcroft_karp
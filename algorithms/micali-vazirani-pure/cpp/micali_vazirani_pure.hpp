@@ -0,0 +1,858 @@
+/*
+ * Micali-Vazirani Pure Algorithm - O(E√V) Maximum Matching
+ *
+ * True MV with DDFS, tenacity, regular + hanging bridges, petal contraction.
+ * Ported from production Jorants MV-Matching-V2.
+ *
+ * MVGraphT is a template over the adjacency: matching::Graph, or
+ * matching::CompressedGraph for --compressed. MIN() and the greedy steps
+ * only walk rows front to back, so both work unchanged. Graph64 and
+ * CompressedGraph64 serve inputs past 2^31 - 1 arcs: predecessor slots
+ * are arc indices and take the graph's arc_type.
+ *
+ * With --epsilon E a phase stops before the search level whose bridges
+ * make paths long enough to guarantee 1 - E of a maximum matching
+ * (solver.hpp, epsilon_path_length), and no further phase runs.
+ *
+ * Built with -DMATCHING_STATS=1 (matching/stats.hpp) it counts phases,
+ * the arcs MIN() scans, DDFS calls, petals, augmentations, and the
+ * bridges MAX() takes up per tenacity bucket: bridges_ten_1,
+ * bridges_ten_3, bridges_ten_5_7, bridges_ten_9_15, ... (tenacities
+ * 2i+1 with i in [2^k, 2^(k+1))). search_ns covers MIN, DDFS, petal
+ * contraction and the reset between phases; augment_ns finding, flipping
+ * and removing the paths.
+ *
+ * The arrays live in a Workspace, which solve_in() keeps for the next
+ * graph (matching/workspace.hpp). The destructor hands it back idle by
+ * undoing the last phase the way reset() would, plus the mates.
+ *
+ * All integers, no hash containers, fully deterministic.
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <memory>
+
+#include "matching/compressed_graph.hpp"
+#include "matching/graph.hpp"
+#include "matching/karp_sipser.hpp"
+#include "matching/solver.hpp"
+#include "matching/stats.hpp"
+#include "matching/warm_start.hpp"
+#include "matching/workspace.hpp"
+
+namespace micali_vazirani_pure {
+
+using matching::NIL;
+
+/* DDFS result codes */
+static const int DDFS_EMPTY = 0;
+static const int DDFS_PETAL = 1;
+static const int DDFS_PATH  = 2;
+
+/* reset() sweeps the touched id range [lo, hi) once more than
+   (hi - lo) / RESET_SWEEP of its vertices were touched */
+static const int RESET_SWEEP = 64;
+
+/* =========================================================================
+ * ListArena — per-phase bump storage for many small FIFO lists
+ *
+ * Cells of every list live in one vector, linked by index; a list is a
+ * (head, tail) pair owned by the caller. clear() is O(1) and keeps the
+ * capacity, so after the first phases nothing is allocated any more.
+ * Cells are addressed by index, never by reference, so a list can grow
+ * while it is being walked.
+ * ========================================================================= */
+template <class T>
+struct ListArena {
+    struct Cell { T value; int next; };
+    std::vector<Cell> cells;
+
+    void clear() { cells.clear(); }
+
+    void push(int& head, int& tail, const T& value) {
+        int c = (int)cells.size();
+        cells.push_back({value, NIL});
+        if (tail == NIL) head = c;
+        else cells[tail].next = c;
+        tail = c;
+    }
+
+    int next(int c) const { return cells[c].next; }
+    const T& value(int c) const { return cells[c].value; }
+};
+
+/* =========================================================================
+ * DDFS result
+ * ========================================================================= */
+struct DDFSResult {
+    std::vector<int> nodes_seen;
+    int bottleneck;
+    DDFSResult() : bottleneck(NIL) {}
+};
+
+/* =========================================================================
+ * Workspace — MVGraphT's arrays, reusable across solves on graphs with
+ * the same arc type. Idle: NIL mates, levels, buds, DDFS marks and list
+ * heads; zero counts and flags; empty arenas and buckets. pred is
+ * written before it is read and has no idle value.
+ * ========================================================================= */
+template <class Arc>
+struct Workspace {
+    std::vector<int> match;
+    std::vector<int> min_level, max_level, even_level, odd_level;
+    std::vector<int> bud, above, below, ddfs_green, ddfs_red;
+    std::vector<int> number_preds, pred_count;
+    std::vector<char> deleted, visited;
+    std::vector<int> pred;
+    ListArena<std::pair<int,Arc>> pred_to;
+    std::vector<int> pred_to_head, pred_to_tail;
+    ListArena<int> hanging;
+    std::vector<int> hanging_head, hanging_tail;
+    ListArena<int> levels;
+    std::vector<int> level_head, level_tail;
+    ListArena<std::pair<int,int>> bridges;
+    std::vector<int> bridge_head, bridge_tail;
+    std::vector<std::pair<int,int>> green_stack, red_stack;
+    std::vector<int> path_found, touched, free_vertices;
+};
+
+/* =========================================================================
+ * MVGraph — the full algorithm
+ *
+ * Per-vertex state is kept as parallel arrays. Each arc is scanned at
+ * most once per phase, so v collects at most degree(v) predecessors;
+ * they sit in CSR-aligned slots pred[adj_start(v) ..]. The lists that
+ * have no such bound (pred_to, hanging bridges, the level and bridge
+ * buckets) are chains in per-phase ListArenas.
+ *
+ * Every vertex whose state a phase changes gets a level first, so
+ * reset() only restores the vertices on `touched` and reseeds level 0
+ * from the shrinking free list: a phase costs what it visits, not O(n).
+ * ========================================================================= */
+template <class Adj>
+struct MVGraphT {
+    using Arc = typename Adj::arc_type;
+    using Csr = matching::BasicGraph<Arc>;
+
+    std::unique_ptr<Workspace<Arc>> own_ws;   /* when the caller lends none */
+    Workspace<Arc>& ws;
+
+    const Adj& graph;                   /* shared adjacency */
+    const Csr& csr;                     /* the same graph as a CSR, for Karp-Sipser and the warm start */
+    int n;
+
+    /* per-vertex state */
+    std::vector<int>& match = ws.match;
+    std::vector<int>& min_level = ws.min_level;
+    std::vector<int>& max_level = ws.max_level;
+    std::vector<int>& even_level = ws.even_level;
+    std::vector<int>& odd_level = ws.odd_level;
+    std::vector<int>& bud = ws.bud;
+    std::vector<int>& above = ws.above;
+    std::vector<int>& below = ws.below;
+    std::vector<int>& ddfs_green = ws.ddfs_green;
+    std::vector<int>& ddfs_red = ws.ddfs_red;
+    std::vector<int>& number_preds = ws.number_preds;   /* predecessors not yet deleted */
+    std::vector<int>& pred_count = ws.pred_count;       /* predecessor slots in use */
+    std::vector<char>& deleted = ws.deleted;
+    std::vector<char>& visited = ws.visited;
+
+    std::vector<int>& pred = ws.pred;   /* pred[adj_start(v) + k]: k-th predecessor of v, NIL once removed */
+    ListArena<std::pair<int,Arc>>& pred_to = ws.pred_to;  /* (target, slot in pred) */
+    std::vector<int>& pred_to_head = ws.pred_to_head;
+    std::vector<int>& pred_to_tail = ws.pred_to_tail;
+    ListArena<int>& hanging = ws.hanging;
+    std::vector<int>& hanging_head = ws.hanging_head;
+    std::vector<int>& hanging_tail = ws.hanging_tail;
+
+    ListArena<int>& levels = ws.levels;
+    std::vector<int>& level_head = ws.level_head;
+    std::vector<int>& level_tail = ws.level_tail;
+    ListArena<std::pair<int,int>>& bridges = ws.bridges;  /* bridges by tenacity bucket */
+    std::vector<int>& bridge_head = ws.bridge_head;
+    std::vector<int>& bridge_tail = ws.bridge_tail;
+
+    std::vector<std::pair<int,int>>& green_stack = ws.green_stack;
+    std::vector<std::pair<int,int>>& red_stack = ws.red_stack;
+    std::vector<int>& path_found = ws.path_found;
+    DDFSResult last_ddfs;
+
+    std::vector<int>& touched = ws.touched;               /* vertices given a level this phase */
+    std::vector<int>& free_vertices = ws.free_vertices;   /* exposed vertices, ascending */
+
+    int matchnum;
+    int bridgenum;
+    int todonum;
+
+    /* --stats=json (stats.hpp); the counters only move under MATCHING_STATS */
+    matching::StageTimes times;
+    int path_limit = INT_MAX;   /* --epsilon: stop before a search level with paths this long */
+    int path_bound = 0;         /* set when it did: no augmenting path is shorter */
+    long long stat_phases = 0, stat_min_arcs = 0, stat_ddfs = 0, stat_petals = 0, stat_paths = 0;
+    std::vector<long long> stat_bridges;   /* by bucket: bit width of the bridge level i */
+
+    explicit MVGraphT(const Csr& g, Workspace<Arc>* w = nullptr) : MVGraphT(g, g, w) {}
+
+    /* `g` encodes the CSR `source`. Binds to *w (grown if needed), or to
+       a workspace of its own. */
+    MVGraphT(const Adj& g, const Csr& source, Workspace<Arc>* w = nullptr)
+        : own_ws(w ? nullptr : new Workspace<Arc>), ws(w ? *w : *own_ws),
+          graph(g), csr(source), n(g.num_vertices()), matchnum(0), bridgenum(0), todonum(0) {
+        MATCHING_STAT_TIMER(times.setup);
+        size_t nv = n;
+        for (auto* a : {&match, &min_level, &max_level, &even_level, &odd_level, &bud, &above, &below,
+                        &ddfs_green, &ddfs_red, &pred_to_head, &pred_to_tail, &hanging_head, &hanging_tail})
+            matching::grow_idle(*a, nv, NIL);
+        matching::grow_idle(number_preds, nv, 0);
+        matching::grow_idle(pred_count, nv, 0);
+        matching::grow_idle(deleted, nv, (char)0);
+        matching::grow_idle(visited, nv, (char)0);
+        if (pred.size() < (size_t)g.num_arcs()) pred.resize((size_t)g.num_arcs());
+        level_head.reserve(n / 2 + 1);
+        level_tail.reserve(n / 2 + 1);
+        bridge_head.reserve(n / 2 + 1);
+        bridge_tail.reserve(n / 2 + 1);
+    }
+
+    /* A lent workspace goes back idle: the last phase and the mates */
+    ~MVGraphT() {
+        if (own_ws) return;
+        clear_phase();
+        std::fill(match.begin(), match.begin() + n, NIL);
+    }
+
+    MVGraphT(const MVGraphT&) = delete;
+    MVGraphT& operator=(const MVGraphT&) = delete;
+
+    void set_min_level(int v, int level) {
+        if (min_level[v] == NIL) touched.push_back(v);
+        min_level[v] = level;
+        if (level % 2) odd_level[v] = level;
+        else even_level[v] = level;
+    }
+
+    void set_max_level(int v, int level) {
+        max_level[v] = level;
+        if (level % 2) odd_level[v] = level;
+        else even_level[v] = level;
+    }
+
+    bool outer(int v) const { return even_level[v] != NIL && (odd_level[v] == NIL || even_level[v] < odd_level[v]); }
+    bool inner(int v) const { return !outer(v); }
+
+    /* Predecessor slots of v: [preds_begin(v), preds_end(v)) */
+    Arc preds_begin(int v) const { return graph.adj_start(v); }
+    Arc preds_end(int v) const { return graph.adj_start(v) + pred_count[v]; }
+
+    /* ---- greedy initialization ---- */
+    int greedy_init() {
+        int cnt = 0;
+        for (int j = 0; j < n; j++) {
+            if (match[j] == NIL) {
+                for (int i : graph.neighbors(j)) {
+                    if (match[i] == NIL) {
+                        match[j] = i;
+                        match[i] = j;
+                        matchnum++;
+                        cnt++;
+                        break;
+                    }
+                }
+            }
+        }
+        return cnt;
+    }
+
+    /* Min-degree greedy: match each exposed vertex with its lowest-degree unmatched neighbor */
+    int greedy_init_md() {
+        int cnt = 0;
+        std::vector<int> order(n);
+        for (int i = 0; i < n; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b){ return graph.degree(a) < graph.degree(b) || (graph.degree(a) == graph.degree(b) && a < b); });
+        for (int j : order) {
+            if (match[j] != NIL) continue;
+            int best = -1, best_deg = INT_MAX;
+            for (int i : graph.neighbors(j)) {
+                if (match[i] == NIL && graph.degree(i) < best_deg) {
+                    best = i; best_deg = graph.degree(i);
+                }
+            }
+            if (best >= 0) {
+                match[j] = best;
+                match[best] = j;
+                matchnum++;
+                cnt++;
+            }
+        }
+        return cnt;
+    }
+
+    /* Karp-Sipser (matching/karp_sipser.hpp) */
+    int karp_sipser_init(int threads) {
+        int cnt = matching::karp_sipser(csr, match, threads);
+        matchnum += cnt;
+        return cnt;
+    }
+
+    /* Prior matching (matching/warm_start.hpp) */
+    int warm_start(const matching::Matching& initial) {
+        int cnt = matching::seed_matching(csr, initial, match);
+        matchnum += cnt;
+        return cnt;
+    }
+
+    /* ---- helpers ---- */
+    void add_to_level(int level, int node) {
+        if (level >= (int)level_head.size()) { level_head.resize(level + 1, NIL); level_tail.resize(level + 1, NIL); }
+        levels.push(level_head[level], level_tail[level], node);
+        todonum++;
+    }
+
+    void add_to_bridges(int level, int n1, int n2) {
+        if (level >= (int)bridge_head.size()) { bridge_head.resize(level + 1, NIL); bridge_tail.resize(level + 1, NIL); }
+        bridges.push(bridge_head[level], bridge_tail[level], {n1, n2});
+        bridgenum++;
+    }
+
+    int tenacity(int n1, int n2) const {
+        if (match[n1] == n2) { /* matched bridge */
+            if (odd_level[n1] != NIL && odd_level[n2] != NIL)
+                return odd_level[n1] + odd_level[n2] + 1;
+        }
+        else { /* unmatched bridge */
+            if (even_level[n1] != NIL && even_level[n2] != NIL)
+                return even_level[n1] + even_level[n2] + 1;
+        }
+        return NIL;
+    }
+
+    int bud_star(int c) const {
+        int b = bud[c];
+        if (b == NIL) return c;
+        return bud_star(b);
+    }
+
+    bool bud_star_includes(int c, int goal) const {
+        if (c == goal) return true;
+        int b = bud[c];
+        if (b == NIL) return false;
+        return bud_star_includes(b, goal);
+    }
+
+    /* ---- reset between phases: only what the last phase touched ---- */
+    void reset() {
+        MATCHING_STAT_TIMER(times.search);
+        clear_phase();
+        seed_free_vertices();
+    }
+
+    /* Back to idle: every vertex the phase touched, and the lists */
+    void clear_phase() {
+        levels.clear();
+        bridges.clear();
+        pred_to.clear();
+        hanging.clear();
+        level_head.clear();     /* add_to_level / add_to_bridges regrow them with NIL */
+        level_tail.clear();
+        bridge_head.clear();
+        bridge_tail.clear();
+        bridgenum = 0;
+        todonum = 0;
+        int lo = n, hi = 0;
+        for (int v : touched) { lo = std::min(lo, v); hi = std::max(hi, v + 1); }
+        if (touched.size() > (size_t)(hi - lo) / RESET_SWEEP) {
+            /* dense: a linear sweep over [lo, hi) beats scattered writes */
+            for (auto* a : {&min_level, &max_level, &even_level, &odd_level, &bud, &above, &below,
+                            &ddfs_green, &ddfs_red, &pred_to_head, &pred_to_tail, &hanging_head, &hanging_tail})
+                std::fill(a->begin() + lo, a->begin() + hi, NIL);
+            std::fill(number_preds.begin() + lo, number_preds.begin() + hi, 0);
+            std::fill(pred_count.begin() + lo, pred_count.begin() + hi, 0);
+            std::fill(deleted.begin() + lo, deleted.begin() + hi, 0);
+            std::fill(visited.begin() + lo, visited.begin() + hi, 0);
+        }
+        else {
+            for (int v : touched) {
+                min_level[v] = max_level[v] = even_level[v] = odd_level[v] = NIL;
+                bud[v] = above[v] = below[v] = ddfs_green[v] = ddfs_red[v] = NIL;
+                pred_to_head[v] = pred_to_tail[v] = hanging_head[v] = hanging_tail[v] = NIL;
+                number_preds[v] = 0;
+                pred_count[v] = 0;
+                deleted[v] = 0;
+                visited[v] = 0;
+            }
+        }
+        touched.clear();
+    }
+
+    /* Level 0: the exposed vertices, dropping those matched since */
+    void seed_free_vertices() {
+        int k = 0;
+        for (int v : free_vertices) {
+            if (match[v] != NIL) continue;
+            free_vertices[k++] = v;
+            add_to_level(0, v);
+            set_min_level(v, 0);
+        }
+        free_vertices.resize(k);
+    }
+
+    /* ---- step_to: core level-building step ---- */
+    void step_to(int to, int from, int level) {
+        level++;
+        int tl = min_level[to];
+        if (tl == NIL || tl >= level) {
+            if (tl != level) {
+                add_to_level(level, to);
+                set_min_level(to, level);
+            }
+            Arc slot = preds_end(to);
+            pred[slot] = from;
+            pred_count[to]++;
+            number_preds[to]++;
+            pred_to.push(pred_to_head[from], pred_to_tail[from], {to, slot});
+        }
+        else {
+            /* found a bridge */
+            int ten = tenacity(to, from);
+            if (ten == NIL) {
+                hanging.push(hanging_head[to], hanging_tail[to], from);
+                hanging.push(hanging_head[from], hanging_tail[from], to);
+            }
+            else {
+                add_to_bridges((ten - 1) / 2, to, from);
+            }
+        }
+    }
+
+    /* ---- MIN phase ---- */
+    void MIN(int i) {
+        MATCHING_STAT_TIMER(times.search);
+        if (i >= (int)level_head.size()) return;
+        for (int k = level_head[i]; k != NIL; k = levels.next(k)) {
+            int current = levels.value(k);
+            todonum--;
+            int m = match[current];
+            if (i % 2 == 0) {
+                MATCHING_STAT(stat_min_arcs += graph.degree(current);)
+                for (int edge : graph.neighbors(current)) {
+                    if (edge != m) step_to(edge, current, i);
+                }
+            }
+            else {
+                if (m != NIL) step_to(m, current, i);
+            }
+        }
+    }
+
+    /* ---- MAX phase ---- */
+    bool MAX(int i) {
+        bool found = false;
+        if (i >= (int)bridge_head.size()) return false;
+
+        for (int j = bridge_head[i]; j != NIL; j = bridges.next(j)) {
+            auto current = bridges.value(j);
+            bridgenum--;
+            int n1 = current.first;
+            int n2 = current.second;
+            MATCHING_STAT(bump_bridges(i);)
+            if (deleted[n1] || deleted[n2]) continue;
+
+            int result = DDFS(n1, n2);
+            if (result == DDFS_EMPTY) continue;
+
+            if (result == DDFS_PATH) {
+                MATCHING_STAT_TIMER(times.augment);
+                MATCHING_STAT(stat_paths++;)
+                find_path(n1, n2);
+                augment_path();
+                if (n / 2 <= matchnum) return true;
+                remove_path();
+                found = true;
+            }
+            else { /* DDFS_PETAL */
+                MATCHING_STAT_TIMER(times.search);
+                MATCHING_STAT(stat_petals++;)
+                int b = last_ddfs.bottleneck;
+                int current_ten = i * 2 + 1;
+                for (int itt : last_ddfs.nodes_seen) {
+                    bud[itt] = b;
+                    set_max_level(itt, current_ten - min_level[itt]);
+                    add_to_level(max_level[itt], itt);
+                    for (int h = hanging_head[itt]; h != NIL; h = hanging.next(h)) {
+                        int other = hanging.value(h);
+                        int hanging_ten = tenacity(itt, other);
+                        if (hanging_ten != NIL)
+                            add_to_bridges((hanging_ten - 1) / 2, itt, other);
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    /* ==================================================================
+     * DDFS — Double Depth-First Search
+     * ================================================================== */
+
+    void add_pred_to_stack(int cur, std::vector<std::pair<int,int>>& stack) {
+        for (Arc k = preds_begin(cur); k < preds_end(cur); k++) {
+            if (pred[k] != NIL) stack.push_back({cur, pred[k]});
+        }
+    }
+
+    void prepare_next(std::pair<int,int>& Nx) {
+        if (Nx.first != NIL) below[Nx.first] = Nx.second;
+        Nx.second = bud_star(Nx.second);
+    }
+
+    static bool edge_valid(const std::pair<int,int>& e) {
+        return !(e.first == NIL && e.second == NIL);
+    }
+
+    static void node_from_stack(std::pair<int,int>& e, std::vector<std::pair<int,int>>& S) {
+        if (!S.empty()) { e = S.back(); S.pop_back(); }
+        else e = {NIL, NIL};
+    }
+
+    int L(const std::pair<int,int>& e) const {
+        int n = bud_star(e.second);
+        return min_level[n];
+    }
+
+    void step_into(int& C, std::pair<int,int>& Nx, std::vector<std::pair<int,int>>& S,
+                   int green_top, int red_top) {
+        prepare_next(Nx);
+        if (!visited[Nx.second]) {
+            above[Nx.second] = Nx.first;
+            C = Nx.second;
+            visited[C] = 1;
+            ddfs_green[C] = green_top;
+            ddfs_red[C] = red_top;
+            last_ddfs.nodes_seen.push_back(C);
+            add_pred_to_stack(C, S);
+        }
+        node_from_stack(Nx, S);
+    }
+
+    int DDFS(int green_top, int red_top) {
+        MATCHING_STAT_TIMER(times.search);
+        MATCHING_STAT(stat_ddfs++;)
+        last_ddfs.nodes_seen.clear();
+        last_ddfs.bottleneck = NIL;
+
+        auto& Sr = red_stack;
+        auto& Sg = green_stack;
+        Sr.clear();
+        Sg.clear();
+
+        int G = NIL, R = NIL;
+
+        if (bud_star(red_top) == bud_star(green_top)) return DDFS_EMPTY;
+        if (min_level[green_top] == 0 && min_level[red_top] == 0)
+            return DDFS_PATH;
+
+        std::pair<int,int> Ng = {NIL, green_top};
+        std::pair<int,int> Nr = {NIL, red_top};
+        std::pair<int,int> red_before = {NIL, NIL};
+        std::pair<int,int> green_before = {NIL, NIL};
+
+        while (R == NIL || G == NIL ||
+               min_level[R] > 0 || min_level[G] > 0) {
+
+            while (edge_valid(Nr) && edge_valid(Ng) && L(Nr) != L(Ng)) {
+
+                while (edge_valid(Nr) && L(Nr) > L(Ng))
+                    step_into(R, Nr, Sr, green_top, red_top);
+
+                if (!edge_valid(Nr)) {
+                    Nr = red_before;
+                    int tmp = red_before.first;
+                    while (above[tmp] != NIL) {
+                        int rc = above[tmp];
+                        for (Arc k = preds_begin(rc); k < preds_end(rc); k++) {
+                            int ri = pred[k];
+                            if (ri == NIL) continue;
+                            if (bud_star(ri) == tmp) { below[rc] = ri; break; }
+                        }
+                        tmp = above[tmp];
+                    }
+                }
+
+                while (edge_valid(Ng) && L(Nr) < L(Ng))
+                    step_into(G, Ng, Sg, green_top, red_top);
+
+                if (!edge_valid(Ng)) {
+                    Ng = green_before;
+                    int tmp = green_before.first;
+                    while (above[tmp] != NIL) {
+                        int rc = above[tmp];
+                        for (Arc k = preds_begin(rc); k < preds_end(rc); k++) {
+                            int ri = pred[k];
+                            if (ri == NIL) continue;
+                            if (bud_star(ri) == tmp) { below[rc] = ri; break; }
+                        }
+                        tmp = above[tmp];
+                    }
+                }
+            }
+
+            if (bud_star(Nr.second) == bud_star(Ng.second)) {
+                if (!Sr.empty()) {
+                    red_before = Nr;
+                    prepare_next(Nr);
+                    node_from_stack(Nr, Sr);
+                    if (edge_valid(Nr)) R = Nr.first;
+                    else Nr = red_before;
+                }
+                else if (!Sg.empty()) {
+                    green_before = Ng;
+                    prepare_next(Ng);
+                    node_from_stack(Ng, Sg);
+                    if (edge_valid(Ng)) G = Ng.first;
+                    else Ng = green_before;
+                }
+                else {
+                    prepare_next(Nr);
+                    prepare_next(Ng);
+                    last_ddfs.bottleneck = Nr.second;
+                    return DDFS_PETAL;
+                }
+            }
+            else {
+                step_into(R, Nr, Sr, green_top, red_top);
+                step_into(G, Ng, Sg, green_top, red_top);
+            }
+        }
+        return DDFS_PATH;
+    }
+
+    /* ==================================================================
+     * Path finding and augmentation
+     * ================================================================== */
+
+    void find_path(int n1, int n2) {
+        path_found.clear();
+        walk_down_path(n1);
+        std::reverse(path_found.begin(), path_found.end());
+        walk_down_path(n2);
+    }
+
+    void walk_down_path(int start) {
+        int cur = start;
+        while (cur != NIL) {
+            if (bud[cur] != NIL) cur = walk_blossom(cur);
+            else { path_found.push_back(cur); cur = below[cur]; }
+        }
+    }
+
+    int jump_bridge(int cur) {
+        if (ddfs_green[cur] == cur) return ddfs_red[cur];
+        if (ddfs_red[cur] == cur) return ddfs_green[cur];
+        if (bud_star_includes(ddfs_green[cur], cur)) {
+            size_t before = path_found.size();
+            int b = ddfs_green[cur];
+            while (b != cur) b = walk_blossom(b);
+            std::reverse(path_found.begin() + before, path_found.end());
+            return ddfs_red[cur];
+        }
+        else {
+            size_t before = path_found.size();
+            int b = ddfs_red[cur];
+            while (b != cur) b = walk_blossom(b);
+            std::reverse(path_found.begin() + before, path_found.end());
+            return ddfs_green[cur];
+        }
+    }
+
+    int walk_blossom(int cur) {
+        if (outer(cur)) {
+            cur = walk_blossom_down(cur, NIL);
+        }
+        else {
+            cur = walk_blossom_up(cur);
+            int before = cur;
+            cur = jump_bridge(cur);
+            cur = walk_blossom_down(cur, before);
+        }
+        return cur;
+    }
+
+    int walk_blossom_down(int cur, int before) {
+        if (before == NIL) before = cur;
+        int b = bud[cur];
+        while (cur != NIL && cur != b) {
+            if (ddfs_green[cur] != ddfs_green[before] ||
+                ddfs_red[cur] != ddfs_red[before])
+                cur = walk_blossom(cur);
+            else { path_found.push_back(cur); cur = below[cur]; }
+        }
+        return cur;
+    }
+
+    int walk_blossom_up(int cur) {
+        while (true) {
+            path_found.push_back(cur);
+            if (above[cur] == NIL) break;
+            int b = below[above[cur]];
+            if (b != cur && bud_star_includes(b, cur)) {
+                size_t before = path_found.size();
+                while (b != cur) b = walk_blossom(b);
+                std::reverse(path_found.begin() + before, path_found.end());
+            }
+            cur = above[cur];
+        }
+        return cur;
+    }
+
+    void augment_path() {
+        for (size_t i = 0; i + 1 < path_found.size(); i += 2) {
+            int n1 = path_found[i];
+            int n2 = path_found[i + 1];
+            match[n1] = n2;
+            match[n2] = n1;
+        }
+        matchnum++;
+    }
+
+    void remove_path() {
+        while (!path_found.empty()) {
+            int current = path_found.back();
+            path_found.pop_back();
+            if (!deleted[current]) {
+                deleted[current] = 1;
+                for (int c = pred_to_head[current]; c != NIL; c = pred_to.next(c)) {
+                    int target = pred_to.value(c).first;
+                    if (!deleted[target]) {
+                        pred[pred_to.value(c).second] = NIL;
+                        number_preds[target]--;
+                        if (number_preds[target] <= 0) path_found.push_back(target);
+                    }
+                }
+            }
+        }
+    }
+
+    /* ---- main matching driver ---- */
+    void max_match() {
+        free_vertices.clear();
+        for (int i = 0; i < n; i++)
+            if (match[i] == NIL) free_vertices.push_back(i);
+        seed_free_vertices();
+        bool found = max_match_phase();
+        while (n / 2 > matchnum && found) {
+            reset();
+            found = max_match_phase();
+        }
+    }
+
+    bool max_match_phase() {
+        MATCHING_STAT(stat_phases++;)
+        bool found = false;
+        for (int i = 0; i < n / 2 + 1 && !found; i++) {
+            if (todonum <= 0 && bridgenum <= 0) return false;
+            /* MAX(i) takes the bridges of tenacity 2i + 1: every shorter
+               path would have been found at an earlier level */
+            if (2 * i + 1 >= path_limit) { path_bound = 2 * i + 1; return false; }
+            MIN(i);
+            found = MAX(i);
+        }
+        return found;
+    }
+
+    void bump_bridges(int i) {
+        size_t b = 0;
+        while ((i >> b) != 0) b++;
+        if (b >= stat_bridges.size()) stat_bridges.resize(b + 1, 0);
+        stat_bridges[b]++;
+    }
+
+    /* Counters and stage times for --stats=json */
+    matching::Stats collect_stats() const {
+        matching::Stats st;
+        st.add("phases", stat_phases);
+        st.add("min_arcs", stat_min_arcs);
+        st.add("ddfs_calls", stat_ddfs);
+        st.add("petals", stat_petals);
+        st.add("augmentations", stat_paths);
+        for (size_t b = 0; b < stat_bridges.size(); b++) {
+            /* levels [2^(b-1), 2^b), bucket 0 is level 0 */
+            long long lo = b == 0 ? 0 : 1LL << (b - 1), hi = b == 0 ? 0 : (1LL << b) - 1;
+            char name[64];
+            if (lo == hi) snprintf(name, sizeof name, "bridges_ten_%lld", 2 * lo + 1);
+            else snprintf(name, sizeof name, "bridges_ten_%lld_%lld", 2 * lo + 1, 2 * hi + 1);
+            st.add(name, stat_bridges[b]);
+        }
+        times.add_to(st);
+        return st;
+    }
+
+    std::vector<std::pair<int,int>> get_matching() const {
+        std::vector<std::pair<int,int>> result;
+        for (int i = 0; i < n; i++) {
+            if (match[i] != NIL && match[i] > i)
+                result.push_back({i, match[i]});
+        }
+        return result;
+    }
+};
+
+using MVGraph = MVGraphT<matching::Graph>;
+
+template <class Adj>
+inline matching::Result run(MVGraphT<Adj>& mv, const matching::Options& opt) {
+    matching::Result r;
+    {
+        MATCHING_STAT_TIMER(mv.times.init);
+        if (opt.initial) r.initial_size = mv.warm_start(*opt.initial);
+        auto t0 = std::chrono::steady_clock::now();
+        if (opt.greedy_mode == matching::GREEDY_FIRST) r.greedy_size = mv.greedy_init();
+        else if (opt.greedy_mode == matching::GREEDY_MIN_DEGREE) r.greedy_size = mv.greedy_init_md();
+        else if (opt.greedy_mode == matching::GREEDY_KARP_SIPSER) r.greedy_size = mv.karp_sipser_init(matching::init_threads(opt));
+        r.greedy_ms = matching::ms_since(t0);
+    }
+    mv.path_limit = matching::epsilon_path_length(opt.epsilon);
+    mv.max_match();
+    r.matching = mv.get_matching();
+    r.path_bound = mv.path_bound;
+    MATCHING_STAT(r.stats = mv.collect_stats();)
+    return r;
+}
+
+/* With opt.compressed, g is gap-encoded first; Karp-Sipser and the warm
+   start still read g. Arc is int, or int64_t for matching::Graph64. */
+template <class Arc>
+inline matching::Result solve_with(const matching::BasicGraph<Arc>& g, Workspace<Arc>* ws,
+                                   const matching::Options& opt) {
+    if (!opt.compressed) {
+        MVGraphT<matching::BasicGraph<Arc>> mv(g, ws);
+        return run(mv, opt);
+    }
+    using Compressed = matching::BasicCompressedGraph<Arc>;
+    auto t0 = std::chrono::steady_clock::now();
+    Compressed cg = Compressed::compress(g, opt.threads, matching::resolve_decode(opt.scan));
+    double compress_ms = matching::ms_since(t0);
+    MVGraphT<Compressed> mv(cg, g, ws);
+    matching::Result r = run(mv, opt);
+    r.compress_ms = compress_ms;
+    r.csr_bytes = (long long)matching::csr_bytes(g);
+    r.compressed_bytes = (long long)cg.bytes();
+    return r;
+}
+
+template <class Arc>
+inline matching::Result solve(const matching::BasicGraph<Arc>& g, const matching::Options& opt = {}) {
+    return solve_with(g, (Workspace<Arc>*)nullptr, opt);
+}
+
+/* solve() in `ws`, left idle for the next graph */
+template <class Arc>
+inline matching::Result solve_in(const matching::BasicGraph<Arc>& g, Workspace<Arc>& ws,
+                                 const matching::Options& opt = {}) {
+    return solve_with(g, &ws, opt);
+}
+
+} // namespace micali_vazirani_pure
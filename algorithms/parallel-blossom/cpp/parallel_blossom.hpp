@@ -0,0 +1,450 @@
+/*
+ * Parallel Blossom Search - Multi-Tree Maximum Matching on General Graphs
+ *
+ * Edmonds' algorithm with one alternating tree per free vertex, grown by
+ * many threads at once. A round hands the free vertices out in chunks,
+ * and each thread grows a BFS tree from its root with the blossom
+ * machinery of gabow_simple: virtual contraction by a union-find on
+ * bases, interleaved LCA, and bridges to trace paths through blossoms.
+ *
+ * Every vertex a tree touches is first claimed by CAS on its owner token,
+ * as Pothen-Fan does for bipartite graphs (Azad et al., 2012). A tree
+ * thus owns each vertex it has labeled and augments at once, without
+ * locks. A vertex is claimed by one tree per round at most, so the paths
+ * of a round are vertex-disjoint.
+ *
+ * A tree that reaches a vertex another tree owns backs off: it leaves
+ * that edge alone and goes on. It then ends in one of three ways:
+ *
+ *   augmented  it reached a free vertex
+ *   exhausted  no path and nothing skipped: a Hungarian tree. No later
+ *              augmenting path can pass through it (Edmonds), so its
+ *              vertices are retired for good and later trees ignore them
+ *   blocked    no path, but an edge was skipped: the root tries again in
+ *              the next round
+ *
+ * Rounds repeat while they augment. A round that finds no path leaves
+ * blocked roots only. These are then searched one at a time, each in a
+ * fresh round with the graph to itself, until one augments (back to
+ * parallel rounds) or all are exhausted. The result is a maximum
+ * matching for any thread count.
+ *
+ * A blossom never spans two trees, since all its vertices belong to the
+ * tree that shrank it. The union-find (path-halving find_base), parents,
+ * labels and LCA tags are therefore written by one thread only and need
+ * no atomics. The owner tokens are the only shared state. A claim resets
+ * the vertex's search state, so a round costs what its trees visit.
+ *
+ * With one thread, or `deterministic`, the rounds run serially and the
+ * matching is reproducible. With more, the size is the same but which
+ * maximum matching is returned can vary between runs.
+ *
+ * Complexity: O(V E) worst case, as for one search per root.
+ *
+ * Built with -DMATCHING_STATS=1 (matching/stats.hpp) it counts rounds,
+ * trees grown, arcs scanned, blossoms shrunk, augmentations, blocked
+ * trees, and the solo searches after rounds without a path. search_ns
+ * covers the rounds, whose trees augment as they go.
+ *
+ * All integers, no hash containers; the serial run is fully deterministic.
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+
+#include "matching/graph.hpp"
+#include "matching/karp_sipser.hpp"
+#include "matching/parallel.hpp"
+#include "matching/solver.hpp"
+#include "matching/stats.hpp"
+#include "matching/warm_start.hpp"
+
+namespace parallel_blossom {
+
+using matching::NIL;
+static const int UNLABELED = 0;
+static const int EVEN = 1;
+static const int ODD = 2;
+
+/* Owner token of a vertex in an exhausted tree */
+static const long long RETIRED = LLONG_MAX;
+
+/* How a tree ended */
+static const int TREE_AUGMENTED = 0;
+static const int TREE_EXHAUSTED = 1;   /* no augmenting path from the root */
+static const int TREE_BLOCKED = 2;     /* no path found, but an edge was skipped */
+static const int TREE_GONE = 3;        /* the root was matched by another tree */
+
+struct ParallelBlossom {
+    int n;
+    int greedy_size = 0;
+    double greedy_ms = 0;
+    int init_threads = 1;   /* threads for the Karp-Sipser initializer */
+    int threads;
+    const matching::Graph& graph;
+    std::vector<int> mate;         /* read and written only by the tree owning the vertex */
+
+    /* Ownership: the token of the tree that claimed the vertex. Tokens
+       are never reused; those >= round_first belong to the current round,
+       RETIRED to none. */
+    std::unique_ptr<std::atomic<long long>[]> owner;
+    std::atomic<long long> next_token{1};
+    long long round_first = 1;
+
+    /* Search state, written only by the owning tree (see gabow_simple) */
+    std::vector<int> base;
+    std::vector<int> parent;       /* EVEN v: the ODD vertex it entered through;
+                                      ODD v: the EVEN vertex that found it */
+    std::vector<int> label;        /* UNLABELED / EVEN / ODD */
+    std::vector<int> bridge_src;   /* ODD vertex absorbed into a blossom: */
+    std::vector<int> bridge_tgt;   /* the edge that closed it */
+    std::vector<size_t> lca_tag1, lca_tag2;
+
+    /* Per-thread scratch */
+    struct Frame { int v, u, phase, sb, tb; };
+    struct Worker {
+        long long token = 0;       /* the tree being grown */
+        size_t lca_epoch = 0;
+        std::vector<int> queue;
+        std::vector<int> claimed;  /* vertices the tree owns */
+        std::vector<std::pair<int,int>> pairs;
+        std::vector<Frame> frames;
+        long long stat_arcs = 0, stat_blossoms = 0;
+    };
+    std::vector<Worker> workers;
+    std::unique_ptr<matching::ThreadPool> pool;
+
+    static const int ROUND_GRAIN = 256;   /* roots below which a round runs serially */
+    static const int ROUND_CHUNK = 16;    /* roots taken per grab */
+
+    /* --stats=json (stats.hpp); the counters only move under MATCHING_STATS */
+    matching::StageTimes times;
+    long long stat_rounds = 0, stat_trees = 0, stat_paths = 0, stat_blocked = 0, stat_solo = 0;
+
+    ParallelBlossom(const matching::Graph& g, int num_threads = 1, bool deterministic = false)
+        : n(g.num_vertices()), threads(deterministic ? 1 : matching::resolve_threads(num_threads)),
+          graph(g) {
+        MATCHING_STAT_TIMER(times.setup);
+        size_t nv = n > 0 ? n : 1;
+        mate.assign(n, NIL);
+        owner.reset(new std::atomic<long long>[nv]);
+        for (size_t v = 0; v < nv; v++) owner[v].store(0, std::memory_order_relaxed);
+        base.resize(n);
+        parent.resize(n);
+        label.resize(n);
+        bridge_src.resize(n);
+        bridge_tgt.resize(n);
+        lca_tag1.assign(n, 0);
+        lca_tag2.assign(n, 0);
+    }
+
+    /* ---- greedy initial matchings (same rules as gabow_simple) ---- */
+
+    int greedy_init() {
+        int cnt = 0;
+        for (int u = 0; u < n; u++) {
+            if (mate[u] != NIL) continue;
+            for (int v : graph.neighbors(u)) {
+                if (mate[v] == NIL) { mate[u] = v; mate[v] = u; cnt++; break; }
+            }
+        }
+        return cnt;
+    }
+
+    int greedy_init_md() {
+        int cnt = 0;
+        std::vector<int> deg(n, 0);
+        for (int u = 0; u < n; u++)
+            for (int v : graph.neighbors(u))
+                deg[v]++;
+        std::vector<int> order(n);
+        for (int i = 0; i < n; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b){ return deg[a] < deg[b] || (deg[a] == deg[b] && a < b); });
+        for (int u : order) {
+            if (mate[u] != NIL) continue;
+            int best = -1, best_deg = INT_MAX;
+            for (int v : graph.neighbors(u)) {
+                if (mate[v] == NIL && deg[v] < best_deg) {
+                    best = v; best_deg = deg[v];
+                }
+            }
+            if (best >= 0) { mate[u] = best; mate[best] = u; cnt++; }
+        }
+        return cnt;
+    }
+
+    /* ---- ownership ---- */
+
+    /* True if v belongs to w's tree, claiming it (and resetting its search
+       state) when no tree of this round has it yet */
+    bool own(int v, Worker& w) {
+        long long old = owner[v].load(std::memory_order_relaxed);
+        if (old == w.token) return true;
+        if (old >= round_first) return false;
+        if (!owner[v].compare_exchange_strong(old, w.token, std::memory_order_relaxed)) return false;
+        w.claimed.push_back(v);
+        base[v] = v;
+        parent[v] = NIL;
+        label[v] = UNLABELED;
+        bridge_src[v] = bridge_tgt[v] = NIL;
+        lca_tag1[v] = lca_tag2[v] = 0;
+        return true;
+    }
+
+    /* ---- blossom machinery (gabow_simple, on one tree) ---- */
+
+    int find_base(int v) {
+        while (base[v] != v) {
+            base[v] = base[base[v]];
+            v = base[v];
+        }
+        return v;
+    }
+
+    /* Interleaved LCA of two vertices of the same tree */
+    int find_lca(int u, int v, Worker& w) {
+        size_t ep = ++w.lca_epoch;
+        int hx = find_base(u), hy = find_base(v);
+        lca_tag1[hx] = ep;
+        lca_tag2[hy] = ep;
+        while (true) {
+            if (lca_tag1[hy] == ep) return hy;
+            if (lca_tag2[hx] == ep) return hx;
+            if (mate[hx] != NIL) {
+                hx = find_base(parent[mate[hx]]);
+                lca_tag1[hx] = ep;
+            }
+            if (mate[hy] != NIL) {
+                hy = find_base(parent[mate[hy]]);
+                lca_tag2[hy] = ep;
+            }
+        }
+    }
+
+    /* Walk from x back to lca, merging bases; ODD vertices on the way
+       record the bridge (x, y) and become EVEN */
+    void shrink_path(int lca, int x, int y, std::vector<int>& queue) {
+        int v = find_base(x);
+        while (v != lca) {
+            int mv = mate[v];
+            base[find_base(v)] = lca;
+            base[find_base(mv)] = lca;
+            base[lca] = lca;
+            bridge_src[mv] = x;
+            bridge_tgt[mv] = y;
+            if (label[mv] != EVEN) {
+                label[mv] = EVEN;
+                queue.push_back(mv);
+            }
+            v = find_base(parent[mv]);
+        }
+    }
+
+    /* Path edges from v to u (to the root if u == NIL), through bridges */
+    void trace_path(int v, int u, Worker& w) {
+        auto& stk = w.frames;
+        stk.clear();
+        stk.push_back({v, u, 0, 0, 0});
+        while (!stk.empty()) {
+            auto& f = stk.back();
+            if (f.v == f.u) { stk.pop_back(); continue; }
+            if (f.phase == 0) {
+                if (bridge_src[f.v] == NIL) {
+                    if (mate[f.v] == NIL) { stk.pop_back(); continue; }   /* the root */
+                    int mv = mate[f.v];
+                    int pmv = parent[mv];
+                    w.pairs.push_back({mv, pmv});
+                    f.v = pmv;
+                    continue;
+                }
+                f.sb = bridge_src[f.v];
+                f.tb = bridge_tgt[f.v];
+                f.phase = 1;
+                stk.push_back({f.sb, mate[f.v], 0, 0, 0});
+                continue;
+            }
+            if (f.phase == 1) {
+                w.pairs.push_back({f.sb, f.tb});
+                f.phase = 2;
+                stk.push_back({f.tb, f.u, 0, 0, 0});
+                continue;
+            }
+            stk.pop_back();
+        }
+    }
+
+    /* EVEN u found the free vertex v: flip root ~~~ u - v */
+    void augment(int u, int v, Worker& w) {
+        w.pairs.clear();
+        w.pairs.push_back({u, v});
+        trace_path(u, NIL, w);
+        for (auto& [a, b] : w.pairs) {
+            mate[a] = b;
+            mate[b] = a;
+        }
+    }
+
+    /* ---- one tree ---- */
+
+    /* v is owned by a live tree of this round, not retired */
+    bool taken(int v) const { return owner[v].load(std::memory_order_relaxed) != RETIRED; }
+
+    /* BFS tree from `root` on the vertices w can own; TREE_* outcome */
+    int grow(int root, Worker& w) {
+        w.token = next_token.fetch_add(1, std::memory_order_relaxed);
+        w.claimed.clear();
+        if (!own(root, w)) return taken(root) ? TREE_BLOCKED : TREE_EXHAUSTED;
+        if (mate[root] != NIL) return TREE_GONE;
+        label[root] = EVEN;
+        w.queue.clear();
+        w.queue.push_back(root);
+        bool skipped = false;
+        for (size_t qh = 0; qh < w.queue.size(); qh++) {
+            int u = w.queue[qh];
+            if (label[find_base(u)] != EVEN) continue;
+            MATCHING_STAT(w.stat_arcs += graph.degree(u);)
+            for (int v : graph.neighbors(u)) {
+                if (v == mate[u]) continue;
+                if (!own(v, w)) { skipped |= taken(v); continue; }   /* another tree's: back off */
+                int bu = find_base(u), bv = find_base(v);
+                if (bu == bv) continue;
+                if (label[bv] == UNLABELED) {
+                    int x = mate[v];
+                    if (x == NIL) { augment(u, v, w); return TREE_AUGMENTED; }
+                    if (!own(x, w)) { skipped |= taken(x); continue; }
+                    label[v] = ODD;
+                    parent[v] = u;
+                    label[x] = EVEN;
+                    w.queue.push_back(x);
+                } else if (label[bv] == EVEN) {
+                    MATCHING_STAT(w.stat_blossoms++;)
+                    int lca = find_lca(u, v, w);
+                    shrink_path(lca, u, v, w.queue);
+                    shrink_path(lca, v, u, w.queue);
+                }
+                /* ODD: ignore */
+            }
+        }
+        if (skipped) return TREE_BLOCKED;
+        for (int v : w.claimed) owner[v].store(RETIRED, std::memory_order_relaxed);
+        return TREE_EXHAUSTED;
+    }
+
+    /* ---- rounds ---- */
+
+    /* One tree from every root; keeps the blocked roots (in order) and
+       returns the number of augmentations */
+    int run_round(std::vector<int>& roots, std::vector<char>& outcome) {
+        MATCHING_STAT(stat_rounds++; stat_trees += (long long)roots.size();)
+        round_first = next_token.load(std::memory_order_relaxed);
+        size_t count = roots.size();
+        outcome.assign(count, TREE_GONE);
+        if (!pool || (int)count < ROUND_GRAIN) {
+            for (size_t i = 0; i < count; i++) outcome[i] = (char)grow(roots[i], workers[0]);
+        } else {
+            std::atomic<size_t> next(0);
+            pool->run([&](int t) {
+                for (;;) {
+                    size_t lo = next.fetch_add(ROUND_CHUNK, std::memory_order_relaxed);
+                    if (lo >= count) break;
+                    size_t hi = std::min(count, lo + (size_t)ROUND_CHUNK);
+                    for (size_t i = lo; i < hi; i++) outcome[i] = (char)grow(roots[i], workers[t]);
+                }
+            });
+        }
+        int paths = 0;
+        size_t k = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (outcome[i] == TREE_AUGMENTED) paths++;
+            else if (outcome[i] == TREE_BLOCKED) roots[k++] = roots[i];
+        }
+        MATCHING_STAT(stat_paths += paths; stat_blocked += (long long)k;)
+        roots.resize(k);
+        return paths;
+    }
+
+    /* After a round without a path: search the blocked roots one at a
+       time, each with the graph to itself, until one augments. Drops the
+       roots searched. */
+    void run_solo(std::vector<int>& roots) {
+        size_t i = 0;
+        while (i < roots.size()) {
+            MATCHING_STAT(stat_solo++;)
+            round_first = next_token.load(std::memory_order_relaxed);
+            int res = grow(roots[i++], workers[0]);
+            if (res == TREE_AUGMENTED) {
+                MATCHING_STAT(stat_paths++;)
+                break;
+            }
+        }
+        roots.erase(roots.begin(), roots.begin() + i);
+    }
+
+    std::vector<std::pair<int,int>> maximum_matching(int greedy_mode = 0) {
+        int greedy_count = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            MATCHING_STAT_TIMER(times.init);
+            if (greedy_mode == 1) greedy_count = greedy_init();
+            else if (greedy_mode == 2) greedy_count = greedy_init_md();
+            else if (greedy_mode == matching::GREEDY_KARP_SIPSER) greedy_count = matching::karp_sipser(graph, mate, init_threads);
+        }
+        greedy_size = greedy_count;
+        greedy_ms = matching::ms_since(t0);
+
+        {
+            MATCHING_STAT_TIMER(times.search);
+            if (threads > 1) pool.reset(new matching::ThreadPool(threads));
+            workers.assign(pool ? pool->size() : 1, Worker());
+            std::vector<int> roots;
+            for (int v = 0; v < n; v++)
+                if (mate[v] == NIL && graph.degree(v) > 0) roots.push_back(v);
+            std::vector<char> outcome;
+            while (!roots.empty())
+                if (run_round(roots, outcome) == 0) run_solo(roots);
+        }
+
+        std::vector<std::pair<int,int>> matching;
+        for (int u = 0; u < n; u++)
+            if (mate[u] != NIL && mate[u] > u)
+                matching.push_back({u, mate[u]});
+        return matching;
+    }
+
+    /* Counters and stage times for --stats=json */
+    matching::Stats collect_stats() const {
+        matching::Stats st;
+        long long arcs = 0, blossoms = 0;
+        for (const Worker& w : workers) { arcs += w.stat_arcs; blossoms += w.stat_blossoms; }
+        st.add("rounds", stat_rounds);
+        st.add("trees", stat_trees);
+        st.add("arcs", arcs);
+        st.add("blossoms", blossoms);
+        st.add("augmentations", stat_paths);
+        st.add("blocked", stat_blocked);
+        st.add("solo_searches", stat_solo);
+        times.add_to(st);
+        return st;
+    }
+};
+
+inline matching::Result solve(const matching::Graph& g, const matching::Options& opt = {}) {
+    ParallelBlossom pb(g, matching::solve_threads(opt), opt.deterministic);
+    pb.init_threads = matching::init_threads(opt);
+    matching::Result r;
+    if (opt.initial) {
+        MATCHING_STAT_TIMER(pb.times.init);
+        r.initial_size = matching::seed_matching(g, *opt.initial, pb.mate);
+    }
+    r.matching = pb.maximum_matching(opt.greedy_mode);
+    r.greedy_size = pb.greedy_size;
+    r.greedy_ms = pb.greedy_ms;
+    MATCHING_STAT(r.stats = pb.collect_stats();)
+    return r;
+}
+
+} // namespace parallel_blossom
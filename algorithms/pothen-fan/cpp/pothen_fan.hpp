@@ -0,0 +1,254 @@
+/*
+ * Pothen-Fan (PF+) Algorithm - Maximum Bipartite Matching by DFS with lookahead
+ *
+ * Each phase runs one DFS from every free left vertex. A right vertex is
+ * visited at most once per phase, so the augmenting paths found in a
+ * phase are vertex-disjoint. Unlike Hopcroft-Karp, there is no BFS and the
+ * paths need not be shortest. Two refinements from Duff, Kaya and Ucar
+ * (2011) make it fast in practice:
+ *
+ *   lookahead  on entering a left vertex, first scan its list for a free
+ *              right neighbor. The scan pointer only moves forward across
+ *              phases, because a matched right vertex stays matched.
+ *   fairness   the DFS scans adjacency lists forwards in odd phases and
+ *              backwards in even ones.
+ *
+ * Phases repeat until one finds no augmenting path. Worst case O(VE).
+ *
+ * With more than one thread, free vertices are shared out dynamically and
+ * every search claims the right vertices it visits with CAS on a
+ * per-phase stamp (Azad et al., 2012). A search then owns each vertex of
+ * its tree and augments at once. The size is the same; the matching
+ * itself may vary between parallel runs. `deterministic` keeps the serial
+ * search.
+ *
+ * All integers, no hash containers; the serial run is fully deterministic.
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+
+#include "matching/graph.hpp"
+#include "matching/karp_sipser.hpp"
+#include "matching/parallel.hpp"
+#include "matching/solver.hpp"
+#include "matching/warm_start.hpp"
+
+namespace pothen_fan {
+
+using matching::NIL;
+
+struct PothenFan {
+    const matching::Graph& graph; /* graph.neighbors(u) = right nodes of left u */
+    int left_count;
+    int right_count;
+    int greedy_size = 0;
+    double greedy_ms = 0;
+    int threads;
+    std::vector<int> pair_left;
+    std::unique_ptr<std::atomic<int>[]> pair_right;   /* written only by the search owning the vertex */
+    std::unique_ptr<std::atomic<int>[]> visited;      /* phase that claimed the right vertex */
+    std::vector<int> lookahead;                       /* next arc to check for a free neighbor */
+
+    std::unique_ptr<matching::ThreadPool> pool;
+    std::vector<int> roots;                           /* free left vertices of this phase */
+    struct SearchStack { std::vector<int> vertex, next; };
+    std::vector<SearchStack> stacks;                  /* per thread */
+
+    static const int PF_GRAIN = 256;    /* free vertices below which a phase runs serially */
+    static const int PF_CHUNK = 64;     /* free vertices taken per grab */
+
+    PothenFan(const matching::Graph& g, int num_threads = 1, bool deterministic = false)
+        : graph(g), left_count(g.num_vertices()), right_count(g.num_right()),
+          threads(deterministic ? 1 : matching::resolve_threads(num_threads)) {
+        size_t nr = right_count > 0 ? right_count : 1;
+        pair_left.assign(left_count, NIL);
+        pair_right.reset(new std::atomic<int>[nr]);
+        visited.reset(new std::atomic<int>[nr]);
+        for (size_t v = 0; v < nr; v++) { pair_right[v].store(NIL); visited[v].store(0); }
+        lookahead.assign(graph.offsets(), graph.offsets() + left_count);
+    }
+
+    int mate(int v) const { return pair_right[v].load(std::memory_order_relaxed); }
+    void match(int u, int v) { pair_left[u] = v; pair_right[v].store(u, std::memory_order_relaxed); }
+
+    /* ---- greedy initial matchings (same rules as Hopcroft-Karp) ---- */
+
+    /* Greedy initial matching: iterate left vertices, pick first available right neighbor */
+    int greedy_init() {
+        int cnt = 0;
+        for (int u = 0; u < left_count; u++) {
+            if (pair_left[u] != NIL) continue;
+            for (int v : graph.neighbors(u)) {
+                if (mate(v) == NIL) { match(u, v); cnt++; break; }
+            }
+        }
+        return cnt;
+    }
+
+    /* Min-degree greedy: match each exposed left vertex with its lowest-degree unmatched right neighbor */
+    int greedy_init_md() {
+        int cnt = 0;
+        std::vector<int> deg(right_count, 0);
+        for (int u = 0; u < left_count; u++)
+            for (int v : graph.neighbors(u))
+                deg[v]++;
+        std::vector<int> order(left_count);
+        for (int i = 0; i < left_count; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b){
+            return graph.degree(a) < graph.degree(b) ||
+                   (graph.degree(a) == graph.degree(b) && a < b);
+        });
+        for (int u : order) {
+            if (pair_left[u] != NIL) continue;
+            int best = -1, best_deg = INT_MAX;
+            for (int v : graph.neighbors(u)) {
+                if (mate(v) == NIL && deg[v] < best_deg) {
+                    best = v; best_deg = deg[v];
+                }
+            }
+            if (best >= 0) { match(u, best); cnt++; }
+        }
+        return cnt;
+    }
+
+    /* Karp-Sipser (matching/karp_sipser.hpp) on plain copies of the mates */
+    int karp_sipser_init() {
+        std::vector<int> right(right_count);
+        for (int v = 0; v < right_count; v++) right[v] = mate(v);
+        int cnt = matching::karp_sipser_bipartite(graph, pair_left, right, threads);
+        for (int v = 0; v < right_count; v++) pair_right[v].store(right[v], std::memory_order_relaxed);
+        return cnt;
+    }
+
+    /* Prior matching (matching/warm_start.hpp), seeded like karp_sipser_init */
+    int warm_start(const matching::Matching& initial) {
+        std::vector<int> right(right_count);
+        for (int v = 0; v < right_count; v++) right[v] = mate(v);
+        int cnt = matching::seed_matching(graph, initial, pair_left, right);
+        for (int v = 0; v < right_count; v++) pair_right[v].store(right[v], std::memory_order_relaxed);
+        return cnt;
+    }
+
+    /* ---- DFS with lookahead ---- */
+
+    static bool claim(std::atomic<int>& slot, int stamp) {
+        int old = slot.load(std::memory_order_relaxed);
+        return old != stamp && slot.compare_exchange_strong(old, stamp, std::memory_order_relaxed);
+    }
+
+    /* k-th arc of x in this phase's scan direction */
+    int arc(int x, int k, bool forward) const {
+        return forward ? graph.adj_start(x) + k : graph.adj_start(x + 1) - 1 - k;
+    }
+
+    /* Claim the next free right neighbor of x, or NIL. A free vertex that
+       is already claimed gets matched by its claimer, so it is skipped for good. */
+    int look_ahead(int x, int stamp) {
+        const int* adj = graph.targets();
+        int end = graph.adj_start(x + 1);
+        for (int& a = lookahead[x]; a < end; a++) {
+            int v = adj[a];
+            if (mate(v) == NIL && claim(visited[v], stamp)) { a++; return v; }
+        }
+        return NIL;
+    }
+
+    /* Flip the path on the stack, ending at the free right vertex `last` */
+    void augment(const SearchStack& st, int last, bool forward) {
+        const int* adj = graph.targets();
+        int top = (int)st.vertex.size() - 1;
+        match(st.vertex[top], last);
+        for (int i = top - 1; i >= 0; i--)
+            match(st.vertex[i], adj[arc(st.vertex[i], st.next[i] - 1, forward)]);
+    }
+
+    /* Iterative DFS from free left `root`; next[i] is the next arc index
+       of the i-th stack vertex, so the arc taken down is next[i] - 1 */
+    bool search(int root, int stamp, bool forward, SearchStack& st) {
+        const int* adj = graph.targets();
+        st.vertex.assign(1, root);
+        st.next.assign(1, 0);
+        int f = look_ahead(root, stamp);
+        if (f != NIL) { augment(st, f, forward); return true; }
+        while (!st.vertex.empty()) {
+            int x = st.vertex.back();
+            int& k = st.next.back();
+            if (k == graph.degree(x)) { st.vertex.pop_back(); st.next.pop_back(); continue; }
+            int v = adj[arc(x, k++, forward)];
+            if (!claim(visited[v], stamp)) continue;
+            int w = mate(v);
+            if (w == NIL) { augment(st, v, forward); return true; }
+            st.vertex.push_back(w);
+            st.next.push_back(0);
+            f = look_ahead(w, stamp);
+            if (f != NIL) { augment(st, f, forward); return true; }
+        }
+        return false;
+    }
+
+    /* One DFS from every free left vertex; true if any augmented */
+    bool run_phase(int stamp) {
+        bool forward = stamp & 1;
+        roots.clear();
+        for (int u = 0; u < left_count; u++)
+            if (pair_left[u] == NIL) roots.push_back(u);
+
+        size_t n = roots.size();
+        if (threads <= 1 || (int)n < PF_GRAIN) {
+            bool any = false;
+            for (int u : roots) any |= search(u, stamp, forward, stacks[0]);
+            return any;
+        }
+        std::atomic<size_t> next(0);
+        std::atomic<bool> any(false);
+        pool->run([&](int t) {
+            bool found = false;
+            for (;;) {
+                size_t lo = next.fetch_add(PF_CHUNK, std::memory_order_relaxed);
+                if (lo >= n) break;
+                size_t hi = std::min(n, lo + (size_t)PF_CHUNK);
+                for (size_t i = lo; i < hi; i++) found |= search(roots[i], stamp, forward, stacks[t]);
+            }
+            if (found) any.store(true, std::memory_order_relaxed);
+        });
+        return any.load();
+    }
+
+    std::vector<std::pair<int,int>> maximum_matching(int greedy_mode = 0) {
+        int greedy_count = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        if (greedy_mode == 1) greedy_count = greedy_init();
+        else if (greedy_mode == 2) greedy_count = greedy_init_md();
+        else if (greedy_mode == matching::GREEDY_KARP_SIPSER) greedy_count = karp_sipser_init();
+        greedy_size = greedy_count;
+        greedy_ms = matching::ms_since(t0);
+
+        if (threads > 1) pool.reset(new matching::ThreadPool(threads));
+        stacks.assign(pool ? pool->size() : 1, {});
+        int phase = 0;
+        while (run_phase(++phase)) {}
+
+        std::vector<std::pair<int,int>> matching;
+        for (int u = 0; u < left_count; u++) {
+            if (pair_left[u] != NIL) matching.push_back({u, pair_left[u]});
+        }
+        return matching;
+    }
+};
+
+inline matching::Result solve(const matching::Graph& g, const matching::Options& opt = {}) {
+    PothenFan pf(g, matching::solve_threads(opt), opt.deterministic);
+    matching::Result r;
+    if (opt.initial) r.initial_size = pf.warm_start(*opt.initial);
+    r.matching = pf.maximum_matching(opt.greedy_mode);
+    r.greedy_size = pf.greedy_size;
+    r.greedy_ms = pf.greedy_ms;
+    return r;
+}
+
+} // namespace pothen_fan
@@ -0,0 +1,449 @@
+/*
+ * Semi-Streaming Matching - maximum cardinality matching in a few passes
+ * over an edge list that need not fit in memory
+ *
+ * The edges are never loaded. EdgeStream reads the file front to back
+ * once per pass through a fixed buffer: a text edge list ("V E" or
+ * "L R E" header, as for the other solvers) or a .csr file
+ * (matching/binary_format.hpp), whose offsets it keeps, O(V). Everything
+ * else StreamingMatching holds is O(V) as well:
+ *
+ *   greedy pass     match every edge whose ends are both free: a maximal
+ *                   matching, so at least half the maximum.
+ *   augment passes  find augmenting paths of length 3, x - c = d - y,
+ *                   online. A free vertex x seen next to a matched c
+ *                   becomes c's wing; when an edge joins a free y to d
+ *                   and c already has a wing x != y, the path is flipped
+ *                   at once. A free vertex is the wing of one matched
+ *                   vertex at a time, so the paths of a pass are
+ *                   disjoint, and the wings are cleared between passes.
+ *                   Matched vertices stay matched, so the matching stays
+ *                   maximal. Passes stop when one gains nothing.
+ *   completion      (optional) one more pass keeps the edges with an end
+ *                   that has fewer than `degree_cap` kept edges, at most
+ *                   degree_cap * V of them, plus the matching. That
+ *                   residual graph goes to MV or Gabow (optimized) with
+ *                   the matching as the initial one (warm_start.hpp), so
+ *                   the result is maximum on it, and on the whole graph
+ *                   when the pass dropped nothing.
+ *   validation      a last pass collects the matched pairs that are
+ *                   edges of the stream, for the usual report.
+ *
+ * Bipartite inputs are matched as general graphs on L + R vertices, right
+ * vertex v as L + v; pairs come back as (left, right).
+ *
+ * All integers, no hash containers, fully deterministic.
+ */
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+#include "matching/binary_format.hpp"
+#include "matching/graph.hpp"
+#include "matching/solver.hpp"
+#include "matching/text_parser.hpp"
+#include "matching/validate.hpp"
+#include "../../gabow-optimized/cpp/gabow_optimized.hpp"
+#include "../../micali-vazirani-pure/cpp/micali_vazirani_pure.hpp"
+
+namespace streaming_matching {
+
+using matching::NIL;
+
+static const size_t STREAM_BUFFER = 1 << 20;   /* bytes read per fread */
+
+static const int COMPLETE_NONE = 0;
+static const int COMPLETE_MV = 1;
+static const int COMPLETE_GABOW = 2;
+
+/* =========================================================================
+ * EdgeStream — one sequential read of the file per pass
+ *
+ * pass(f) calls f(u, v) for every edge, in file order, with vertex ids in
+ * [0, num_vertices()); self-loops are skipped. A text file is read up to
+ * its header's edge count or its first malformed token, and out-of-range
+ * endpoints are skipped, as the loaders in io.hpp do. A .csr file lists
+ * each general edge once, from its lower end; a target out of range is
+ * corrupt, as for map_binary_graph(). pass() returns false when the read
+ * fails or the file is corrupt, after the edges before that point.
+ * ========================================================================= */
+class EdgeStream {
+public:
+    EdgeStream() = default;
+    ~EdgeStream() { if (f_) fclose(f_); }
+    EdgeStream(const EdgeStream&) = delete;
+    EdgeStream& operator=(const EdgeStream&) = delete;
+
+    bool open(const char* path) {
+        path_ = path;
+        f_ = fopen(path, "rb");
+        if (!f_) { fprintf(stderr, "Cannot open file: %s\n", path); return false; }
+        buf_.resize(STREAM_BUFFER);
+        return matching::is_binary_graph(path) ? open_binary() : open_text();
+    }
+
+    int num_vertices() const { return left_ + (bipartite_ ? right_ : 0); }
+    int left() const { return left_; }
+    int right() const { return right_; }
+    bool bipartite() const { return bipartite_; }
+    bool binary() const { return binary_; }
+    long long declared_edges() const { return declared_; }
+    int passes() const { return passes_; }
+    long long edges() const { return edges_; }   /* edges the last pass delivered */
+    size_t bytes() const { return buf_.capacity() + offsets_.capacity() * sizeof(long long); }
+
+    template <class F>
+    bool pass(F&& f) {
+        passes_++;
+        edges_ = 0;
+        if (fseeko(f_, (off_t)data_pos_, SEEK_SET) != 0) { fprintf(stderr, "%s: seek failed\n", path_); return false; }
+        return binary_ ? binary_pass(f) : text_pass(f);
+    }
+
+private:
+    const char* path_ = "";
+    FILE* f_ = nullptr;
+    bool binary_ = false, bipartite_ = false;
+    int left_ = 0, right_ = 0;
+    long long declared_ = 0;
+    uint64_t data_pos_ = 0;             /* first edge byte (text) or targets[] (.csr) */
+    std::vector<char> buf_;
+    std::vector<long long> offsets_;    /* .csr row offsets */
+    int passes_ = 0;
+    long long edges_ = 0;
+
+    bool open_text() {
+        /* The header line: "V E" general, "L R E" bipartite */
+        long long h[3];
+        int fields = 0;
+        size_t got = fread(buf_.data(), 1, buf_.size(), f_);
+        const char* end = (const char*)memchr(buf_.data(), '\n', got);
+        if (!end) end = buf_.data() + got;
+        matching::IntScanner sc{buf_.data(), end};
+        while (fields < 3 && sc.next(h[fields])) fields++;
+        sc.skip_space();
+        if ((fields != 2 && fields != 3) || sc.p != end) {
+            fprintf(stderr, "%s: header is neither \"V E\" nor \"L R E\"\n", path_);
+            return false;
+        }
+        bipartite_ = fields == 3;
+        left_ = (int)h[0];
+        right_ = bipartite_ ? (int)h[1] : (int)h[0];
+        declared_ = h[fields - 1];
+        bool ok = h[0] >= 0 && h[0] < INT32_MAX && (!bipartite_ || (h[1] >= 0 && h[1] < INT32_MAX - h[0]));
+        if (!ok) { fprintf(stderr, "Bad header\n"); return false; }
+        data_pos_ = (uint64_t)(end - buf_.data());
+        return true;
+    }
+
+    bool open_binary() {
+        binary_ = true;
+        matching::BinaryHeader h;
+        if (fread(&h, sizeof h, 1, f_) != 1) { fprintf(stderr, "%s: truncated header\n", path_); return false; }
+        bipartite_ = (h.flags & matching::BINARY_FLAG_BIPARTITE) != 0;
+        bool wide = (h.flags & matching::BINARY_FLAG_WIDE) != 0;
+        if (h.n >= INT32_MAX || h.n_right >= INT32_MAX || (bipartite_ && h.n + h.n_right >= INT32_MAX)) {
+            fprintf(stderr, "%s: too many vertices\n", path_);
+            return false;
+        }
+        left_ = (int)h.n;
+        right_ = (int)h.n_right;
+        declared_ = (long long)(bipartite_ ? h.num_arcs : h.num_arcs / 2);
+        data_pos_ = h.targets_pos;
+
+        /* Offsets stay in memory: n + 1 of them, read in buffer-sized runs */
+        offsets_.resize((size_t)left_ + 1);
+        if (fseeko(f_, (off_t)h.offsets_pos, SEEK_SET) != 0) { fprintf(stderr, "%s: seek failed\n", path_); return false; }
+        size_t width = wide ? 8 : 4, per = buf_.size() / width;
+        for (size_t i = 0; i < offsets_.size();) {
+            size_t k = std::min(per, offsets_.size() - i);
+            if (fread(buf_.data(), width, k, f_) != k) { fprintf(stderr, "%s: truncated offsets\n", path_); return false; }
+            for (size_t j = 0; j < k; j++) {
+                if (wide) { int64_t x; memcpy(&x, buf_.data() + 8 * j, 8); offsets_[i + j] = x; }
+                else { int32_t x; memcpy(&x, buf_.data() + 4 * j, 4); offsets_[i + j] = x; }
+            }
+            i += k;
+        }
+        bool ok = offsets_[0] == 0 && (uint64_t)offsets_[left_] == h.num_arcs;
+        for (int u = 0; u < left_ && ok; u++) ok = offsets_[u] <= offsets_[u + 1];
+        if (!ok) fprintf(stderr, "%s: corrupt offsets\n", path_);
+        return ok;
+    }
+
+    template <class F>
+    void emit(long long u, long long v, F& f) {
+        if (bipartite_) {
+            if (u < 0 || u >= left_ || v < 0 || v >= right_) return;
+            v += left_;
+        } else if (u < 0 || u >= left_ || v < 0 || v >= left_ || u == v) {
+            return;
+        }
+        edges_++;
+        f((int)u, (int)v);
+    }
+
+    template <class F>
+    bool text_pass(F& f) {
+        long long remaining = declared_, u = 0;
+        bool have_u = false;
+        size_t keep = 0;   /* unparsed tail carried to the next read */
+        while (remaining > 0) {
+            size_t got = fread(buf_.data() + keep, 1, buf_.size() - keep, f_);
+            bool last = got < buf_.size() - keep;
+            size_t len = keep + got, stop = len;
+            /* Parse up to the last whitespace; a token cut by the buffer
+               end waits for the next read */
+            if (!last) {
+                while (stop > 0 && !matching::is_space_char(buf_[stop - 1])) stop--;
+                if (stop == 0) { fprintf(stderr, "%s: token longer than the buffer\n", path_); return false; }
+            }
+            matching::IntScanner sc{buf_.data(), buf_.data() + stop};
+            long long x;
+            while (remaining > 0 && sc.next(x)) {
+                if (!have_u) { u = x; have_u = true; continue; }
+                have_u = false;
+                remaining--;
+                emit(u, x, f);
+            }
+            sc.skip_space();
+            if (remaining > 0 && sc.p < sc.end) break;   /* malformed token: the edges so far */
+            keep = len - stop;
+            memmove(buf_.data(), buf_.data() + stop, keep);
+            if (last) break;
+        }
+        return true;
+    }
+
+    template <class F>
+    bool binary_pass(F& f) {
+        long long arcs = offsets_[left_], at = 0;
+        int u = 0, bound = bipartite_ ? right_ : left_;
+        size_t per = buf_.size() / sizeof(int32_t);
+        while (at < arcs) {
+            size_t k = (size_t)std::min<long long>((long long)per, arcs - at);
+            if (fread(buf_.data(), sizeof(int32_t), k, f_) != k) { fprintf(stderr, "%s: truncated targets\n", path_); return false; }
+            const int32_t* t = (const int32_t*)buf_.data();
+            for (size_t j = 0; j < k; j++, at++) {
+                while (offsets_[u + 1] <= at) u++;
+                if (t[j] < 0 || t[j] >= bound) {
+                    fprintf(stderr, "%s: corrupt offsets (target %d out of range)\n", path_, t[j]);
+                    return false;
+                }
+                if (bipartite_ || t[j] > u) emit(u, t[j], f);
+            }
+        }
+        return true;
+    }
+};
+
+/* One pass of the run, for the driver's log */
+struct PassStats {
+    const char* kind;           /* "greedy", "augment", "complete", "validate" */
+    long long edges = 0;        /* edges streamed */
+    int gain = 0;               /* matched edges added */
+    int size = 0;               /* matching size after the pass */
+    double ms = 0;
+    bool ok = true;             /* false: the stream failed, the pass is incomplete */
+};
+
+/* =========================================================================
+ * StreamingMatching — the O(V) state and the passes over it
+ * ========================================================================= */
+struct StreamingMatching {
+    EdgeStream& stream;
+    int n;
+    int size = 0;
+    std::vector<int> mate;
+    std::vector<int> wing;    /* matched c: a free neighbor reserved for c, this pass */
+    std::vector<int> owner;   /* free x: the matched vertex x is the wing of */
+
+    /* Completion */
+    bool exact = false;            /* the residual graph was the whole graph */
+    long long residual_edges = 0;
+    size_t residual_bytes = 0;     /* the residual graph and its solve, at their peak */
+
+    explicit StreamingMatching(EdgeStream& s)
+        : stream(s), n(s.num_vertices()), mate(n, NIL), wing(n, NIL), owner(n, NIL) {}
+
+    /* Match every edge with two free ends */
+    PassStats greedy_pass() {
+        auto t0 = std::chrono::steady_clock::now();
+        PassStats st{"greedy"};
+        int before = size;
+        st.ok = stream.pass([&](int u, int v) {
+            if (mate[u] != NIL || mate[v] != NIL) return;
+            mate[u] = v;
+            mate[v] = u;
+            size++;
+        });
+        return finish(st, before, t0);
+    }
+
+    /* Flip the length-3 augmenting paths the wings close, online */
+    PassStats augment_pass() {
+        auto t0 = std::chrono::steady_clock::now();
+        PassStats st{"augment"};
+        int before = size;
+        std::fill(wing.begin(), wing.end(), NIL);
+        std::fill(owner.begin(), owner.end(), NIL);
+        st.ok = stream.pass([&](int u, int v) {
+            if ((mate[u] == NIL) == (mate[v] == NIL)) {
+                /* free - free only before the greedy pass has run */
+                if (mate[u] == NIL) { mate[u] = v; mate[v] = u; size++; }
+                return;
+            }
+            int x = mate[u] == NIL ? u : v, c = x == u ? v : u, d = mate[c];
+            int y = wing[d];
+            if (y != NIL && y != x) {
+                /* y - d = c - x becomes y = d - c = x */
+                release(x);
+                release_wing(c);
+                release_wing(d);
+                mate[x] = c; mate[c] = x;
+                mate[y] = d; mate[d] = y;
+                size++;
+            } else if (wing[c] == NIL && owner[x] == NIL) {
+                wing[c] = x;
+                owner[x] = c;
+            }
+        });
+        return finish(st, before, t0);
+    }
+
+    /* The degree-capped residual graph, solved exactly from the matching;
+       one that would need 64-bit offsets is left unsolved */
+    PassStats complete_pass(int solver, int degree_cap, const matching::Options& opt) {
+        auto t0 = std::chrono::steady_clock::now();
+        PassStats st{"complete"};
+        int before = size;
+        std::vector<int>& kept = wing;   /* kept edges per vertex, reusing the wing array */
+        std::fill(kept.begin(), kept.end(), 0);
+        matching::EdgeList edges;
+        bool dropped = false;
+        st.ok = stream.pass([&](int u, int v) {
+            if (degree_cap > 0 && kept[u] >= degree_cap && kept[v] >= degree_cap && mate[u] != v) {
+                dropped = true;
+                return;
+            }
+            kept[u]++;
+            kept[v]++;
+            edges.push_back({u, v});
+        });
+        std::fill(owner.begin(), owner.end(), NIL);
+        if (!st.ok) return finish(st, before, t0);
+        exact = !dropped;
+        residual_edges = (long long)edges.size();
+        if (matching::needs_wide_offsets(matching::arcs_for(edges.size(), false))) {
+            fprintf(stderr, "Residual graph: %zu edges need 64-bit offsets; lower --degree-cap\n", edges.size());
+            exact = false;
+            return finish(st, before, t0);
+        }
+
+        matching::Matching initial = get_pairs();
+        matching::Graph h = matching::Graph::general(n, edges, opt.threads);
+        residual_bytes = edges.capacity() * sizeof(matching::Edge) + matching::csr_bytes(h);
+        matching::EdgeList().swap(edges);
+        matching::Options sub = opt;
+        sub.initial = &initial;
+        sub.epsilon = 0;
+        matching::Result r = solver == COMPLETE_MV ? micali_vazirani_pure::solve(h, sub)
+                                                   : gabow_optimized::solve(h, sub);
+        std::fill(mate.begin(), mate.end(), NIL);
+        for (const auto& e : r.matching) { mate[e.first] = e.second; mate[e.second] = e.first; }
+        size = (int)r.matching.size();
+        return finish(st, before, t0);
+    }
+
+    /* The matched pairs that are edges of the stream, checked with
+       validate_matching(); returns its error count, or 0 with st.ok false
+       when the stream failed (nothing is checked or reported then) */
+    int validate_pass(PassStats& st, bool report = true) {
+        auto t0 = std::chrono::steady_clock::now();
+        st = PassStats{"validate"};
+        std::vector<char> seen(n, 0);
+        matching::EdgeList found;
+        found.reserve(size);
+        st.ok = stream.pass([&](int u, int v) {
+            if (mate[u] != v || seen[u]) return;
+            seen[u] = seen[v] = 1;
+            found.push_back(to_output(u, v));
+        });
+        if (!st.ok) { finish(st, size, t0); return 0; }
+        int left = stream.left(), right = stream.right();
+        matching::Graph m = stream.bipartite() ? matching::Graph::bipartite(left, right, found, 1)
+                                               : matching::Graph::general(n, found, 1);
+        int errors = matching::validate_matching(m, get_matching(), report);
+        finish(st, size, t0);
+        return errors;
+    }
+
+    /* No matching is larger: twice a maximal one, or half the vertices
+       (the smaller side when bipartite). Reaching it proves maximum. */
+    int upper_bound() const {
+        int half = stream.bipartite() ? std::min(stream.left(), stream.right()) : n / 2;
+        return exact ? size : (int)std::min<long long>(2LL * size, half);
+    }
+
+    /* Sorted pairs: (u, v) with u < v, or (left, right) when bipartite */
+    matching::Matching get_matching() const {
+        matching::Matching out;
+        out.reserve(size);
+        for (int u = 0; u < n; u++)
+            if (mate[u] > u) out.push_back(to_output(u, mate[u]));
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    /* Bytes of the O(V) state: the arrays and the stream's buffers */
+    size_t state_bytes() const {
+        return (mate.capacity() + wing.capacity() + owner.capacity()) * sizeof(int) + stream.bytes();
+    }
+
+private:
+    void release(int x) {
+        if (owner[x] != NIL) { wing[owner[x]] = NIL; owner[x] = NIL; }
+    }
+
+    void release_wing(int c) {
+        if (wing[c] != NIL) { owner[wing[c]] = NIL; wing[c] = NIL; }
+    }
+
+    std::pair<int,int> to_output(int u, int v) const {
+        if (u > v) std::swap(u, v);
+        return stream.bipartite() ? std::make_pair(u, v - stream.left()) : std::make_pair(u, v);
+    }
+
+    /* The matching in engine ids, as an initial matching for completion */
+    matching::Matching get_pairs() const {
+        matching::Matching out;
+        out.reserve(size);
+        for (int u = 0; u < n; u++)
+            if (mate[u] > u) out.push_back({u, mate[u]});
+        return out;
+    }
+
+    PassStats finish(PassStats& st, int before, std::chrono::steady_clock::time_point t0) {
+        st.edges = stream.edges();
+        st.gain = size - before;
+        st.size = size;
+        st.ms = matching::ms_since(t0);
+        return st;
+    }
+};
+
+/* Peak resident set size of this process in bytes (getrusage) */
+inline long long peak_rss_bytes() {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+    return (long long)ru.ru_maxrss * 1024;   /* Linux reports KiB */
+}
+
+} // namespace streaming_matching
@@ -0,0 +1,1146 @@
+/*
+ * Weighted Blossom Algorithm — Maximum Weight Matching on General Graphs
+ *
+ * Primal-dual Edmonds algorithm on the shared CSR plus a per-arc weight
+ * array (matching/weights.hpp). The blossom machinery is the one the
+ * cardinality Edmonds solvers use (NetworkX / van Rantwijk naming:
+ * blossomparent, blossombase, labeledge, assignLabel, scanBlossom,
+ * addBlossom, expandBlossom, augmentBlossom), plus the dual variables they
+ * leave out: y[v] per vertex and z[b] per non-trivial blossom. Every edge
+ * keeps slack y[u] + y[v] - 4w(u, v) + 2 * (z of the blossoms holding
+ * both ends) >= 0, and matched edges and blossom edges stay tight, so the
+ * matching is optimal once no free vertex has a positive dual. y is four
+ * times the LP dual and z twice: every value stays an even integer, and
+ * the seed can split an edge's slack between its ends in halves.
+ *
+ * All free vertices with a positive dual are S-roots of one search forest.
+ * When the forest cannot grow on tight edges, the duals change by the
+ * largest delta that keeps them feasible (S vertices -delta, T vertices
+ * +delta, S blossoms +delta, T blossoms -delta), which is the smallest of
+ *
+ *   delta1  smallest S-vertex dual                     (heap h1)
+ *   delta2  least slack from S to an unlabeled vertex  (heap h2)
+ *   delta3  least slack between two S blossoms, / 2    (heap h3)
+ *   delta4  smallest T-blossom dual                    (heap h4)
+ *
+ * and the edge or blossom that defined it becomes usable. Changing every
+ * dual would cost O(V) per step, so duals are lazy (Galil, Micali and
+ * Gabow): D is the sum of all deltas so far, and a top-level blossom
+ * records D when its label last changed (t0). A vertex's value is
+ * y[v] -/+ (D - t0) by its blossom's label, and is written back only when
+ * the label changes. Heap keys add D (2D for S-S slack) so they stay
+ * fixed while D grows; a step is one look at each heap top.
+ *
+ * Trees are not restarted after each augmentation, as stage-based
+ * versions do. A tree that augments (or whose S vertex reaches dual 0, in
+ * which case the path to its root is flipped so that vertex ends up free
+ * with dual 0, as in LEMON's "retire" step) is dissolved into the
+ * unlabeled part of the graph: its duals are fixed and its vertices get
+ * their least-slack edges to the live trees. Its blossoms stay, even with
+ * zero dual (a stage-based search expands those); they go only when a
+ * T-blossom's dual reaches zero, so a later tree reuses them instead of
+ * shrinking the same cycles again. Heap entries that still point at a
+ * dissolved tree are recognized by their key (it no longer matches the
+ * dual or slack behind it) and recomputed when they reach the top. A free vertex with dual 0 ends a
+ * path like a second root when a tree reaches it.
+ *
+ * The search starts from a greedy seed: edges by descending weight, each
+ * taken when both ends are free and the duals can be lowered to make it
+ * tight without leaving anything infeasible (the 1/2-approximate greedy,
+ * minus the edges no dual fits); then the duals of free vertices are
+ * lowered as far as their edges allow. Free vertices left at dual 0 need
+ * no search at all. --initial pairs are offered first.
+ *
+ * Blossoms outlive the tree that made them, so IDs
+ * (n..2n-1) are recycled and every blossom owns its cycle vectors.
+ *
+ * Complexity: O(V E log V) worst case; the seed leaves few roots in
+ * practice.
+ *
+ * Built with -DMATCHING_STATS=1 (matching/stats.hpp) it counts dual
+ * updates by kind, arcs scanned, blossoms created and expanded,
+ * augmentations, retired vertices and recomputed heap entries.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <utility>
+#include <vector>
+
+#include "matching/graph.hpp"
+#include "matching/solver.hpp"
+#include "matching/stats.hpp"
+#include "matching/weights.hpp"
+
+namespace weighted_blossom {
+
+using matching::NIL;
+
+/* Min-heap over ids 0..N-1 with decrease-key and erase; ties go to the smaller id */
+class IndexedHeap {
+public:
+    void init(int ids) {
+        key_.assign(ids, 0);
+        pos_.assign(ids, -1);
+        heap_.clear();
+    }
+
+    bool empty() const { return heap_.empty(); }
+    bool contains(int i) const { return pos_[i] >= 0; }
+    int top() const { return heap_[0]; }
+    long long top_key() const { return key_[heap_[0]]; }
+
+    /* Insert i, or lower its key. False (and no change) if i already has a key <= k. */
+    bool push_or_decrease(int i, long long k) {
+        if (pos_[i] >= 0) {
+            if (k >= key_[i]) return false;
+            key_[i] = k;
+            up(pos_[i]);
+            return true;
+        }
+        key_[i] = k;
+        pos_[i] = (int)heap_.size();
+        heap_.push_back(i);
+        up(pos_[i]);
+        return true;
+    }
+
+    /* Insert i, or move its key to k in either direction */
+    void set(int i, long long k) {
+        if (pos_[i] < 0) { push_or_decrease(i, k); return; }
+        long long old = key_[i];
+        key_[i] = k;
+        if (k < old) up(pos_[i]);
+        else down(pos_[i]);
+    }
+
+    void erase(int i) {
+        int p = pos_[i];
+        if (p < 0) return;
+        pos_[i] = -1;
+        int last = heap_.back();
+        heap_.pop_back();
+        if (p == (int)heap_.size()) return;
+        heap_[p] = last;
+        pos_[last] = p;
+        up(p);
+        down(pos_[last]);
+    }
+
+private:
+    std::vector<long long> key_;
+    std::vector<int> heap_;
+    std::vector<int> pos_;
+
+    bool less(int a, int b) const { return key_[a] < key_[b] || (key_[a] == key_[b] && a < b); }
+
+    void up(int p) {
+        int i = heap_[p];
+        while (p > 0) {
+            int q = (p - 1) / 2;
+            if (!less(i, heap_[q])) break;
+            heap_[p] = heap_[q];
+            pos_[heap_[p]] = p;
+            p = q;
+        }
+        heap_[p] = i;
+        pos_[i] = p;
+    }
+
+    void down(int p) {
+        int i = heap_[p], size = (int)heap_.size();
+        while (true) {
+            int c = 2 * p + 1;
+            if (c >= size) break;
+            if (c + 1 < size && less(heap_[c + 1], heap_[c])) c++;
+            if (!less(heap_[c], i)) break;
+            heap_[p] = heap_[c];
+            pos_[heap_[p]] = p;
+            p = c;
+        }
+        heap_[p] = i;
+        pos_[i] = p;
+    }
+};
+
+/* An edge as an arc k out of vertex v */
+struct EdgeRef {
+    int v = NIL;
+    int k = -1;
+};
+
+/* What solve() reports besides matching::Result */
+struct Report {
+    long long weight = 0;         /* weight of the matching */
+    long long greedy_weight = 0;  /* weight of the seed matching */
+    bool certified = false;       /* the final duals prove the matching optimal */
+    double certify_ms = 0;        /* time spent checking them */
+};
+
+struct Solver {
+    int n;
+    const matching::Graph& adj;
+    const int* wt;              // wt[k] = weight of arc k
+    std::vector<int> mate;      // mate[v] = matched partner, or -1
+
+    // Blossoms. IDs 0..n-1 are the vertices, n..2n-1 non-trivial blossoms
+    // handed out from free_ids. edges[b][i] connects childs[b][i] and
+    // childs[b][(i + 1) % k].
+    std::vector<std::vector<int>> childs;
+    std::vector<std::vector<std::pair<int,int>>> edges;
+    std::vector<int> free_ids;
+    std::vector<int> inblossom;     // inblossom[v] = top-level blossom containing v
+    std::vector<int> blossomparent; // blossomparent[b] = parent blossom, or -1
+    std::vector<int> blossombase;   // blossombase[b] = base vertex, -1 for a free ID
+
+    // Duals (y at 4x, z at 2x the LP values). y[v] and z[b] of a top-level blossom are their values
+    // at D == t0[b]; see dual() and bdual(). Nested blossoms' z are exact.
+    std::vector<long long> y;
+    std::vector<long long> z;
+    std::vector<long long> t0;
+    long long D = 0;            // sum of all deltas
+
+    // Search forest
+    std::vector<int> label;                    // 0=unlabeled, 1=S, 2=T (5=breadcrumb)
+    std::vector<std::pair<int,int>> labeledge; // label edge for tree structure
+    std::vector<int> tree;                     // tree[b] = root vertex of labeled blossom b
+    std::vector<std::vector<int>> members;     // members[r] = blossoms labeled in r's tree
+    int live = 0;                              // trees still growing
+
+    // Least-slack edges: bestedge[v] from an S vertex to the free-labeled
+    // vertex v (bestkey = slack + D), bestedge[b] from S blossom b to
+    // another S blossom (bestkey = slack + 2D), mybestedges[b] = one
+    // least-slack edge per neighboring S blossom, kept for addBlossom.
+    std::vector<EdgeRef> bestedge;
+    std::vector<long long> bestkey;
+    std::vector<std::vector<EdgeRef>> mybestedges;
+    std::vector<char> has_mybest;
+    std::vector<int> h2_vertex;                // vertex behind an h2 key
+
+    IndexedHeap h1;   // S vertices: y + D
+    IndexedHeap h2;   // unlabeled top-level blossoms: least slack from S + D
+    IndexedHeap h3;   // S blossoms: least S-S slack + 2D
+    IndexedHeap h4;   // T blossoms: z + D
+
+    std::vector<int> queue;                    // S vertices to scan
+    std::vector<int> leaf_buf, leaf_buf2, settle_buf, stack_buf;
+    std::vector<int> path_buf;                 // scratch for scanBlossom()
+    std::vector<std::pair<int,int>> aug_stack; // scratch for augmentBlossom()
+    std::vector<EdgeRef> bto_edge;             // addBlossom: best edge per S blossom
+    std::vector<long long> bto_slack;
+    std::vector<int> bto_touched;
+    std::vector<int> region;                   // scratch for dissolve()
+
+    // --stats=json (stats.hpp); the counters only move under MATCHING_STATS
+    matching::StageTimes times;
+    long long stat_updates[4] = {0, 0, 0, 0};
+    long long stat_arcs = 0, stat_created = 0, stat_expanded = 0, stat_paths = 0;
+    long long stat_retired = 0, stat_refreshed = 0;
+
+    Solver(const matching::Graph& g, const std::vector<int>& weight)
+        : n(g.num_vertices()), adj(g), wt(weight.data()) {
+        MATCHING_STAT_TIMER(times.setup);
+        int nb = 2 * n;
+        mate.assign(n, NIL);
+        childs.resize(nb);
+        edges.resize(nb);
+        mybestedges.resize(nb);
+        for (int b = nb - 1; b >= n; b--) free_ids.push_back(b);
+        inblossom.resize(n);
+        for (int v = 0; v < n; v++) inblossom[v] = v;
+        blossomparent.assign(nb, NIL);
+        blossombase.assign(nb, NIL);
+        for (int v = 0; v < n; v++) blossombase[v] = v;
+        y.assign(n, 0);
+        z.assign(nb, 0);
+        t0.assign(nb, 0);
+        label.assign(nb, 0);
+        labeledge.assign(nb, {NIL, NIL});
+        tree.assign(nb, NIL);
+        members.resize(n);
+        bestedge.assign(nb, EdgeRef());
+        bestkey.assign(nb, 0);
+        has_mybest.assign(nb, 0);
+        h2_vertex.assign(nb, NIL);
+        h1.init(n);
+        h2.init(nb);
+        h3.init(nb);
+        h4.init(nb);
+        bto_edge.assign(nb, EdgeRef());
+        bto_slack.assign(nb, 0);
+    }
+
+    bool isBlossom(int b) const { return b >= n; }
+
+    bool isTop(int b) const {
+        return isBlossom(b) ? blossombase[b] != NIL && blossomparent[b] == NIL : inblossom[b] == b;
+    }
+
+    // Vertices of b, appended to out
+    void leaves(int b, std::vector<int>& out) {
+        if (!isBlossom(b)) { out.push_back(b); return; }
+        stack_buf.clear();
+        stack_buf.push_back(b);
+        while (!stack_buf.empty()) {
+            int x = stack_buf.back();
+            stack_buf.pop_back();
+            if (!isBlossom(x)) { out.push_back(x); continue; }
+            for (int i = (int)childs[x].size() - 1; i >= 0; i--) stack_buf.push_back(childs[x][i]);
+        }
+    }
+
+    // ---- Lazy duals ----
+
+    // Dual change per unit of D for the vertices of top-level blossom b
+    int rate(int b) const {
+        int l = label[b] & 3;
+        return l == 1 ? -1 : l == 2 ? 1 : 0;
+    }
+    long long dual(int v) const {
+        int b = inblossom[v];
+        return y[v] + rate(b) * (D - t0[b]);
+    }
+    long long bdual(int b) const { return z[b] - rate(b) * (D - t0[b]); }
+    long long cost(int k) const { return 4LL * wt[k]; }
+    long long slack(int v, int w, int k) const { return dual(v) + dual(w) - cost(k); }
+    int other(const EdgeRef& e, int v) const {
+        int w = adj.targets()[e.k];
+        return w == v ? e.v : w;
+    }
+
+    // Write the current duals of top-level blossom b back, before its label changes
+    void settle(int b) {
+        long long d = rate(b) * (D - t0[b]);
+        t0[b] = D;
+        if (d == 0) return;
+        settle_buf.clear();
+        leaves(b, settle_buf);
+        for (int v : settle_buf) y[v] += d;
+        if (isBlossom(b)) z[b] -= d;
+    }
+
+    // ---- Tree building ----
+
+    void assignLabel(int w, int t, int v) {
+        int b = inblossom[w];
+        // b was unlabeled, so its stored duals are current
+        t0[b] = D;
+        label[w] = label[b] = t;
+        if (v != NIL) labeledge[w] = labeledge[b] = {v, w};
+        else labeledge[w] = labeledge[b] = {NIL, NIL};
+        bestedge[w] = bestedge[b] = EdgeRef();
+        int r = (v == NIL) ? w : tree[inblossom[v]];
+        tree[b] = r;
+        members[r].push_back(b);
+        h2.erase(b);
+        if (t == 1) {
+            // S-blossom: add its leaves to the queue
+            leaf_buf.clear();
+            leaves(b, leaf_buf);
+            for (int u : leaf_buf) {
+                queue.push_back(u);
+                h1.push_or_decrease(u, y[u] + D);
+            }
+        } else {
+            // T-blossom: label the mate of its base as S
+            if (isBlossom(b)) h4.push_or_decrease(b, z[b] + D);
+            int base = blossombase[b];
+            assignLabel(mate[base], 1, base);
+        }
+    }
+
+    // ---- Blossom detection ----
+
+    // Trace from two S-vertices to their common base; -1 if they are in
+    // different trees
+    int scanBlossom(int v, int w) {
+        std::vector<int>& path = path_buf;
+        path.clear();
+        int base = NIL;
+        while (v != NIL) {
+            int b = inblossom[v];
+            if (label[b] & 4) { base = blossombase[b]; break; }
+            path.push_back(b);
+            label[b] = 5; // breadcrumb
+            if (labeledge[b].first == NIL) {
+                v = NIL; // reached the root
+            } else {
+                v = labeledge[b].first;
+                v = labeledge[inblossom[v]].first;
+            }
+            if (w != NIL) std::swap(v, w);
+        }
+        for (int b : path) label[b] = 1;
+        return base;
+    }
+
+    // ---- Blossom contraction ----
+
+    void considerBest(int b, const EdgeRef& e) {
+        int w = adj.targets()[e.k];
+        int j = inblossom[w] == b ? e.v : w;
+        int bj = inblossom[j];
+        if (bj == b || label[bj] != 1) return;
+        long long s = slack(e.v, w, e.k);
+        if (bto_edge[bj].k < 0) bto_touched.push_back(bj);
+        else if (s >= bto_slack[bj]) return;
+        bto_edge[bj] = e;
+        bto_slack[bj] = s;
+    }
+
+    void addBlossom(int base, int v, int w) {
+        MATCHING_STAT(stat_created++;)
+        int bb = inblossom[base];
+        int bv = inblossom[v];
+        int bw = inblossom[w];
+
+        int b = free_ids.back();
+        free_ids.pop_back();
+        blossombase[b] = base;
+        blossomparent[b] = NIL;
+        blossomparent[bb] = b;
+        std::vector<int>& path = childs[b];
+        std::vector<std::pair<int,int>>& edgs = edges[b];
+        path.clear();
+        edgs.clear();
+        edgs.push_back({v, w}); // bridge edge
+
+        // Trace from v back to base
+        while (bv != bb) {
+            blossomparent[bv] = b;
+            path.push_back(bv);
+            edgs.push_back(labeledge[bv]);
+            v = labeledge[bv].first;
+            bv = inblossom[v];
+        }
+        path.push_back(bb);
+        std::reverse(path.begin(), path.end());
+        std::reverse(edgs.begin(), edgs.end());
+
+        // Trace from w back to base
+        while (bw != bb) {
+            blossomparent[bw] = b;
+            path.push_back(bw);
+            edgs.push_back({labeledge[bw].second, labeledge[bw].first}); // reversed
+            w = labeledge[bw].first;
+            bw = inblossom[w];
+        }
+
+        // The children stop being top-level: fix their duals
+        for (int c : path) {
+            settle(c);
+            if (label[c] == 2) h4.erase(c);
+            else h3.erase(c);
+        }
+        label[b] = 1;
+        labeledge[b] = labeledge[bb];
+        z[b] = 0;
+        t0[b] = D;
+        tree[b] = tree[bb];
+        members[tree[b]].push_back(b);
+
+        // Relabel: T-vertices inside the blossom become S
+        leaf_buf.clear();
+        leaves(b, leaf_buf);
+        for (int u : leaf_buf) {
+            if (label[inblossom[u]] == 2) {
+                queue.push_back(u);
+                h1.push_or_decrease(u, y[u] + D);
+            }
+            inblossom[u] = b;
+        }
+
+        // Least-slack edge to each neighboring S blossom
+        bto_touched.clear();
+        for (int c : path) {
+            if (isBlossom(c) && has_mybest[c]) {
+                for (const EdgeRef& e : mybestedges[c]) considerBest(b, e);
+                mybestedges[c].clear();
+                has_mybest[c] = 0;
+            } else {
+                leaf_buf2.clear();
+                leaves(c, leaf_buf2);
+                for (int u : leaf_buf2)
+                    for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++)
+                        considerBest(b, EdgeRef{u, k});
+            }
+            bestedge[c] = EdgeRef();
+        }
+        mybestedges[b].clear();
+        EdgeRef best;
+        long long best_slack = 0;
+        for (int bj : bto_touched) {
+            const EdgeRef& e = bto_edge[bj];
+            mybestedges[b].push_back(e);
+            if (best.k < 0 || bto_slack[bj] < best_slack) { best = e; best_slack = bto_slack[bj]; }
+            bto_edge[bj] = EdgeRef();
+        }
+        has_mybest[b] = 1;
+        bestedge[b] = best;
+        if (best.k >= 0) {
+            bestkey[b] = best_slack + 2 * D;
+            h3.push_or_decrease(b, bestkey[b]);
+        }
+    }
+
+    // ---- Blossom expansion ----
+
+    void freeBlossom(int b) {
+        label[b] = 0;
+        labeledge[b] = {NIL, NIL};
+        bestedge[b] = EdgeRef();
+        tree[b] = NIL;
+        mybestedges[b].clear();
+        has_mybest[b] = 0;
+        blossombase[b] = NIL;
+        blossomparent[b] = NIL;
+        z[b] = 0;
+        h2.erase(b);
+        h3.erase(b);
+        h4.erase(b);
+        childs[b].clear();
+        edges[b].clear();
+        free_ids.push_back(b);
+        MATCHING_STAT(stat_expanded++;)
+    }
+
+    // Vertex u of a T-blossom was reached by a tight edge from an S vertex
+    // that is still in a live tree
+    bool reachedBy(int u) const {
+        if (label[u] == 0) return false;
+        int v = labeledge[u].first;
+        if (v == NIL || label[inblossom[v]] != 1) return false;
+        int k = matching::find_arc(adj, v, u);
+        return k >= 0 && slack(v, u, k) == 0;
+    }
+
+    // A T-blossom whose dual reached zero, during the search. Its children
+    // become top-level; the ones on the even path from its entry child to
+    // its base keep T and S labels, the rest are unlabeled unless a
+    // neighboring S vertex already reached them.
+    void expandBlossom(int b) {
+        settle(b);
+        h4.erase(b);
+        std::vector<int>& C = childs[b];
+        std::vector<std::pair<int,int>>& E = edges[b];
+        for (int s : C) {
+            blossomparent[s] = NIL;
+            t0[s] = D;
+            if (isBlossom(s)) {
+                // Left over from the tree this blossom was made in
+                label[s] = 0;
+                labeledge[s] = {NIL, NIL};
+                bestedge[s] = EdgeRef();
+                leaf_buf.clear();
+                leaves(s, leaf_buf);
+                for (int u : leaf_buf) inblossom[u] = s;
+            } else {
+                inblossom[s] = s;
+                if (!reachedBy(s)) label[s] = 0;
+            }
+        }
+
+        int k = (int)C.size();
+        auto ci = [k](int j) { return ((j % k) + k) % k; };
+        int entrychild = inblossom[labeledge[b].second];
+        int j = 0;
+        while (C[j] != entrychild) j++;
+        int jstep;
+        if (j & 1) { j -= k; jstep = 1; } else { jstep = -1; }
+        int v = labeledge[b].first, w = labeledge[b].second;
+        while (j != 0) {
+            int q;
+            if (jstep == 1) q = E[ci(j)].second;
+            else q = E[ci(j - 1)].first;
+            label[w] = 0;
+            label[q] = 0;
+            assignLabel(w, 2, v);
+            j += jstep;
+            if (jstep == 1) { v = E[ci(j)].first; w = E[ci(j)].second; }
+            else { w = E[ci(j - 1)].first; v = E[ci(j - 1)].second; }
+            j += jstep;
+        }
+        // The base child keeps T without passing S on to its mate again
+        int bw = C[ci(j)];
+        label[w] = label[bw] = 2;
+        labeledge[w] = labeledge[bw] = {v, w};
+        bestedge[bw] = EdgeRef();
+        tree[bw] = tree[b];
+        members[tree[bw]].push_back(bw);
+        if (isBlossom(bw)) h4.push_or_decrease(bw, z[bw] + D);
+        j += jstep;
+        while (C[ci(j)] != entrychild) {
+            int bv = C[ci(j)];
+            if (label[bv] == 1) { j += jstep; continue; }
+            int found = NIL;
+            if (isBlossom(bv)) {
+                leaf_buf.clear();
+                leaves(bv, leaf_buf);
+                for (int u : leaf_buf) if (reachedBy(u)) { found = u; break; }
+            } else if (reachedBy(bv)) {
+                found = bv;
+            }
+            if (found != NIL) {
+                label[found] = 0;
+                label[mate[blossombase[bv]]] = 0;
+                assignLabel(found, 2, labeledge[found].first);
+            }
+            j += jstep;
+        }
+        // Marks left by dissolved trees hid edges from the live ones:
+        // rescan what stays unlabeled
+        for (int s : C) {
+            if (label[s] != 0) continue;
+            clearLabels(s);
+            refreshUnlabeled(s);
+        }
+        freeBlossom(b);
+    }
+
+    // ---- Augmentation through blossoms ----
+
+    // Make v the base of b, re-matching the cycle. Sub-blossoms are handled
+    // on a work stack: they touch disjoint vertices, so order does not matter.
+    void augmentBlossom(int b0, int v0) {
+        aug_stack.clear();
+        aug_stack.push_back({b0, v0});
+        while (!aug_stack.empty()) {
+            int b = aug_stack.back().first, v = aug_stack.back().second;
+            aug_stack.pop_back();
+            int t = v;
+            while (blossomparent[t] != b) t = blossomparent[t];
+            if (isBlossom(t)) aug_stack.push_back({t, v});
+            std::vector<int>& C = childs[b];
+            std::vector<std::pair<int,int>>& E = edges[b];
+            int k = (int)C.size();
+            auto ci = [k](int j) { return ((j % k) + k) % k; };
+            int i = 0;
+            while (C[i] != t) i++;
+            int j = i, jstep;
+            if (i & 1) { j -= k; jstep = 1; } else { jstep = -1; }
+            while (j != 0) {
+                j += jstep;
+                int t1 = C[ci(j)];
+                int w, x;
+                if (jstep == 1) { w = E[ci(j)].first; x = E[ci(j)].second; }
+                else { x = E[ci(j - 1)].first; w = E[ci(j - 1)].second; }
+                if (isBlossom(t1)) aug_stack.push_back({t1, w});
+                j += jstep;
+                int t2 = C[ci(j)];
+                if (isBlossom(t2)) aug_stack.push_back({t2, x});
+                mate[w] = x;
+                mate[x] = w;
+            }
+            std::rotate(C.begin(), C.begin() + i, C.end());
+            std::rotate(E.begin(), E.begin() + i, E.end());
+            blossombase[b] = v;
+        }
+    }
+
+    // Flip the tree path from S-vertex s to its root; s gets matched to j
+    void flipToRoot(int s, int j) {
+        while (true) {
+            int bs = inblossom[s];
+            if (isBlossom(bs)) augmentBlossom(bs, s);
+            mate[s] = j;
+            if (labeledge[bs].first == NIL) break; // root, or a free unlabeled base
+            int t = labeledge[bs].first;           // T-vertex
+            int bt = inblossom[t];
+            s = labeledge[bt].first;
+            j = labeledge[bt].second;
+            if (isBlossom(bt)) augmentBlossom(bt, j);
+            mate[j] = s;
+        }
+    }
+
+    // ---- Dissolving a finished tree ----
+
+    // Clear the labels of b and everything nested in it
+    void clearLabels(int b) {
+        stack_buf.clear();
+        stack_buf.push_back(b);
+        while (!stack_buf.empty()) {
+            int x = stack_buf.back();
+            stack_buf.pop_back();
+            label[x] = 0;
+            labeledge[x] = {NIL, NIL};
+            bestedge[x] = EdgeRef();
+            tree[x] = NIL;
+            if (isBlossom(x)) {
+                mybestedges[x].clear();
+                has_mybest[x] = 0;
+                for (int c : childs[x]) stack_buf.push_back(c);
+            }
+        }
+    }
+
+    // Unlabeled top-level blossom b: recompute its vertices' least-slack
+    // edges to the live S blossoms and its h2 key
+    void refreshUnlabeled(int b) {
+        MATCHING_STAT(stat_refreshed++;)
+        leaf_buf2.clear();
+        leaves(b, leaf_buf2);
+        const int* tg = adj.targets();
+        int best = NIL;
+        for (int u : leaf_buf2) {
+            bestedge[u] = EdgeRef();
+            long long uy = y[u];    // unlabeled: exact
+            for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++) {
+                int w = tg[k];
+                int bw = inblossom[w];
+                if (bw == b || label[bw] != 1) continue;
+                long long key = uy + dual(w) - cost(k) + D;
+                if (bestedge[u].k < 0 || key < bestkey[u]) { bestedge[u] = EdgeRef{u, k}; bestkey[u] = key; }
+            }
+            if (bestedge[u].k >= 0 && (best == NIL || bestkey[u] < bestkey[best])) best = u;
+        }
+        if (best == NIL) {
+            h2.erase(b);
+        } else {
+            h2.set(b, bestkey[best]);
+            h2_vertex[b] = best;
+        }
+    }
+
+    // S blossom b: recompute its least-slack edge to another S blossom
+    void refreshS(int b) {
+        MATCHING_STAT(stat_refreshed++;)
+        bestedge[b] = EdgeRef();
+        mybestedges[b].clear();
+        has_mybest[b] = 0;
+        leaf_buf2.clear();
+        leaves(b, leaf_buf2);
+        const int* tg = adj.targets();
+        for (int u : leaf_buf2) {
+            for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++) {
+                int w = tg[k];
+                int bw = inblossom[w];
+                if (bw == b || label[bw] != 1) continue;
+                long long key = slack(u, w, k) + 2 * D;
+                if (bestedge[b].k < 0 || key < bestkey[b]) { bestedge[b] = EdgeRef{u, k}; bestkey[b] = key; }
+            }
+        }
+        if (bestedge[b].k >= 0) h3.set(b, bestkey[b]);
+        else h3.erase(b);
+    }
+
+    // Tree r augmented or retired a vertex: fix its duals, drop its labels
+    // and heap entries and hand its vertices to the unlabeled part with
+    // fresh least-slack edges.
+    void dissolve(int r) {
+        MATCHING_STAT_TIMER_IN(times.augment, times.search);
+        live--;
+        region.clear();
+        for (int b : members[r]) {
+            if (label[b] == 0 || tree[b] != r || !isTop(b)) continue;
+            settle(b);
+            if (label[b] == 1) {
+                h3.erase(b);   // its vertices' h1 entries go stale
+            } else {
+                h4.erase(b);
+            }
+            clearLabels(b);
+            region.push_back(b);
+        }
+        std::vector<int>().swap(members[r]);
+        for (int b : region) refreshUnlabeled(b);
+    }
+
+    // ---- Search ----
+
+    // Look at edge (v, w) = arc k (either direction) from S-vertex v.
+    // True if v's tree augmented and is gone.
+    bool relax(int v, int w, int k) {
+        int bv = inblossom[v];
+        int bw = inblossom[w];
+        if (bv == bw) return false;
+        long long s = slack(v, w, k);
+        if (s <= 0) {
+            if (label[bw] == 0) {
+                if (mate[blossombase[bw]] == NIL) {
+                    // A free vertex with dual 0: augment to it
+                    MATCHING_STAT(stat_paths++;)
+                    int r = tree[bv];
+                    flipToRoot(v, w);
+                    flipToRoot(w, v);
+                    dissolve(r);
+                    return true;
+                }
+                assignLabel(w, 2, v);
+            } else if (label[bw] == 1) {
+                int base = scanBlossom(v, w);
+                if (base != NIL) {
+                    addBlossom(base, v, w);
+                } else {
+                    // Two trees meet: augmenting path
+                    MATCHING_STAT(stat_paths++;)
+                    int rv = tree[bv], rw = tree[bw];
+                    flipToRoot(v, w);
+                    flipToRoot(w, v);
+                    dissolve(rv);
+                    dissolve(rw);
+                    return true;
+                }
+            } else if (label[w] == 0) {
+                // w sits in a T-blossom: remember it was reached
+                label[w] = 2;
+                labeledge[w] = {v, w};
+            }
+        } else if (label[bw] == 1) {
+            long long key = s + 2 * D;
+            if (bestedge[bv].k < 0 || key < bestkey[bv]) {
+                bestedge[bv] = EdgeRef{v, k};
+                bestkey[bv] = key;
+                h3.push_or_decrease(bv, key);
+            }
+        } else if (label[w] == 0) {
+            long long key = s + D;
+            if (bestedge[w].k < 0 || key < bestkey[w]) {
+                bestedge[w] = EdgeRef{v, k};
+                bestkey[w] = key;
+                if (label[bw] == 0 && h2.push_or_decrease(bw, key)) h2_vertex[bw] = w;
+            }
+        }
+        return false;
+    }
+
+    void scan(int v) {
+        MATCHING_STAT(stat_arcs += adj.degree(v);)
+        const int* tg = adj.targets();
+        for (int k = adj.adj_start(v); k < adj.adj_start(v + 1); k++)
+            if (relax(v, tg[k], k)) return;
+    }
+
+    // True if the h2 top still describes a live edge; recomputes it if not
+    bool validUnlabeled(int b) {
+        int u = h2_vertex[b];
+        const EdgeRef& e = bestedge[u];
+        if (label[b] == 0 && isTop(b) && e.k >= 0 && inblossom[u] == b && bestkey[u] == h2.top_key()) {
+            int s = other(e, u);
+            if (label[inblossom[s]] == 1 && slack(u, s, e.k) + D == bestkey[u]) return true;
+        }
+        if (label[b] == 0 && isTop(b)) refreshUnlabeled(b);
+        else h2.erase(b);
+        return false;
+    }
+
+    // True if S-vertex u's h1 key is current. A dissolved tree leaves its
+    // entries behind; they can only be too low, so they are fixed here.
+    bool validVertex(int u) {
+        if (label[inblossom[u]] != 1) { h1.erase(u); return false; }
+        long long key = dual(u) + D;
+        if (key == h1.top_key()) return true;
+        h1.set(u, key);
+        return false;
+    }
+
+    bool validS(int b) {
+        const EdgeRef& e = bestedge[b];
+        if (label[b] == 1 && isTop(b) && e.k >= 0 && bestkey[b] == h3.top_key()) {
+            int w = adj.targets()[e.k];
+            int bv = inblossom[e.v], bw = inblossom[w];
+            if (bv != bw && (bv == b || bw == b) && label[bv] == 1 && label[bw] == 1 &&
+                slack(e.v, w, e.k) + 2 * D == bestkey[b])
+                return true;
+        }
+        if (label[b] == 1 && isTop(b)) refreshS(b);
+        else h3.erase(b);
+        return false;
+    }
+
+    // ---- Greedy seed ----
+
+    // Two least slacks around each vertex (to different neighbors), for
+    // lowering duals without making any edge infeasible
+    std::vector<long long> min1, min2;
+    std::vector<int> arg1, arg2;
+
+    void noteSlack(int u, int x, long long s) {
+        if (x == arg1[u]) { if (s < min1[u]) min1[u] = s; return; }
+        if (x == arg2[u]) {
+            min2[u] = s;
+            if (min2[u] < min1[u]) { std::swap(min1[u], min2[u]); std::swap(arg1[u], arg2[u]); }
+            return;
+        }
+        if (s < min1[u]) { min2[u] = min1[u]; arg2[u] = arg1[u]; min1[u] = s; arg1[u] = x; }
+        else if (s < min2[u]) { min2[u] = s; arg2[u] = x; }
+    }
+
+    // Largest decrease of y[u] that keeps every edge but (u, except) feasible
+    long long room(int u, int except) const {
+        long long m = arg1[u] == except ? min2[u] : min1[u];
+        return std::min(m, y[u]);
+    }
+
+    void lower(int u, long long d) {
+        if (d == 0) return;
+        y[u] -= d;
+        const int* tg = adj.targets();
+        for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++) {
+            int x = tg[k];
+            noteSlack(x, u, y[x] + y[u] - cost(k));
+        }
+    }
+
+    // Lower y[u] and y[v] so that edge (u, v) = arc k is tight, and match it.
+    // False if the duals cannot get there.
+    bool tighten(int u, int v, int k) {
+        long long s = y[u] + y[v] - cost(k);
+        long long ru = room(u, v), rv = room(v, u);
+        if (ru + rv < s) return false;
+        // Split the decrease evenly, in even steps: all duals stay even, so
+        // the S vertices of different trees keep equal parity and delta3 is whole
+        long long dv = std::min(rv, (s / 2) & ~1LL);
+        long long du = s - dv;
+        if (du > ru) { du = ru; dv = s - ru; }
+        lower(u, du);
+        lower(v, dv);
+        mate[u] = v;
+        mate[v] = u;
+        return true;
+    }
+
+    int greedy_size = 0;
+    long long greedy_weight = 0;
+    double greedy_ms = 0;
+    int initial_kept = 0;
+
+    void seed(const matching::Matching* initial, bool greedy) {
+        MATCHING_STAT_TIMER(times.init);
+        auto start = std::chrono::steady_clock::now();
+        const int* tg = adj.targets();
+        // y = 4 * heaviest incident weight: every edge has slack >= 0
+        for (int u = 0; u < n; u++)
+            for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++)
+                y[u] = std::max(y[u], cost(k));
+        if (!greedy && !initial) return;
+        min1.assign(n, LLONG_MAX);
+        min2.assign(n, LLONG_MAX);
+        arg1.assign(n, NIL);
+        arg2.assign(n, NIL);
+        for (int u = 0; u < n; u++)
+            for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++)
+                noteSlack(u, tg[k], y[u] + y[tg[k]] - cost(k));
+
+        if (initial) {
+            for (const auto& e : *initial) {
+                int u = e.first, v = e.second;
+                if (u < 0 || v < 0 || u >= n || v >= n || u == v) continue;
+                if (mate[u] != NIL || mate[v] != NIL) continue;
+                int k = matching::find_arc(adj, u, v);
+                if (k >= 0 && tighten(u, v, k)) initial_kept++;
+            }
+        }
+        if (greedy) {
+            // Edges by descending weight, ties in arc order. Each edge is
+            // sorted as one key, (INT_MAX - weight, arc), from its u < v arc
+            std::vector<unsigned long long> order;
+            std::vector<int> from((size_t)adj.num_arcs());
+            order.reserve((size_t)adj.num_edges());
+            for (int u = 0; u < n; u++)
+                for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++) {
+                    from[k] = u;
+                    if (u < tg[k]) order.push_back((unsigned long long)(INT_MAX - wt[k]) << 32 | (unsigned)k);
+                }
+            std::sort(order.begin(), order.end());
+            for (unsigned long long key : order) {
+                int k = (int)(key & 0xFFFFFFFFu), u = from[k], v = tg[k];
+                if (mate[u] == NIL && mate[v] == NIL) tighten(u, v, k);
+            }
+            // Free vertices: lower each dual as far as its edges allow, and
+            // match a tight edge to another free vertex when one appears
+            for (int u = 0; u < n; u++) {
+                if (mate[u] != NIL) continue;
+                lower(u, room(u, NIL) & ~1LL);
+                if (y[u] == 0) continue;
+                for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++) {
+                    int v = tg[k];
+                    if (v != u && mate[v] == NIL && y[u] + y[v] == cost(k)) {
+                        mate[u] = v;
+                        mate[v] = u;
+                        break;
+                    }
+                }
+            }
+        }
+        std::vector<long long>().swap(min1);
+        std::vector<long long>().swap(min2);
+        std::vector<int>().swap(arg1);
+        std::vector<int>().swap(arg2);
+        for (int u = 0; u < n; u++) {
+            if (mate[u] <= u) continue;
+            greedy_size++;
+            greedy_weight += wt[matching::find_arc(adj, u, mate[u])];
+        }
+        greedy_ms = matching::ms_since(start);
+    }
+
+    // ---- Main solver ----
+
+    std::vector<std::pair<int,int>> solve(const matching::Matching* initial, bool greedy) {
+        seed(initial, greedy);
+        {
+            MATCHING_STAT_TIMER(times.search);
+            // Every free vertex with a positive dual roots a tree
+            for (int v = 0; v < n; v++) {
+                if (mate[v] == NIL && y[v] > 0) {
+                    assignLabel(v, 1, NIL);
+                    live++;
+                }
+            }
+            while (true) {
+                while (!queue.empty()) {
+                    int v = queue.back();
+                    queue.pop_back();
+                    if (label[inblossom[v]] != 1) continue; // stale
+                    scan(v);
+                }
+                if (live == 0) break;
+
+                // Largest feasible dual change. At a tie, freeing a vertex
+                // comes first, then an S-S edge (augmenting or shrinking
+                // before growing keeps trees from absorbing the paths that
+                // just dissolved), then growing, then expanding
+                while (!validVertex(h1.top())) {}
+                int kind = 1, b = h1.top();
+                long long delta = h1.top_key() - D;
+                while (!h3.empty() && !validS(h3.top())) {}
+                if (!h3.empty() && (h3.top_key() - 2 * D) / 2 < delta) {
+                    kind = 3; b = h3.top(); delta = (h3.top_key() - 2 * D) / 2;
+                }
+                while (!h2.empty() && !validUnlabeled(h2.top())) {}
+                if (!h2.empty() && h2.top_key() - D < delta) { kind = 2; b = h2.top(); delta = h2.top_key() - D; }
+                if (!h4.empty() && h4.top_key() - D < delta) { kind = 4; b = h4.top(); delta = h4.top_key() - D; }
+                D += delta;
+                MATCHING_STAT(stat_updates[kind - 1]++;)
+
+                if (kind == 1) {
+                    // S-vertex b reached dual 0: free it and retire its tree
+                    MATCHING_STAT(stat_retired++;)
+                    int r = tree[inblossom[b]];
+                    flipToRoot(b, NIL);
+                    dissolve(r);
+                } else if (kind == 2) {
+                    int u = h2_vertex[b];
+                    const EdgeRef e = bestedge[u];
+                    relax(other(e, u), u, e.k);
+                } else if (kind == 3) {
+                    const EdgeRef e = bestedge[b];
+                    relax(e.v, adj.targets()[e.k], e.k);
+                } else {
+                    expandBlossom(b);
+                }
+            }
+        }
+
+        std::vector<std::pair<int,int>> result;
+        for (int u = 0; u < n; u++)
+            if (mate[u] > u) result.push_back({u, mate[u]});
+        return result;
+    }
+
+    // ---- Optimality certificate ----
+
+    // Once every tree is gone all duals are exact. They prove the matching
+    // optimal if they are feasible (y >= 0, z >= 0, no edge with negative
+    // slack) and the dual objective equals the matching's weight:
+    // 4 w(M) == sum y + sum z (|b| - 1). An edge needs the z of the
+    // blossoms holding both its ends only if its ends' y fall short.
+    bool certify() const {
+        int nb = 2 * n;
+        std::vector<int> depth(nb, -1), size(nb, 0), order;
+        std::vector<long long> zsum(nb, 0);  // z of b and its ancestors
+        std::vector<int> chain;
+        for (int b = 0; b < nb; b++) {
+            if (b >= n && blossombase[b] == NIL) continue;
+            if (z[b] < 0) return false;
+            int x = b;
+            chain.clear();
+            while (x != NIL && depth[x] < 0) { chain.push_back(x); x = blossomparent[x]; }
+            for (int i = (int)chain.size() - 1; i >= 0; i--) {
+                int c = chain[i], p = blossomparent[c];
+                depth[c] = p == NIL ? 0 : depth[p] + 1;
+                zsum[c] = z[c] + (p == NIL ? 0 : zsum[p]);
+                order.push_back(c);
+            }
+        }
+        // order lists parents before children: sizes bottom-up
+        for (int i = (int)order.size() - 1; i >= 0; i--) {
+            int c = order[i];
+            if (c < n) size[c] = 1;
+            if (blossomparent[c] != NIL) size[blossomparent[c]] += size[c];
+        }
+        long long objective = 0;
+        for (int v = 0; v < n; v++) {
+            if (y[v] < 0) return false;
+            objective += y[v];
+        }
+        for (int b = n; b < nb; b++)
+            if (blossombase[b] != NIL) objective += z[b] * (size[b] - 1);
+
+        const int* tg = adj.targets();
+        long long weight = 0;
+        for (int u = 0; u < n; u++) {
+            for (int k = adj.adj_start(u); k < adj.adj_start(u + 1); k++) {
+                int v = tg[k];
+                if (v <= u) continue;
+                if (mate[u] == v) weight += wt[k];
+                long long s = y[u] + y[v] - cost(k);
+                if (s >= 0) continue;
+                // Deepest blossom holding both ends
+                int a = blossomparent[u], c = blossomparent[v];
+                while (a != c && a != NIL && c != NIL) {
+                    if (depth[a] >= depth[c]) a = blossomparent[a];
+                    else c = blossomparent[c];
+                }
+                if (a != c || s + 2 * zsum[a] < 0) return false;
+            }
+        }
+        return 4 * weight == objective;
+    }
+
+    // Counters and stage times for --stats=json
+    matching::Stats collect_stats() const {
+        matching::Stats st;
+        st.add("dual_updates", stat_updates[0] + stat_updates[1] + stat_updates[2] + stat_updates[3]);
+        st.add("delta_vertex", stat_updates[0]);
+        st.add("delta_grow", stat_updates[1]);
+        st.add("delta_shrink", stat_updates[2]);
+        st.add("delta_expand", stat_updates[3]);
+        st.add("arcs", stat_arcs);
+        st.add("blossoms_created", stat_created);
+        st.add("blossoms_expanded", stat_expanded);
+        st.add("augmentations", stat_paths);
+        st.add("retired", stat_retired);
+        st.add("heap_refreshes", stat_refreshed);
+        times.add_to(st);
+        return st;
+    }
+};
+
+/* Maximum weight matching of g, weight[k] per arc (weights.hpp). Seeds from
+   the greedy unless opt.greedy_mode is GREEDY_NONE; opt.initial pairs are
+   offered first. With `report`, also the weights and the dual check. */
+inline matching::Result solve(const matching::Graph& g, const std::vector<int>& weight,
+                              const matching::Options& opt = {}, Report* report = nullptr) {
+    Solver sol(g, weight);
+    matching::Result r;
+    r.matching = sol.solve(opt.initial, opt.greedy_mode != matching::GREEDY_NONE);
+    r.initial_size = sol.initial_kept;
+    r.greedy_size = sol.greedy_size;
+    r.greedy_ms = sol.greedy_ms;
+    MATCHING_STAT(r.stats = sol.collect_stats();)
+    if (report) {
+        report->weight = matching::matching_weight(g, weight, r.matching);
+        report->greedy_weight = sol.greedy_weight;
+        auto c0 = std::chrono::steady_clock::now();
+        report->certified = sol.certify();
+        report->certify_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - c0).count();
+    }
+    return r;
+}
+
+} // namespace weighted_blossom
@@ -16,7 +16,7 @@ ALGO_DIR="$SCRIPT_DIR/../algorithms/hopcroft-karp"
 # Compile C++
 echo "Compiling C++..."
 cd "$ALGO_DIR/cpp"
-g++ -O3 -std=c++17 hopcroft_karp.cpp -o hopcroft_karp_cpp
+g++ -O3 -std=c++17 -pthread -I../../../include hopcroft_karp.cpp -o hopcroft_karp_cpp
 if [ $? -ne 0 ]; then
     echo "C++ compilation failed!"
     exit 1
@@ -0,0 +1,356 @@
+/*
+ * matching_batch — solve many graphs in one process
+ *
+ * For workloads of many small and medium graphs, where starting one
+ * binary per graph costs more than the solve. Input is either
+ *
+ *   a manifest   one graph path per line (text or .csr, general or
+ *                bipartite); blank lines and lines starting with '#'
+ *                are skipped
+ *   --stream     text graphs back to back, each a "V E" or "L R E"
+ *                header line followed by its edge lines
+ *
+ * read from a file or, given "-", from stdin. Jobs are read as workers
+ * take them, so a producer can keep writing while results come out.
+ *
+ * --jobs workers (default: all cores) live for the whole batch in one
+ * ThreadPool. A worker takes the next job as soon as it is done with the
+ * last one: it loads the graph (manifest) or parses it off the stream
+ * (one worker at a time), solves it with matching::solve_graph(),
+ * validates the matching and prints its result line at once. Lines thus
+ * come out in completion order; the job column is the input order. Each
+ * worker keeps its edge list from job to job, so its capacity is reused,
+ * and for edmonds-opt, gabow-opt, mv-pure and hk the solver's arrays too
+ * (bench::Workspaces): a graph no larger than the worker's earlier ones
+ * allocates nothing. --fresh gives every solve new arrays instead, as a
+ * standalone run would; so does --components with --threads above 1,
+ * whose components are solved in parallel.
+ *
+ * General graphs go to --general (default mv-pure), bipartite ones to
+ * --bipartite (default hk), named as in solvers.hpp. Solver flags pass
+ * through as in matching_bench. --threads is per solve and defaults to 1,
+ * since the parallelism is across graphs. --pin compact|spread gives
+ * worker j the plan's CPU j (numa.hpp); it needs --threads 1, as a
+ * solve's own threads would take the same CPUs by their index.
+ *
+ * Output is a tab-separated header, then one line per graph:
+ *
+ *   job graph algo vertices edges matching load_ms solve_ms status
+ *
+ * With --json it is one JSON object per line instead. status is PASSED,
+ * FAILED (validation) or ERROR (the input could not be read). Stream
+ * graphs are named "<input>:<n>", n counting from 0. A summary with the
+ * throughput in graphs per second goes to stderr.
+ *
+ * A malformed stream ends the batch after the graphs before it. Exit
+ * status is 1 if any graph failed or could not be read.
+ *
+ * Usage:
+ *   matching_batch [--stream] [--jobs N] [--general ALGO] [--bipartite ALGO]
+ *                  [--json] [--fresh] [solver flags] <manifest|stream|->
+ *
+ * Build: g++ -O3 -std=c++17 -pthread -I../include matching_batch.cpp -o matching_batch
+ */
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "solvers.hpp"
+#include "matching/cli.hpp"
+#include "matching/components.hpp"
+#include "matching/io.hpp"
+#include "matching/parallel.hpp"
+#include "matching/validate.hpp"
+
+namespace {
+
+struct Config {
+    bool stream = false;
+    bool json = false;
+    bool fresh = false;   /* no workspace reuse */
+    int jobs = 0;
+    int general = bench::find_algo("mv-pure");
+    int bipartite = bench::find_algo("hk");
+    const char* input = nullptr;
+    std::vector<char*> solver_args;   /* argv for matching::parse_options */
+};
+
+bool parse_config(int argc, char* argv[], Config& c) {
+    static char prog[] = "matching_batch", input[] = "-";
+    c.solver_args = {prog, input};   /* parse_options reads flags from argv[2] */
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if ((a == "--general" || a == "--bipartite") && has_value) {
+            int k = bench::find_algo(argv[++i]);
+            if (k < 0 || bench::ALGOS[k].bipartite != (a == "--bipartite")) {
+                fprintf(stderr, "%s: no %s solver named %s\n", a.c_str(), a.c_str() + 2, argv[i]);
+                return false;
+            }
+            (a == "--general" ? c.general : c.bipartite) = k;
+        }
+        else if (a == "--jobs" && has_value) c.jobs = atoi(argv[++i]);
+        else if (a == "--stream") c.stream = true;
+        else if (a == "--json") c.json = true;
+        else if (a == "--fresh") c.fresh = true;
+        else if ((a == "--threads" || a == "--scan" || a == "--reorder" || a == "--epsilon" || a == "--numa" ||
+                  a == "--pin") && has_value) {
+            c.solver_args.push_back(argv[i]);
+            c.solver_args.push_back(argv[++i]);
+        }
+        else if (a == "--index64" || a == "--initial" || a == "--save-matching") {
+            fprintf(stderr, "%s is not supported by matching_batch\n", argv[i]);
+            return false;
+        }
+        else if (a.compare(0, 2, "--") == 0 && a.size() > 2) c.solver_args.push_back(argv[i]);
+        else if (!c.input) c.input = argv[i];
+        else { fprintf(stderr, "More than one input: %s\n", argv[i]); return false; }
+    }
+    return c.input != nullptr;
+}
+
+/* Buffered reader for manifest lines and stream graphs */
+class Reader {
+public:
+    explicit Reader(FILE* f) : f_(f), buf_(1 << 16) {}
+
+    /* Next line without its terminator; false at end of input */
+    bool line(std::string& s) {
+        s.clear();
+        int c = peek();
+        if (c == EOF) return false;
+        while ((c = get()) != EOF && c != '\n') s.push_back((char)c);
+        while (!s.empty() && matching::is_space_char(s.back())) s.pop_back();
+        return true;
+    }
+
+    /* Next integer across line breaks; false at end of input or on a
+       malformed token */
+    bool next(long long& x) {
+        int c;
+        while ((c = peek()) != EOF && matching::is_space_char((char)c)) pos_++;
+        return number(x);
+    }
+
+    /* Header of the next stream graph: the integers on the next non-blank
+       line. 1 on success, 0 at end of input, -1 if the line holds anything
+       but two or three integers. */
+    int header(long long h[3], int& fields) {
+        int c;
+        while ((c = peek()) != EOF && matching::is_space_char((char)c)) pos_++;
+        if (c == EOF) return 0;
+        fields = 0;
+        for (;;) {
+            while ((c = peek()) == ' ' || c == '\t' || c == '\r') pos_++;
+            if (c == EOF || c == '\n') break;
+            if (fields == 3 || !number(h[fields])) return -1;
+            fields++;
+        }
+        return fields >= 2 ? 1 : -1;
+    }
+
+private:
+    FILE* f_;
+    std::vector<char> buf_;
+    size_t pos_ = 0, len_ = 0;
+
+    int peek() {
+        if (pos_ == len_) {
+            len_ = fread(buf_.data(), 1, buf_.size(), f_);
+            pos_ = 0;
+            if (len_ == 0) return EOF;
+        }
+        return (unsigned char)buf_[pos_];
+    }
+
+    int get() {
+        int c = peek();
+        if (c != EOF) pos_++;
+        return c;
+    }
+
+    bool number(long long& x) {
+        int c = peek();
+        bool neg = c == '-';
+        if (c == '-' || c == '+') { pos_++; c = peek(); }
+        if (c < '0' || c > '9') return false;
+        long long v = 0;
+        while ((c = peek()) >= '0' && c <= '9') {
+            v = v * 10 + (c - '0');
+            pos_++;
+        }
+        c = peek();
+        if (c != EOF && !matching::is_space_char((char)c)) return false;
+        x = neg ? -v : v;
+        return true;
+    }
+};
+
+/* The next stream graph into `out`, reusing its edge storage. 1 on
+   success, 0 at end of input, -1 on malformed input (reported). */
+int read_stream_graph(Reader& r, matching::EdgeListFile& out, bool& bipartite, long long job) {
+    long long h[3];
+    int fields = 0;
+    int got = r.header(h, fields);
+    if (got == 0) return 0;
+    bool ok = got > 0;
+    for (int i = 0; i + 1 < fields && ok; i++) ok = h[i] >= 0 && h[i] < INT_MAX;
+    if (!ok || h[fields - 1] < 0) {
+        fprintf(stderr, "stream graph %lld: header is neither \"V E\" nor \"L R E\"\n", job);
+        return -1;
+    }
+    bipartite = fields == 3;
+    out.n = (int)h[0];
+    out.n_right = bipartite ? (int)h[1] : out.n;
+    long long m = h[fields - 1];
+    out.edges.clear();
+    for (long long e = 0; e < m; e++) {
+        long long u, v;
+        if (!r.next(u) || !r.next(v) || u < INT_MIN || u > INT_MAX || v < INT_MIN || v > INT_MAX) {
+            fprintf(stderr, "stream graph %lld: edge %lld of %lld is missing or malformed\n", job, e + 1, m);
+            return -1;
+        }
+        out.edges.push_back({(int)u, (int)v});
+    }
+    return 1;
+}
+
+/* One finished job */
+struct Outcome {
+    long long job = 0;
+    std::string graph;
+    const char* algo = "-";
+    int vertices = 0;
+    long long edges = 0;
+    int size = 0;
+    double load_ms = 0, solve_ms = 0;
+    const char* status = "ERROR";
+};
+
+void print_outcome(const Outcome& o, bool json) {
+    if (!json) {
+        printf("%lld\t%s\t%s\t%d\t%lld\t%d\t%.3f\t%.3f\t%s\n", o.job, o.graph.c_str(), o.algo, o.vertices,
+               o.edges, o.size, o.load_ms, o.solve_ms, o.status);
+        return;
+    }
+    printf("{\"job\": %lld, \"graph\": ", o.job);
+    bench::print_json_string(stdout, o.graph);
+    printf(", \"algo\": \"%s\", \"vertices\": %d, \"edges\": %lld, \"matching_size\": %d, "
+           "\"load_ms\": %.3f, \"solve_ms\": %.3f, \"status\": \"%s\"}\n", o.algo, o.vertices, o.edges,
+           o.size, o.load_ms, o.solve_ms, o.status);
+}
+
+double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Config c;
+    if (!parse_config(argc, argv, c)) {
+        fprintf(stderr, "Usage: %s [--stream] [--jobs N] [--general ALGO] [--bipartite ALGO] [--json] "
+                        "[--fresh] [solver flags] <manifest|stream|->\n", argv[0]);
+        return 1;
+    }
+    matching::Options opt;
+    opt.threads = 1;
+    matching::parse_options((int)c.solver_args.size(), c.solver_args.data(), opt);
+    bool reuse = !c.fresh && !(opt.components && matching::resolve_threads(opt.threads) > 1);
+    if (opt.pin != matching::PIN_NONE) {
+        if (matching::resolve_threads(opt.threads) > 1) {
+            fprintf(stderr, "--pin is not supported by matching_batch with --threads above 1\n");
+            return 1;
+        }
+        matching::apply_affinity(opt, matching::resolve_threads(c.jobs));
+    }
+
+    bool from_stdin = std::string(c.input) == "-";
+    FILE* f = from_stdin ? stdin : fopen(c.input, "rb");
+    if (!f) { fprintf(stderr, "Cannot open file: %s\n", c.input); return 1; }
+    std::string source = from_stdin ? "stdin" : c.input;
+    Reader reader(f);
+
+    std::mutex in_mu, out_mu;
+    long long next_job = 0, failed = 0;
+    bool input_done = false, stream_error = false;
+    if (!c.json) printf("job\tgraph\talgo\tvertices\tedges\tmatching\tload_ms\tsolve_ms\tstatus\n");
+
+    auto start = std::chrono::steady_clock::now();
+    matching::ThreadPool pool(c.jobs);
+    pool.run([&](int) {
+        matching::GraphInput in;   /* per worker; the edge list keeps its capacity */
+        bench::Workspaces ws;      /* and the solvers their arrays */
+        std::string path;
+        for (;;) {
+            Outcome o;
+            bool bipartite = false, loaded = false;
+            std::chrono::steady_clock::time_point t0;
+            {
+                std::lock_guard<std::mutex> lock(in_mu);
+                if (input_done) break;
+                t0 = std::chrono::steady_clock::now();
+                o.job = next_job;
+                if (c.stream) {
+                    in.binary = in.wide = false;
+                    int got = read_stream_graph(reader, in.text, bipartite, o.job);
+                    if (got <= 0) {
+                        input_done = true;
+                        stream_error = got < 0;
+                        break;
+                    }
+                    o.graph = source + ":" + std::to_string(o.job);
+                    loaded = true;
+                } else {
+                    bool have = false;
+                    while (!have && reader.line(path)) have = !path.empty() && path[0] != '#';
+                    if (!have) { input_done = true; break; }
+                    o.graph = path;
+                }
+                next_job++;
+            }
+
+            if (!loaded) {
+                int bip = bench::detect_bipartite(o.graph.c_str());
+                bipartite = bip == 1;
+                loaded = bip >= 0 && matching::read_graph_input(o.graph.c_str(), bipartite, in, opt.threads);
+            } else if (in.needs_wide(bipartite)) {
+                fprintf(stderr, "%s: too many arcs for 32-bit offsets\n", o.graph.c_str());
+                loaded = false;
+            }
+            if (loaded) {
+                const bench::Algo& algo = bench::ALGOS[bipartite ? c.bipartite : c.general];
+                matching::Graph g = matching::build_graph(in, bipartite, opt.threads);
+                o.algo = algo.name;
+                o.vertices = g.num_vertices();
+                o.edges = (long long)g.num_edges();
+                o.load_ms = ms_since(t0);
+                auto t1 = std::chrono::steady_clock::now();
+                matching::Result r = reuse && algo.solve_in
+                    ? matching::solve_graph(g, opt, [&](const matching::Graph& sub, const matching::Options& o) {
+                          return algo.solve_in(sub, ws, o);
+                      })
+                    : matching::solve_graph(g, opt, algo.solve);
+                o.solve_ms = ms_since(t1);
+                o.size = (int)r.matching.size();
+                o.status = matching::validate_matching(g, r.matching, false) == 0 ? "PASSED" : "FAILED";
+            }
+
+            std::lock_guard<std::mutex> lock(out_mu);
+            if (o.status[0] != 'P') failed++;
+            print_outcome(o, c.json);
+            fflush(stdout);
+        }
+    });
+    double secs = ms_since(start) / 1000.0;
+    if (!from_stdin) fclose(f);
+
+    fprintf(stderr, "Batch: %lld graphs, %lld failed, %.3f s, %.1f graphs/s (%d jobs)\n", next_job, failed,
+            secs, secs > 0 ? (double)next_job / secs : 0.0, pool.size());
+    return failed > 0 || stream_error ? 1 : 0;
+}
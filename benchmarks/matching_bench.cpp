@@ -0,0 +1,402 @@
+/*
+ * matching_bench — in-process benchmark harness for the C++ solvers
+ *
+ * Links every solver into one binary, loads each graph once and times
+ * repeated warm solves of it, so a measurement contains neither process
+ * start-up nor parsing nor a cold page cache, as the shell-driven runs in
+ * run_large_benchmarks.sh do. Per graph and algorithm:
+ *
+ *   1. --warmup untimed solves (default 1); the first result is
+ *      validated (validate.hpp, report block suppressed) and its size
+ *      checked against the other algorithms on the same graph
+ *   2. --reps timed solves (default 5), each bracketed by steady_clock
+ *      and, where the kernel allows, hardware counters (perf_counters.hpp)
+ *   3. median, mean, standard deviation, 95% confidence half-width of the
+ *      mean (Student t), min and max of the solve times; per-rep counters
+ *      are reduced to their median
+ *
+ * A solve is matching::solve_graph(), i.e. what a driver's "Time:" line
+ * covers, with the solver flags given here (--greedy, --components,
+ * --reorder, --compressed, --epsilon, ...). --threads defaults to 1, and
+ * the process is pinned to CPUs [--cpu, --cpu + threads) unless --no-pin,
+ * so repeated runs land on the same cores. --pin compact|spread (and
+ * --numa first-touch, which implies spread) pins each thread to its own
+ * CPU instead (numa.hpp), and --cpu is then unused. Graphs take 32-bit arc offsets; --index64,
+ * --initial and --save-matching are not supported here.
+ *
+ * --scaling times every (graph, algorithm) at a ladder of thread counts
+ * instead of --threads: 1, 2, 4, ... up to the CPUs of one NUMA node,
+ * then all CPUs of the first 2, 3, ... nodes, each thread pinned compact
+ * to its own CPU. After the rows of the ladder comes a table of median
+ * time, throughput in million edges per second, speedup over one thread
+ * and parallel efficiency, so that scaling across sockets reads next to
+ * scaling across the cores of one.
+ *
+ * Bipartite inputs (.csr with the bipartite flag, or a text file whose
+ * header has three fields) run hk and pf, general inputs the other seven.
+ *
+ * Usage:
+ *   matching_bench [--algos a,b,...] [--reps N] [--warmup N] [--cpu N]
+ *                  [--no-pin] [--scaling] [--no-counters] [--csv FILE] [--json FILE]
+ *                  [solver flags] <graph>...
+ *
+ *   algos: edmonds-simple edmonds-opt gabow-simple gabow-opt mv-pure hk pf
+ *          par-blossom weighted
+ *
+ * Exit status is 1 if any matching fails validation or sizes disagree
+ * (not checked with --epsilon, whose matchings need not be maximum).
+ *
+ * Build: g++ -O3 -std=c++17 -pthread -I../include matching_bench.cpp -o matching_bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "solvers.hpp"
+#include "matching/cli.hpp"
+#include "matching/components.hpp"
+#include "matching/io.hpp"
+#include "matching/numa.hpp"
+#include "matching/parallel.hpp"
+#include "matching/perf_counters.hpp"
+#include "matching/validate.hpp"
+
+namespace {
+
+using bench::Algo;
+using bench::ALGOS;
+using bench::NUM_ALGOS;
+using bench::detect_bipartite;
+using bench::find_algo;
+using bench::print_json_string;
+
+/* Two-sided 95% Student t quantiles for 1..30 degrees of freedom */
+const double T95[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+struct Config {
+    std::vector<int> algos;       /* indices into ALGOS; empty = all */
+    int reps = 5;
+    int warmup = 1;
+    int cpu = 0;
+    bool pin = true;
+    bool scaling = false;
+    bool counters = true;
+    const char* csv = nullptr;
+    const char* json = nullptr;
+    std::vector<const char*> graphs;
+    std::vector<char*> solver_args;   /* argv for matching::parse_options */
+};
+
+/* One (graph, algorithm) measurement */
+struct Row {
+    std::string graph;
+    const char* algo;
+    int vertices, right;
+    long long edges;
+    int threads;
+    int sockets;                      /* NUMA nodes the threads ran on, -1 = unpinned */
+    int size;
+    bool valid;
+    std::vector<long long> ns;        /* per timed rep */
+    long long counter[matching::PERF_EVENTS];   /* median per rep, -1 = NA */
+    double median, mean, stddev, ci95, min, max;
+};
+
+bool parse_config(int argc, char* argv[], Config& c) {
+    static char prog[] = "matching_bench", input[] = "-";
+    c.solver_args = {prog, input};   /* parse_options reads flags from argv[2] */
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--algos" && has_value) {
+            std::string list = argv[++i];
+            for (size_t pos = 0; pos <= list.size();) {
+                size_t end = list.find(',', pos);
+                if (end == std::string::npos) end = list.size();
+                std::string name = list.substr(pos, end - pos);
+                int k = find_algo(name);
+                if (k < 0) { fprintf(stderr, "Unknown algorithm: %s\n", name.c_str()); return false; }
+                c.algos.push_back(k);
+                pos = end + 1;
+            }
+        }
+        else if (a == "--reps" && has_value) c.reps = std::max(1, atoi(argv[++i]));
+        else if (a == "--warmup" && has_value) c.warmup = std::max(0, atoi(argv[++i]));
+        else if (a == "--cpu" && has_value) c.cpu = atoi(argv[++i]);
+        else if (a == "--no-pin") c.pin = false;
+        else if (a == "--scaling") c.scaling = true;
+        else if (a == "--no-counters") c.counters = false;
+        else if (a == "--csv" && has_value) c.csv = argv[++i];
+        else if (a == "--json" && has_value) c.json = argv[++i];
+        else if ((a == "--threads" || a == "--scan" || a == "--reorder" || a == "--epsilon" || a == "--numa" ||
+                  a == "--pin") && has_value) {
+            c.solver_args.push_back(argv[i]);
+            c.solver_args.push_back(argv[++i]);
+        }
+        else if (a == "--index64" || a == "--initial" || a == "--save-matching") {
+            fprintf(stderr, "%s is not supported by matching_bench\n", argv[i]);
+            return false;
+        }
+        else if (a.compare(0, 2, "--") == 0) c.solver_args.push_back(argv[i]);
+        else c.graphs.push_back(argv[i]);
+    }
+    if (c.algos.empty())
+        for (int a = 0; a < NUM_ALGOS; a++) c.algos.push_back(a);
+    return !c.graphs.empty();
+}
+
+long long median_of(std::vector<long long> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+void summarize(Row& r) {
+    int n = (int)r.ns.size();
+    double sum = 0;
+    for (long long x : r.ns) sum += (double)x;
+    r.mean = sum / n;
+    double sq = 0;
+    for (long long x : r.ns) sq += ((double)x - r.mean) * ((double)x - r.mean);
+    r.stddev = n > 1 ? std::sqrt(sq / (n - 1)) : 0.0;
+    double t = n < 2 ? 0.0 : n - 1 <= 30 ? T95[n - 2] : 1.96;
+    r.ci95 = n > 1 ? t * r.stddev / std::sqrt((double)n) : 0.0;
+    r.median = (double)median_of(r.ns);
+    r.min = (double)*std::min_element(r.ns.begin(), r.ns.end());
+    r.max = (double)*std::max_element(r.ns.begin(), r.ns.end());
+}
+
+/* Warm up, validate, then time c.reps solves of g */
+Row measure(const Config& c, const Algo& algo, const matching::Graph& g, const matching::Options& opt,
+            matching::PerfCounters* perf, const char* path) {
+    Row r;
+    r.graph = path;
+    r.algo = algo.name;
+    r.vertices = g.num_vertices();
+    r.right = g.num_right();
+    r.edges = (long long)g.num_edges();
+
+    matching::Result first = matching::solve_graph(g, opt, algo.solve);
+    r.size = (int)first.matching.size();
+    r.valid = matching::validate_matching(g, first.matching, false) == 0;
+    for (int w = 1; w < c.warmup; w++) matching::solve_graph(g, opt, algo.solve);
+
+    std::vector<long long> counts[matching::PERF_EVENTS];
+    for (int rep = 0; rep < c.reps; rep++) {
+        if (perf) perf->start();
+        auto t0 = std::chrono::steady_clock::now();
+        matching::Result res = matching::solve_graph(g, opt, algo.solve);
+        auto t1 = std::chrono::steady_clock::now();
+        long long ev[matching::PERF_EVENTS];
+        if (perf) perf->stop(ev);
+        r.ns.push_back((long long)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        if ((int)res.matching.size() != r.size) r.valid = false;
+        for (int e = 0; e < matching::PERF_EVENTS; e++)
+            if (perf && ev[e] >= 0) counts[e].push_back(ev[e]);
+    }
+    for (int e = 0; e < matching::PERF_EVENTS; e++)
+        r.counter[e] = (int)counts[e].size() == c.reps ? median_of(counts[e]) : -1;
+    summarize(r);
+    return r;
+}
+
+/* A --scaling step: thread count and the NUMA nodes it spans */
+struct Step {
+    int threads, sockets;
+};
+
+/* 1, 2, 4, ... threads up to the CPUs of the first node, then all CPUs
+   of the first 2, 3, ... nodes */
+std::vector<Step> scaling_steps() {
+    const matching::NumaTopology& topo = matching::numa_topology();
+    std::vector<Step> steps;
+    int per_node = (int)topo.node_cpus[0].size();
+    for (int t = 1; t < per_node; t *= 2) steps.push_back({t, 1});
+    steps.push_back({per_node, 1});
+    int total = per_node;
+    for (int k = 1; k < topo.nodes(); k++) {
+        total += (int)topo.node_cpus[k].size();
+        steps.push_back({total, k + 1});
+    }
+    return steps;
+}
+
+/* Nodes the pinned threads run on, -1 when they are not pinned */
+int pinned_sockets(const std::vector<int>& cpus) {
+    if (cpus.empty()) return -1;
+    std::vector<int> seen;
+    for (int cpu : cpus) {
+        int k = matching::numa_topology().node_of(cpu);
+        if (std::find(seen.begin(), seen.end(), k) == seen.end()) seen.push_back(k);
+    }
+    return (int)seen.size();
+}
+
+/* The ladder of one (graph, algorithm), rows[first, end) */
+void print_scaling(const std::vector<Row>& rows, size_t first) {
+    const Row& base = rows[first];
+    printf("\nScaling of %s on %s:\n", base.algo, base.graph.c_str());
+    printf("  %8s %8s %12s %10s %8s %10s\n", "threads", "sockets", "median_ms", "Medges/s", "speedup",
+           "efficiency");
+    for (size_t i = first; i < rows.size(); i++) {
+        const Row& r = rows[i];
+        double speedup = r.median > 0 ? base.median / r.median : 0.0;
+        printf("  %8d %8d %12.3f %10.2f %8.2f %9.0f%%\n", r.threads, r.sockets, r.median / 1e6,
+               r.median > 0 ? r.edges / (r.median / 1e3) : 0.0, speedup,
+               100.0 * speedup * base.threads / r.threads);
+    }
+    printf("\n");
+}
+
+void print_counter(FILE* f, long long v, const char* na) {
+    if (v >= 0) fprintf(f, "%lld", v);
+    else fprintf(f, "%s", na);
+}
+
+bool write_csv(const char* path, const std::vector<Row>& rows) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "Cannot open file for writing: %s\n", path); return false; }
+    fprintf(f, "graph,algo,vertices,right,edges,threads,sockets,reps,matching_size,median_ns,mean_ns,stddev_ns,"
+               "ci95_ns,min_ns,max_ns,cycles,cache_misses,branch_misses,validation\n");
+    for (const Row& r : rows) {
+        fprintf(f, "%s,%s,%d,%d,%lld,%d,", r.graph.c_str(), r.algo, r.vertices, r.right, r.edges, r.threads);
+        print_counter(f, r.sockets, "NA");
+        fprintf(f, ",%d,%d,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f", (int)r.ns.size(), r.size, r.median, r.mean,
+                r.stddev, r.ci95, r.min, r.max);
+        for (int e = 0; e < matching::PERF_EVENTS; e++) {
+            fprintf(f, ",");
+            print_counter(f, r.counter[e], "NA");
+        }
+        fprintf(f, ",%s\n", r.valid ? "PASSED" : "FAILED");
+    }
+    fclose(f);
+    return true;
+}
+
+bool write_json(const char* path, const std::vector<Row>& rows) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "Cannot open file for writing: %s\n", path); return false; }
+    fprintf(f, "[\n");
+    for (size_t i = 0; i < rows.size(); i++) {
+        const Row& r = rows[i];
+        fprintf(f, "  {\"graph\": ");
+        print_json_string(f, r.graph);
+        fprintf(f, ", \"algo\": \"%s\", \"vertices\": %d, \"right\": %d, \"edges\": %lld, \"threads\": %d, "
+                   "\"sockets\": ", r.algo, r.vertices, r.right, r.edges, r.threads);
+        print_counter(f, r.sockets, "null");
+        fprintf(f, ", \"matching_size\": %d, \"valid\": %s,\n", r.size, r.valid ? "true" : "false");
+        fprintf(f, "   \"median_ns\": %.0f, \"mean_ns\": %.0f, \"stddev_ns\": %.0f, \"ci95_ns\": %.0f, "
+                   "\"min_ns\": %.0f, \"max_ns\": %.0f,\n", r.median, r.mean, r.stddev, r.ci95, r.min, r.max);
+        fprintf(f, "   ");
+        for (int e = 0; e < matching::PERF_EVENTS; e++) {
+            fprintf(f, "\"%s\": ", matching::perf_event_name(e));
+            print_counter(f, r.counter[e], "null");
+            fprintf(f, ", ");
+        }
+        fprintf(f, "\"samples_ns\": [");
+        for (size_t k = 0; k < r.ns.size(); k++) fprintf(f, "%s%lld", k ? ", " : "", r.ns[k]);
+        fprintf(f, "]}%s\n", i + 1 < rows.size() ? "," : "");
+    }
+    fprintf(f, "]\n");
+    fclose(f);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Config c;
+    if (!parse_config(argc, argv, c)) {
+        fprintf(stderr, "Usage: %s [--algos a,b,...] [--reps N] [--warmup N] [--cpu N] [--no-pin] [--scaling] "
+                        "[--no-counters] [--csv FILE] [--json FILE] [solver flags] <graph>...\n", argv[0]);
+        return 1;
+    }
+    matching::Options opt;
+    opt.threads = 1;
+    matching::parse_options((int)c.solver_args.size(), c.solver_args.data(), opt);
+    int threads = matching::resolve_threads(opt.threads);
+
+    std::vector<Step> steps = {{threads, -1}};
+    if (c.scaling) {
+        steps = scaling_steps();
+    } else if (opt.pin != matching::PIN_NONE || opt.numa == matching::NUMA_FIRST_TOUCH) {
+        if (matching::apply_affinity(opt)) steps[0].sockets = pinned_sockets(matching::thread_cpus());
+    } else if (c.pin) {
+        if (!matching::pin_to_cpus(c.cpu, threads))
+            fprintf(stderr, "Could not pin to CPUs %d-%d; running unpinned\n", c.cpu, c.cpu + threads - 1);
+        else {
+            std::vector<int> range;
+            for (int t = 0; t < threads; t++) range.push_back(c.cpu + t);
+            steps[0].sockets = pinned_sockets(range);
+        }
+    }
+    matching::PerfCounters* perf = nullptr;
+    matching::PerfCounters counters;
+    if (c.counters) {
+        if (counters.any_available()) perf = &counters;
+        else fprintf(stderr, "Hardware counters unavailable (perf_event_paranoid?); reporting NA\n");
+    }
+
+    printf("%-32s %-15s %7s %10s %12s %10s %7s %14s %13s %13s\n", "graph", "algo", "threads", "size",
+           "median_ms", "ci95_ms", "cv%", "cycles", "cache_misses", "branch_misses");
+    std::vector<Row> rows;
+    bool ok = true;
+    for (const char* path : c.graphs) {
+        int bip = detect_bipartite(path);
+        if (bip < 0) { ok = false; continue; }
+        bool any = false;
+        for (int a : c.algos) any = any || ALGOS[a].bipartite == (bip == 1);
+        if (!any) continue;
+
+        matching::GraphInput in;
+        if (!matching::read_graph_input(path, bip == 1, in, opt.threads)) { ok = false; continue; }
+        matching::Graph g = matching::build_graph(in, bip == 1, opt.threads);
+
+        int expect = -1;
+        const char* expect_algo = nullptr;
+        for (int a : c.algos) {
+            if (ALGOS[a].bipartite != (bip == 1)) continue;
+            size_t first = rows.size();
+            for (const Step& s : steps) {
+                matching::Options step_opt = opt;
+                step_opt.threads = s.threads;
+                if (c.scaling && !matching::set_thread_cpus(matching::cpu_plan(s.threads, matching::PIN_COMPACT, s.sockets)))
+                    fprintf(stderr, "Could not pin %d threads; running unpinned\n", s.threads);
+                Row r = measure(c, ALGOS[a], g, step_opt, perf, path);
+                r.threads = s.threads;
+                r.sockets = s.sockets;
+                if (!r.valid) { fprintf(stderr, "%s: %s: VALIDATION FAILED\n", path, r.algo); ok = false; }
+                if (expect < 0) { expect = r.size; expect_algo = r.algo; }
+                else if (r.size != expect && !(opt.epsilon > 0)) {   /* --epsilon sizes may differ */
+                    fprintf(stderr, "%s: size mismatch, %s found %d, %s found %d\n", path, expect_algo, expect,
+                            r.algo, r.size);
+                    ok = false;
+                }
+                printf("%-32s %-15s %7d %10d %12.3f %10.3f %7.2f ", path, r.algo, r.threads, r.size,
+                       r.median / 1e6, r.ci95 / 1e6, r.mean > 0 ? 100.0 * r.stddev / r.mean : 0.0);
+                for (int e = 0; e < matching::PERF_EVENTS; e++) {
+                    if (r.counter[e] >= 0) printf(" %13lld", r.counter[e]);
+                    else printf(" %13s", "NA");
+                }
+                printf("\n");
+                fflush(stdout);
+                rows.push_back(r);
+            }
+            if (c.scaling) print_scaling(rows, first);
+        }
+    }
+
+    if (c.csv && !write_csv(c.csv, rows)) ok = false;
+    if (c.json && !write_json(c.json, rows)) ok = false;
+    return ok ? 0 : 1;
+}
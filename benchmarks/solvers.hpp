@@ -0,0 +1,123 @@
+/*
+ * What the programs linking every C++ solver share (matching_bench,
+ * matching_batch): the solvers by name, the graph-kind check that picks
+ * which of them apply to an input, and JSON string output.
+ *
+ * The solvers with a Workspace (matching/workspace.hpp) also have a
+ * solve_in entry, for callers that keep one Workspaces per thread.
+ *
+ * Names are the ones run_large_benchmarks.sh uses.
+ */
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "../algorithms/edmonds-blossom-optimized/cpp/edmonds_blossom_optimized.hpp"
+#include "../algorithms/edmonds-blossom-simple/cpp/edmonds_blossom_simple.hpp"
+#include "../algorithms/gabow-optimized/cpp/gabow_optimized.hpp"
+#include "../algorithms/gabow-simple/cpp/gabow_simple.hpp"
+#include "../algorithms/hopcroft-karp/cpp/hopcroft_karp.hpp"
+#include "../algorithms/micali-vazirani-pure/cpp/micali_vazirani_pure.hpp"
+#include "../algorithms/parallel-blossom/cpp/parallel_blossom.hpp"
+#include "../algorithms/pothen-fan/cpp/pothen_fan.hpp"
+#include "../algorithms/weighted-blossom/cpp/weighted_blossom.hpp"
+#include "matching/binary_format.hpp"
+#include "matching/solver.hpp"
+#include "matching/text_parser.hpp"
+#include "matching/weights.hpp"
+
+namespace bench {
+
+using SolveFn = matching::Result (*)(const matching::Graph&, const matching::Options&);
+
+/* One workspace per solver that has one; serves one solve at a time */
+struct Workspaces {
+    edmonds_blossom_optimized::Workspace edmonds_opt;
+    gabow_optimized::Workspace gabow_opt;
+    micali_vazirani_pure::Workspace<int> mv_pure;
+    hopcroft_karp::Workspace<int> hk;
+};
+
+using SolveInFn = matching::Result (*)(const matching::Graph&, Workspaces&, const matching::Options&);
+
+struct Algo {
+    const char* name;
+    bool bipartite;
+    SolveFn solve;
+    SolveInFn solve_in;   /* solve() in a kept workspace, or nullptr */
+};
+
+inline matching::Result edmonds_opt_in(const matching::Graph& g, Workspaces& w, const matching::Options& opt) {
+    return edmonds_blossom_optimized::solve_in(g, w.edmonds_opt, opt);
+}
+inline matching::Result gabow_opt_in(const matching::Graph& g, Workspaces& w, const matching::Options& opt) {
+    return gabow_optimized::solve_in(g, w.gabow_opt, opt);
+}
+inline matching::Result mv_pure_in(const matching::Graph& g, Workspaces& w, const matching::Options& opt) {
+    return micali_vazirani_pure::solve_in(g, w.mv_pure, opt);
+}
+inline matching::Result hk_in(const matching::Graph& g, Workspaces& w, const matching::Options& opt) {
+    return hopcroft_karp::solve_in(g, w.hk, opt);
+}
+
+/* The weighted engine on unit weights, so its sizes check against the
+   others; building the weights is part of the solve */
+inline matching::Result weighted_unit(const matching::Graph& g, const matching::Options& opt) {
+    return weighted_blossom::solve(g, matching::generated_arc_weights(g, matching::WEIGHTS_UNIT, 1), opt);
+}
+
+const Algo ALGOS[] = {
+    {"edmonds-simple", false, edmonds_blossom_simple::solve, nullptr},
+    {"edmonds-opt", false, edmonds_blossom_optimized::solve, edmonds_opt_in},
+    {"gabow-simple", false, gabow_simple::solve, nullptr},
+    {"gabow-opt", false, gabow_optimized::solve, gabow_opt_in},
+    {"mv-pure", false, micali_vazirani_pure::solve<int>, mv_pure_in},
+    {"hk", true, hopcroft_karp::solve<int>, hk_in},
+    {"pf", true, pothen_fan::solve, nullptr},
+    {"par-blossom", false, parallel_blossom::solve, nullptr},
+    {"weighted", false, weighted_unit, nullptr},
+};
+const int NUM_ALGOS = (int)(sizeof(ALGOS) / sizeof(ALGOS[0]));
+
+/* Index into ALGOS, or -1 */
+inline int find_algo(const std::string& name) {
+    for (int a = 0; a < NUM_ALGOS; a++)
+        if (name == ALGOS[a].name) return a;
+    return -1;
+}
+
+/* 1 bipartite, 0 general, -1 unreadable: the .csr header flag, or the
+   number of fields on a text file's header line */
+inline int detect_bipartite(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) { fprintf(stderr, "Cannot open file: %s\n", path); return -1; }
+    int result = -1;
+    if (matching::is_binary_graph(path)) {
+        matching::BinaryHeader h;
+        if (fread(&h, sizeof h, 1, f) == 1) result = (h.flags & matching::BINARY_FLAG_BIPARTITE) != 0;
+    } else {
+        char line[256];
+        if (fgets(line, sizeof line, f)) {
+            int fields = 0;   /* whitespace-separated tokens; no strtok, callers may be threads */
+            for (const char* p = line; *p; p++)
+                if (!matching::is_space_char(*p) && (p == line || matching::is_space_char(p[-1]))) fields++;
+            if (fields == 2 || fields == 3) result = fields == 3;
+        }
+        if (result < 0) fprintf(stderr, "%s: header is neither \"V E\" nor \"L R E\"\n", path);
+    }
+    fclose(f);
+    return result;
+}
+
+/* Paths are written as given; backslashes and quotes are escaped */
+inline void print_json_string(FILE* f, const std::string& s) {
+    fputc('"', f);
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') fputc('\\', f);
+        fputc(ch, f);
+    }
+    fputc('"', f);
+}
+
+} // namespace bench
@@ -0,0 +1,252 @@
+/*
+ * Binary CSR graph format (.csr) — written once by tools/graph_convert,
+ * then memory-mapped by every solver with zero copy.
+ *
+ * Layout (little-endian):
+ *
+ *   offset 0    BinaryHeader (64 bytes)
+ *   offset 64   offsets[n + 1], int32 (int64 with BINARY_FLAG_WIDE)
+ *   ...         padding to an 8-byte boundary
+ *   ...         int32 targets[num_arcs]
+ *
+ * Neighbor lists are stored sorted and deduplicated, exactly as
+ * Graph::general / Graph::bipartite would build them, so loading does
+ * no sort/unique pass and solver results are identical to text input.
+ * General graphs store both arc directions; bipartite graphs store
+ * left -> right arcs only.
+ *
+ * Graphs with more than 2^31 - 1 arcs are written wide and map as a
+ * Graph64 only. A file that fits int32 offsets is always written narrow,
+ * as version 1, so older builds keep reading it.
+ *
+ * Version history:
+ *   1  int32 offsets and targets
+ *   2  BINARY_FLAG_WIDE: int64 offsets
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graph.hpp"
+
+namespace matching {
+
+static const char BINARY_MAGIC[8] = {'M', 'A', 'T', 'C', 'H', 'C', 'S', 'R'};
+static const uint32_t BINARY_VERSION = 2;
+static const uint32_t BINARY_FLAG_BIPARTITE = 1u << 0;
+static const uint32_t BINARY_FLAG_WIDE = 1u << 1;   /* int64 offsets, version 2 */
+
+struct BinaryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t n;              /* vertices, or left vertices when bipartite */
+    uint64_t n_right;        /* right vertices (== n for general graphs) */
+    uint64_t num_arcs;       /* length of targets[] */
+    uint64_t offsets_pos;    /* byte position of offsets[] */
+    uint64_t targets_pos;    /* byte position of targets[] */
+    uint64_t reserved;
+};
+static_assert(sizeof(BinaryHeader) == 64, "BinaryHeader must stay 64 bytes");
+
+inline bool is_binary_graph(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char magic[8];
+    bool ok = fread(magic, 1, 8, f) == 8 && memcmp(magic, BINARY_MAGIC, 8) == 0;
+    fclose(f);
+    return ok;
+}
+
+/* True for a binary graph written with 64-bit offsets */
+inline bool is_wide_binary_graph(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    BinaryHeader h;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, BINARY_MAGIC, 8) == 0 &&
+              (h.flags & BINARY_FLAG_WIDE) != 0;
+    fclose(f);
+    return ok;
+}
+
+/* Write g in binary format, narrow whenever its arcs fit int32 offsets.
+   Returns false (with a message) on I/O error. */
+template <class Arc>
+inline bool write_binary_graph(const char* path, const BasicGraph<Arc>& g) {
+    bool wide = needs_wide_offsets((size_t)g.num_arcs());
+    size_t offset_size = wide ? sizeof(int64_t) : sizeof(int32_t);
+    BinaryHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, BINARY_MAGIC, 8);
+    h.version = wide ? BINARY_VERSION : 1;
+    h.flags = (g.is_bipartite() ? BINARY_FLAG_BIPARTITE : 0) | (wide ? BINARY_FLAG_WIDE : 0);
+    h.n = (uint64_t)g.num_vertices();
+    h.n_right = (uint64_t)g.num_right();
+    h.num_arcs = (uint64_t)g.num_arcs();
+    h.offsets_pos = sizeof(BinaryHeader);
+    uint64_t offsets_end = h.offsets_pos + (h.n + 1) * offset_size;
+    h.targets_pos = (offsets_end + 7) & ~(uint64_t)7;
+
+    /* Offsets in the file's width; a copy only when it differs from Arc */
+    std::vector<int32_t> narrow;
+    std::vector<int64_t> wide_copy;
+    const void* offsets = g.offsets();
+    if (offset_size != sizeof(Arc)) {
+        if (wide) { wide_copy.assign(g.offsets(), g.offsets() + h.n + 1); offsets = wide_copy.data(); }
+        else { narrow.assign(g.offsets(), g.offsets() + h.n + 1); offsets = narrow.data(); }
+    }
+
+    FILE* f = fopen(path, "wb");
+    if (!f) { fprintf(stderr, "Cannot open file for writing: %s\n", path); return false; }
+    static const char pad[8] = {0};
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+              fwrite(offsets, offset_size, h.n + 1, f) == h.n + 1 &&
+              fwrite(pad, 1, h.targets_pos - offsets_end, f) == h.targets_pos - offsets_end &&
+              (h.num_arcs == 0 ||
+               fwrite(g.targets(), sizeof(int32_t), h.num_arcs, f) == h.num_arcs);
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) fprintf(stderr, "Write failed: %s\n", path);
+    return ok;
+}
+
+/* Read-only private mapping of a whole file; unmapped when the last
+   Graph sharing it goes away. */
+struct MappedFile {
+    void* addr = MAP_FAILED;
+    size_t size = 0;
+    ~MappedFile() { if (addr != MAP_FAILED) munmap(addr, size); }
+};
+
+namespace detail {
+
+/* mmap a .csr file and check its header against the file size */
+inline bool map_binary_file(const char* path, std::shared_ptr<MappedFile>& mf, BinaryHeader& h) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "Cannot open file: %s\n", path); return false; }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(BinaryHeader)) {
+        fprintf(stderr, "Bad binary graph (truncated header): %s\n", path);
+        close(fd);
+        return false;
+    }
+    mf = std::make_shared<MappedFile>();
+    mf->size = (size_t)st.st_size;
+    mf->addr = mmap(nullptr, mf->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mf->addr == MAP_FAILED) { fprintf(stderr, "mmap failed: %s\n", path); return false; }
+
+    const char* base = (const char*)mf->addr;
+    memcpy(&h, base, sizeof(h));
+    if (memcmp(h.magic, BINARY_MAGIC, 8) != 0) {
+        fprintf(stderr, "Not a binary graph file: %s\n", path);
+        return false;
+    }
+    if (h.version < 1 || h.version > BINARY_VERSION) {
+        fprintf(stderr, "Unsupported binary graph version %u (expected 1-%u): %s\n",
+                h.version, BINARY_VERSION, path);
+        return false;
+    }
+    bool wide = (h.flags & BINARY_FLAG_WIDE) != 0;
+    uint64_t offset_size = wide ? 8 : 4;
+    uint64_t max_arcs = wide ? (uint64_t)INT64_MAX / 4 : (uint64_t)INT32_MAX;
+    if ((wide && h.version < 2) ||
+        h.n > INT32_MAX - 1 || h.n_right > INT32_MAX || h.num_arcs > max_arcs ||
+        h.offsets_pos % offset_size != 0 || h.targets_pos % 4 != 0 ||
+        h.offsets_pos + (h.n + 1) * offset_size > mf->size ||
+        h.targets_pos + h.num_arcs * 4 > mf->size) {
+        fprintf(stderr, "Bad binary graph (header does not match file size): %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+/* One O(n + m) pass over the mapped arrays, so a truncated or corrupt
+   file fails here instead of sending a solver out of bounds: offsets run
+   from 0 to num_arcs without decreasing, and every target is a vertex of
+   the other side (bipartite) or of the graph */
+template <class Arc>
+inline bool check_offsets(const char* path, const Arc* offsets, const int* targets, const BinaryHeader& h,
+                          int threads) {
+    bool ok = offsets[0] == 0 && (uint64_t)offsets[h.n] == h.num_arcs;
+    if (ok) {
+        uint64_t n = h.n, m = h.num_arcs;
+        int bound = (int)((h.flags & BINARY_FLAG_BIPARTITE) ? h.n_right : h.n);
+        int parts = threads_for(n + m, threads);
+        std::vector<char> good(parts, 1);
+        run_parallel(parts, [&](int t) {
+            for (uint64_t u = chunk_begin(n, parts, t), end = chunk_begin(n, parts, t + 1); u < end; u++)
+                if (offsets[u] > offsets[u + 1]) { good[t] = 0; return; }
+            for (uint64_t a = chunk_begin(m, parts, t), end = chunk_begin(m, parts, t + 1); a < end; a++)
+                if (targets[a] < 0 || targets[a] >= bound) { good[t] = 0; return; }
+        });
+        for (char g : good) ok = ok && g;
+    }
+    if (!ok) {
+        fprintf(stderr, "Bad binary graph (corrupt offsets): %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/* mmap a .csr file and wrap it as a Graph without copying, after
+   checking its arrays on `threads` threads (0 = all). Wide files are
+   rejected: they need Graph64. */
+inline bool map_binary_graph(const char* path, Graph& out, int threads = 0) {
+    std::shared_ptr<MappedFile> mf;
+    BinaryHeader h;
+    if (!detail::map_binary_file(path, mf, h)) return false;
+    if (h.flags & BINARY_FLAG_WIDE) {
+        fprintf(stderr, "%s: %llu arcs need 64-bit offsets, which this solver does not support\n",
+                path, (unsigned long long)h.num_arcs);
+        return false;
+    }
+    const char* base = (const char*)mf->addr;
+    const int* offsets = (const int*)(base + h.offsets_pos);
+    const int* targets = (const int*)(base + h.targets_pos);
+    if (!detail::check_offsets(path, offsets, targets, h, threads)) return false;
+    out = Graph::view((int)h.n, (int)h.n_right, (h.flags & BINARY_FLAG_BIPARTITE) != 0,
+                      (int)h.num_arcs, offsets, targets, mf);
+    return true;
+}
+
+/* Graph64 from either width: wide files zero-copy, narrow ones with their
+   offsets widened into a private array (targets stay mapped). */
+inline bool map_binary_graph(const char* path, Graph64& out, int threads = 0) {
+    std::shared_ptr<MappedFile> mf;
+    BinaryHeader h;
+    if (!detail::map_binary_file(path, mf, h)) return false;
+    const char* base = (const char*)mf->addr;
+    const int* targets = (const int*)(base + h.targets_pos);
+    bool bipartite = (h.flags & BINARY_FLAG_BIPARTITE) != 0;
+    if (h.flags & BINARY_FLAG_WIDE) {
+        const int64_t* offsets = (const int64_t*)(base + h.offsets_pos);
+        if (!detail::check_offsets(path, offsets, targets, h, threads)) return false;
+        out = Graph64::view((int)h.n, (int)h.n_right, bipartite, (int64_t)h.num_arcs, offsets, targets, mf);
+        return true;
+    }
+    const int* narrow = (const int*)(base + h.offsets_pos);
+    if (!detail::check_offsets(path, narrow, targets, h, threads)) return false;
+    struct Widened {
+        std::shared_ptr<MappedFile> file;
+        std::vector<int64_t> offsets;
+    };
+    auto w = std::make_shared<Widened>();
+    w->file = mf;
+    w->offsets.assign(narrow, narrow + h.n + 1);
+    out = Graph64::view((int)h.n, (int)h.n_right, bipartite, (int64_t)h.num_arcs,
+                        w->offsets.data(), targets, w);
+    return true;
+}
+
+} // namespace matching
@@ -0,0 +1,149 @@
+/*
+ * Command-line plumbing shared by the solver binaries: option parsing
+ * and the trailing summary lines the benchmark scripts grep for
+ * ("Matching size:", "Approximation:", "Initial kept:", "Greedy init size:", "Greedy/Final:",
+ * "Greedy init time:", "Load time:", "Reorder time:", "Graph memory:",
+ * "Compress time:", "Time:", "Stats:"). "Load time:" covers reading the input and
+ * building the CSR; "Reorder time:" covers --reorder (ordering, relabeling,
+ * mapping the matching back); "Compress time:" covers encoding the rows
+ * for --compressed; "Time:" covers the solve alone, including the initial
+ * matching that "Greedy init time:" breaks out. "Stats:" is the
+ * --stats=json object (stats.hpp). "Approximation:" comes with --epsilon:
+ * the guaranteed fraction of a maximum matching and the upper bound on
+ * its size that follows, or "exact" when the solve ran to the end.
+ */
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "frontier_scan.hpp"
+#include "numa.hpp"
+#include "solver.hpp"
+#include "warm_start.hpp"
+
+namespace matching {
+
+static const char* const USAGE_FLAGS = "[--greedy|--greedy-md|--karp-sipser] [--threads N] [--deterministic] [--components] [--initial FILE] [--save-matching FILE] [--reorder rcm|degree|bfs] [--compressed] [--index64] [--stats=json] [--epsilon E] [--numa first-touch|interleave] [--pin compact|spread]";
+
+/* --scan is read by Hopcroft-Karp's BFS kernels and, with --compressed, by
+   the row decoder (HK and MV-pure); only those drivers list it */
+static const char* const SCAN_USAGE = "[--scan auto|scalar|avx2|avx512]";
+
+/* --scan value; unknown names mean auto */
+inline int parse_scan(const std::string& s) {
+    if (s == "scalar") return SCAN_SCALAR;
+    if (s == "avx2") return SCAN_AVX2;
+    if (s == "avx512") return SCAN_AVX512;
+    return SCAN_AUTO;
+}
+
+/* --reorder value; unknown names mean no reordering */
+inline int parse_reorder(const std::string& s) {
+    if (s == "rcm") return REORDER_RCM;
+    if (s == "degree") return REORDER_DEGREE;
+    if (s == "bfs") return REORDER_BFS;
+    return REORDER_NONE;
+}
+
+/* --pin value; unknown names mean no pinning */
+inline int parse_pin(const std::string& s) {
+    if (s == "compact") return PIN_COMPACT;
+    if (s == "spread") return PIN_SPREAD;
+    return PIN_NONE;
+}
+
+/* --numa value; unknown names mean no placement */
+inline int parse_numa(const std::string& s) {
+    if (s == "first-touch") return NUMA_FIRST_TOUCH;
+    if (s == "interleave") return NUMA_INTERLEAVE;
+    return NUMA_NONE;
+}
+
+/* argv[1] is the input file; flags follow. Unknown flags are ignored. */
+inline void parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 2; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "--greedy") opt.greedy_mode = GREEDY_FIRST;
+        else if (a == "--greedy-md") opt.greedy_mode = GREEDY_MIN_DEGREE;
+        else if (a == "--karp-sipser") opt.greedy_mode = GREEDY_KARP_SIPSER;
+        else if (a == "--threads" && i + 1 < argc) opt.threads = atoi(argv[++i]);
+        else if (a == "--deterministic") opt.deterministic = true;
+        else if (a == "--components") opt.components = true;
+        else if (a == "--scan" && i + 1 < argc) opt.scan = parse_scan(argv[++i]);
+        else if (a == "--reorder" && i + 1 < argc) opt.reorder = parse_reorder(argv[++i]);
+        else if (a == "--compressed") opt.compressed = true;
+        else if (a == "--index64") opt.index64 = true;
+        else if (a == "--stats=json") opt.stats_json = true;
+        else if (a == "--epsilon" && i + 1 < argc) opt.epsilon = atof(argv[++i]);
+        else if (a == "--numa" && i + 1 < argc) opt.numa = parse_numa(argv[++i]);
+        else if (a == "--pin" && i + 1 < argc) opt.pin = parse_pin(argv[++i]);
+        else if ((a == "--initial" || a == "--save-matching") && i + 1 < argc) i++;  /* load_initial, save_matching */
+    }
+}
+
+/* Value of `--flag VALUE` in argv, or nullptr */
+inline const char* flag_value(int argc, char* argv[], const char* flag) {
+    for (int i = 2; i + 1 < argc; i++)
+        if (std::string(argv[i]) == flag) return argv[i + 1];
+    return nullptr;
+}
+
+/* --initial FILE: read the prior matching into `prior` and point
+   opt.initial at it. False if the file cannot be read. */
+inline bool load_initial(int argc, char* argv[], Options& opt, Matching& prior) {
+    const char* path = flag_value(argc, argv, "--initial");
+    if (!path) return true;
+    if (!read_matching(path, prior, opt.threads)) return false;
+    opt.initial = &prior;
+    return true;
+}
+
+/* --save-matching FILE: write the result for a later --initial run */
+inline bool save_matching(int argc, char* argv[], const Result& r) {
+    const char* path = flag_value(argc, argv, "--save-matching");
+    return !path || write_matching(path, r.matching);
+}
+
+inline void print_summary(const Options& opt, const Result& r, long load_ms, long solve_ms) {
+    printf("Matching size: %d\n", (int)r.matching.size());
+    if (opt.epsilon > 0) {
+        if (r.path_bound == 0) {
+            printf("Approximation: exact\n");
+        } else {
+            long long size = (long long)r.matching.size(), k = (r.path_bound - 1) / 2;
+            printf("Approximation: >= %.4f of maximum, maximum <= %lld (augmenting paths >= %d edges)\n",
+                   (double)k / (k + 1), size + size / k, r.path_bound);
+        }
+    }
+    if (opt.initial) printf("Initial kept: %d of %d\n", r.initial_size, (int)opt.initial->size());
+
+    if (opt.greedy_mode != GREEDY_NONE) {
+        int gs = r.greedy_size;
+        int fs = (int)r.matching.size();
+        printf("Greedy init size: %d\n", gs);
+        if (fs > 0) printf("Greedy/Final: %.2f%%\n", 100.0 * gs / fs);
+        else printf("Greedy/Final: NA\n");
+        printf("Greedy init time: %.1f ms\n", r.greedy_ms);
+    }
+    if (opt.components) printf("Components: %d\n", r.components);
+    printf("Load time: %ld ms\n", load_ms);
+    if (opt.reorder != REORDER_NONE) {
+        printf("Reorder time: %.1f ms\n", r.reorder_ms);
+        solve_ms -= (long)(r.reorder_ms + 0.5);
+    }
+    if (opt.compressed && r.compressed_bytes > 0) {
+        printf("Graph memory: %lld bytes CSR, %lld bytes compressed (%.1f%%)\n",
+               r.csr_bytes, r.compressed_bytes, 100.0 * r.compressed_bytes / r.csr_bytes);
+        printf("Compress time: %.1f ms\n", r.compress_ms);
+        solve_ms -= (long)(r.compress_ms + 0.5);
+    }
+    printf("Time: %ld ms\n", solve_ms);
+    if (opt.stats_json) {
+        if (!STATS_ENABLED) fprintf(stderr, "--stats=json: built without -DMATCHING_STATS=1, no counters\n");
+        print_stats(r.stats);
+    }
+}
+
+} // namespace matching
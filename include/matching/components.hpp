@@ -0,0 +1,266 @@
+/*
+ * Connected-component decomposition (--components).
+ *
+ * A maximum matching of a graph is the union of maximum matchings of its
+ * connected components. For inputs that fall apart into many pieces,
+ * solving each piece on its own CSR keeps per-phase resets and scans
+ * proportional to the piece instead of to n, and lets pieces run
+ * concurrently.
+ *
+ * Components are labeled by a CAS union-find over the arcs, always
+ * linking the larger root below the smaller one, so each label is the
+ * component's minimum vertex, the same for every thread count. Vertices are
+ * then relabeled contiguously per component, ascending, which keeps
+ * every neighbor list sorted in the subgraph.
+ *
+ * Components with edges are ordered by arc count, largest first. A
+ * component holding at least half of the arcs is solved alone, with all
+ * threads. The rest go to a shared counter in that order; each idle
+ * thread takes the next one and solves it single-threaded, so one long
+ * component cannot end up queued behind many short ones. Matchings are
+ * mapped back to the original vertex ids and merged.
+ *
+ * A prior matching (Options::initial) is split the same way; pairs that
+ * straddle components cannot be edges and are dropped.
+ *
+ * The matching size does not depend on the decomposition, but the
+ * matching itself may differ from a whole-graph solve.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "graph.hpp"
+#include "numa.hpp"
+#include "parallel.hpp"
+#include "reorder.hpp"
+#include "solver.hpp"
+
+namespace matching {
+
+struct ComponentSplit {
+    int count = 0;               /* components with at least one edge */
+    std::vector<int> order;      /* vertices grouped by component, ascending within each */
+    std::vector<int> start;      /* component c owns order[start[c] .. start[c + 1]) */
+    std::vector<long long> arcs; /* arcs leaving vertices of component c */
+};
+
+namespace detail {
+
+inline int uf_find(std::atomic<int>* parent, int x) {
+    for (;;) {
+        int p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        int gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);  /* path halving */
+        x = gp;
+    }
+}
+
+inline void uf_unite(std::atomic<int>* parent, int a, int b) {
+    for (;;) {
+        a = uf_find(parent, a);
+        b = uf_find(parent, b);
+        if (a == b) return;
+        if (a < b) std::swap(a, b);
+        int expect = a;
+        if (parent[a].compare_exchange_strong(expect, b, std::memory_order_relaxed)) return;
+    }
+}
+
+} // namespace detail
+
+/* Label the components of g. Bipartite graphs number right vertex v as
+   num_vertices() + v. Isolated vertices are left out. */
+template <class G>
+inline ComponentSplit split_components(const G& g, int threads = 0) {
+    int left = g.num_vertices();
+    int nv = g.is_bipartite() ? left + g.num_right() : left;
+    int shift = g.is_bipartite() ? left : 0;
+    int T = threads_for((size_t)nv + g.num_arcs(), threads);
+
+    std::unique_ptr<std::atomic<int>[]> parent(new std::atomic<int>[nv > 0 ? nv : 1]);
+    run_parallel(T, [&](int t) {
+        for (int v = (int)chunk_begin(nv, T, t); v < (int)chunk_begin(nv, T, t + 1); v++)
+            parent[v].store(v, std::memory_order_relaxed);
+    });
+    run_parallel(T, [&](int t) {
+        for (int u = (int)chunk_begin(left, T, t); u < (int)chunk_begin(left, T, t + 1); u++)
+            for (int v : g.neighbors(u))
+                if (v + shift > u) detail::uf_unite(parent.get(), u, v + shift);
+    });
+
+    /* Root = minimum vertex; number components in root order */
+    std::vector<int> root(nv), id(nv, NIL);
+    run_parallel(T, [&](int t) {
+        for (int v = (int)chunk_begin(nv, T, t); v < (int)chunk_begin(nv, T, t + 1); v++)
+            root[v] = detail::uf_find(parent.get(), v);
+    });
+    std::vector<char> has_edge(nv, 0);
+    for (int u = 0; u < left; u++) {
+        if (g.degree(u) == 0) continue;
+        has_edge[root[u]] = 1;
+    }
+    ComponentSplit s;
+    for (int v = 0; v < nv; v++)
+        if (root[v] == v && has_edge[v]) id[v] = s.count++;
+
+    s.start.assign(s.count + 1, 0);
+    s.arcs.assign(s.count, 0);
+    for (int v = 0; v < nv; v++) {
+        int c = id[root[v]];
+        if (c == NIL) continue;
+        s.start[c + 1]++;
+        if (v < left) s.arcs[c] += g.degree(v);
+    }
+    for (int c = 0; c < s.count; c++) s.start[c + 1] += s.start[c];
+    s.order.resize(s.start[s.count]);
+    std::vector<int> pos(s.start.begin(), s.start.end() - 1);
+    for (int v = 0; v < nv; v++) {
+        int c = id[root[v]];
+        if (c != NIL) s.order[pos[c]++] = v;
+    }
+    return s;
+}
+
+/* Subgraph of component c with vertices renumbered in s.order sequence;
+   `local` maps a global vertex to its index inside its own component */
+template <class G>
+inline G component_graph(const G& g, const ComponentSplit& s, int c,
+                             const std::vector<int>& local) {
+    int left = g.num_vertices();
+    int lo = s.start[c], hi = s.start[c + 1];
+    EdgeList edges;
+    edges.reserve((size_t)s.arcs[c]);
+    if (g.is_bipartite()) {
+        int left_count = 0, right_count = 0;
+        for (int k = lo; k < hi; k++) {
+            int x = s.order[k];
+            if (x >= left) { right_count++; continue; }
+            left_count++;
+            for (int v : g.neighbors(x)) edges.push_back({local[x], local[v + left]});
+        }
+        return G::bipartite(left_count, right_count, edges, 1);
+    }
+    for (int k = lo; k < hi; k++) {
+        int u = s.order[k];
+        for (int v : g.neighbors(u))
+            if (u < v) edges.push_back({local[u], local[v]});
+    }
+    return G::general(hi - lo, edges, 1);
+}
+
+/* Run `solve` on g, or on each connected component when opt.components;
+   with opt.reorder, on the relabeled graph, mapping the matching back.
+   opt.numa places the CSR solved, by vertex range (numa.hpp). */
+template <class G, class Solve>
+inline Result solve_graph(const G& g, const Options& opt, Solve&& solve) {
+    if (opt.reorder != REORDER_NONE) {
+        auto t0 = std::chrono::steady_clock::now();
+        Permutation p = vertex_order(g, opt.reorder, opt.threads);
+        G pg = permute_graph(g, p, opt.threads);
+        Matching prior;
+        Options sub_opt = opt;
+        sub_opt.reorder = REORDER_NONE;
+        if (opt.initial) {
+            prior = permute_matching(*opt.initial, p, false);
+            sub_opt.initial = &prior;
+        }
+        double ms = ms_since(t0);
+        Result r = solve_graph(pg, sub_opt, solve);
+        t0 = std::chrono::steady_clock::now();
+        r.matching = permute_matching(r.matching, p, true);
+        r.reorder_ms = ms + ms_since(t0);
+        return r;
+    }
+    numa_place_graph(g, opt.numa, solve_threads(opt));
+    if (!opt.components) return solve(g, opt);
+
+    Result r;
+    ComponentSplit s = split_components(g, opt.threads);
+    r.components = s.count;
+    int left = g.num_vertices();
+
+    /* Index inside the component; bipartite sides are numbered separately */
+    std::vector<int> local(g.is_bipartite() ? left + g.num_right() : left, NIL);
+    for (int c = 0; c < s.count; c++) {
+        int nl = 0, nr = 0;
+        for (int k = s.start[c]; k < s.start[c + 1]; k++) {
+            int x = s.order[k];
+            local[x] = g.is_bipartite() && x >= left ? nr++ : nl++;
+        }
+    }
+
+    /* Prior pairs of each component, in local ids */
+    std::vector<Matching> prior(opt.initial ? s.count : 0);
+    if (opt.initial) {
+        int nv = (int)local.size(), shift = g.is_bipartite() ? left : 0;
+        std::vector<int> comp(nv, NIL);
+        for (int c = 0; c < s.count; c++)
+            for (int k = s.start[c]; k < s.start[c + 1]; k++) comp[s.order[k]] = c;
+        for (const auto& e : *opt.initial) {
+            int x = e.first, y = e.second + shift;
+            if (x < 0 || x >= left || y < shift || y >= nv) continue;
+            if (comp[x] != NIL && comp[x] == comp[y]) prior[comp[x]].push_back({local[x], local[y]});
+        }
+    }
+
+    std::vector<int> by_size(s.count);
+    for (int c = 0; c < s.count; c++) by_size[c] = c;
+    std::stable_sort(by_size.begin(), by_size.end(),
+                     [&](int a, int b) { return s.arcs[a] > s.arcs[b]; });
+
+    std::vector<Result> parts(s.count);
+    auto run_one = [&](int c, int threads) {
+        G sub = component_graph(g, s, c, local);
+        Options sub_opt = opt;
+        sub_opt.components = false;
+        sub_opt.threads = threads;
+        sub_opt.initial = opt.initial ? &prior[c] : nullptr;
+        Result part = solve(sub, sub_opt);
+        /* Back to global ids: the k-th left (or right) vertex of c */
+        std::vector<int> left_ids, right_ids;
+        for (int k = s.start[c]; k < s.start[c + 1]; k++) {
+            int x = s.order[k];
+            if (g.is_bipartite() && x >= left) right_ids.push_back(x - left);
+            else left_ids.push_back(x);
+        }
+        const std::vector<int>& second = g.is_bipartite() ? right_ids : left_ids;
+        for (auto& e : part.matching) e = {left_ids[e.first], second[e.second]};
+        parts[c] = std::move(part);
+    };
+
+    long long total_arcs = g.num_arcs();
+    size_t first = 0;
+    if (s.count > 0 && 2 * s.arcs[by_size[0]] >= total_arcs) run_one(by_size[first++], opt.threads);
+
+    int T = std::min<int>(resolve_threads(opt.threads), (int)(s.count - first));
+    std::atomic<size_t> next(first);
+    run_parallel(std::max(1, T), [&](int) {
+        for (;;) {
+            size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= (size_t)s.count) break;
+            run_one(by_size[i], 1);
+        }
+    });
+
+    for (Result& part : parts) {
+        r.matching.insert(r.matching.end(), part.matching.begin(), part.matching.end());
+        r.greedy_size += part.greedy_size;
+        r.greedy_ms += part.greedy_ms;
+        r.initial_size += part.initial_size;
+        r.compress_ms += part.compress_ms;
+        r.csr_bytes += part.csr_bytes;
+        r.compressed_bytes += part.compressed_bytes;
+        if (part.path_bound > 0 && (r.path_bound == 0 || part.path_bound < r.path_bound))
+            r.path_bound = part.path_bound;   /* the weakest component bounds the whole */
+        r.stats.merge(part.stats);
+    }
+    std::sort(r.matching.begin(), r.matching.end());
+    return r;
+}
+
+} // namespace matching
@@ -0,0 +1,303 @@
+/*
+ * Compressed adjacency (--compressed).
+ *
+ * Neighbor lists are sorted and deduplicated, so a row is a strictly
+ * increasing sequence and its gaps (first neighbor as is, then the
+ * difference to the previous one) are small whenever neighbors have nearby
+ * ids: grids, meshes, most real inputs, and any graph after --reorder rcm.
+ * Gaps are packed with group varint. Each group of four values is one
+ * control byte (two bits per value: its length in bytes minus one),
+ * followed by the values' low 1-4 bytes, little-endian. A row of d
+ * neighbors takes ceil(d / 4) groups. A short last group stores only its
+ * own values; nothing reads past the end of a row, so its unused lanes
+ * decode to garbage that is never looked at.
+ *
+ * Decoding a group is one 16-byte load, a byte shuffle selected by the
+ * control byte, and a 4-lane prefix sum (SSSE3), or a byte loop in the
+ * scalar version. resolve_decode() picks SSSE3 when the CPU has it; the
+ * vector version is compiled with a target attribute, as in
+ * frontier_scan.hpp.
+ *
+ * The arc offsets stay uncompressed, so degree() and adj_start() cost the
+ * same as in Graph, and per-arc side arrays (MV's predecessor slots, HK's
+ * current arc) keep their layout. Row starts are byte positions: 32-bit
+ * when the data is under 4 GiB, 64-bit otherwise.
+ *
+ * Rows are read front to back, through neighbors() (range-for) or a
+ * Cursor. There is no random access by arc index.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "graph.hpp"
+#include "parallel.hpp"
+#include "solver.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MATCHING_DECODE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace matching {
+
+/* Group decoders (CompressedGraph::compress) */
+static const int DECODE_SCALAR = 0;
+static const int DECODE_SSSE3 = 1;
+
+static const int GROUP_PAD = 16;   /* bytes after the data, so a group load never leaves the buffer */
+
+namespace detail {
+
+/* Per control byte: group length (control byte included) and the pshufb
+   mask that spreads the data bytes into four 32-bit lanes */
+struct GroupTables {
+    uint8_t length[256];
+    uint8_t shuffle[256][16];
+
+    GroupTables() {
+        for (int c = 0; c < 256; c++) {
+            int pos = 0;
+            for (int i = 0; i < 4; i++) {
+                int len = ((c >> (2 * i)) & 3) + 1;
+                for (int b = 0; b < 4; b++) shuffle[c][4 * i + b] = b < len ? (uint8_t)(pos + b) : 0x80;
+                pos += len;
+            }
+            length[c] = (uint8_t)(1 + pos);
+        }
+    }
+};
+
+inline const GroupTables& group_tables() {
+    static const GroupTables t;
+    return t;
+}
+
+inline int gap_bytes(unsigned g) {
+    return g < (1u << 8) ? 1 : g < (1u << 16) ? 2 : g < (1u << 24) ? 3 : 4;
+}
+
+/* Encode n values of a sorted row into out; returns the bytes written.
+   With out == nullptr only counts. */
+inline size_t encode_row(const int* row, int n, uint8_t* out) {
+    size_t pos = 0;
+    int prev = 0;
+    for (int k = 0; k < n; k += 4) {
+        unsigned gap[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4 && k + i < n; i++) {
+            gap[i] = (unsigned)(row[k + i] - prev);
+            prev = row[k + i];
+        }
+        size_t ctrl = pos++;
+        unsigned c = 0;
+        for (int i = 0; i < 4 && k + i < n; i++) {
+            int len = gap_bytes(gap[i]);
+            c |= (unsigned)(len - 1) << (2 * i);
+            if (out)
+                for (int b = 0; b < len; b++) out[pos + b] = (uint8_t)(gap[i] >> (8 * b));
+            pos += len;
+        }
+        if (out) out[ctrl] = (uint8_t)c;
+    }
+    return pos;
+}
+
+inline size_t decode_scalar(const uint8_t* p, int prev, int* out) {
+    unsigned c = p[0], acc = (unsigned)prev;
+    const uint8_t* d = p + 1;
+    for (int i = 0; i < 4; i++) {
+        int len = ((c >> (2 * i)) & 3) + 1;
+        unsigned g = 0;
+        for (int b = 0; b < len; b++) g |= (unsigned)d[b] << (8 * b);
+        d += len;
+        acc += g;
+        out[i] = (int)acc;
+    }
+    return (size_t)(d - p);
+}
+
+#if defined(MATCHING_DECODE_X86)
+__attribute__((target("ssse3")))
+inline size_t decode_ssse3(const uint8_t* p, int prev, int* out) {
+    const GroupTables& t = group_tables();
+    unsigned c = p[0];
+    __m128i data = _mm_loadu_si128((const __m128i*)(p + 1));
+    __m128i g = _mm_shuffle_epi8(data, _mm_loadu_si128((const __m128i*)t.shuffle[c]));
+    g = _mm_add_epi32(g, _mm_slli_si128(g, 4));
+    g = _mm_add_epi32(g, _mm_slli_si128(g, 8));
+    g = _mm_add_epi32(g, _mm_set1_epi32(prev));
+    _mm_storeu_si128((__m128i*)out, g);
+    return t.length[c];
+}
+#endif
+
+} // namespace detail
+
+/* SSSE3 unless the CPU lacks it or `scan` asks for scalar kernels */
+inline int resolve_decode(int scan) {
+#if defined(MATCHING_DECODE_X86)
+    __builtin_cpu_init();
+    if (scan != SCAN_SCALAR && __builtin_cpu_supports("ssse3")) return DECODE_SSSE3;
+#else
+    (void)scan;
+#endif
+    return DECODE_SCALAR;
+}
+
+inline const char* decode_name(int isa) {
+    return isa == DECODE_SSSE3 ? "ssse3" : "scalar";
+}
+
+/* Bytes a CSR graph keeps for g: offsets plus targets */
+template <class Arc>
+inline size_t csr_bytes(const BasicGraph<Arc>& g) {
+    return ((size_t)g.num_vertices() + 1) * sizeof(Arc) + (size_t)g.num_arcs() * sizeof(int);
+}
+
+/* Arc offsets are Arc, as in BasicGraph */
+template <class Arc>
+class BasicCompressedGraph {
+public:
+    using arc_type = Arc;
+
+    /* Read position in a row: the next group and the last value before it */
+    struct Cursor {
+        size_t pos;
+        int prev;
+    };
+
+    /* Range-for over one row, decoding a group at a time */
+    class Iterator {
+    public:
+        Iterator(const BasicCompressedGraph* g, size_t pos, int count) : g_(g), cur_{pos, 0}, left_(count) {
+            if (left_ > 0) fill();
+        }
+        int operator*() const { return buf_[idx_]; }
+        Iterator& operator++() {
+            left_--;
+            if (++idx_ == 4 && left_ > 0) fill();
+            return *this;
+        }
+        bool operator!=(const Iterator& o) const { return left_ != o.left_; }
+
+    private:
+        void fill() { g_->read_group(cur_, buf_); idx_ = 0; }
+
+        const BasicCompressedGraph* g_;
+        Cursor cur_;
+        int left_;
+        int idx_ = 0;
+        int buf_[4];
+    };
+
+    struct Row {
+        const BasicCompressedGraph* g;
+        size_t pos;
+        int count;
+
+        Iterator begin() const { return Iterator(g, pos, count); }
+        Iterator end() const { return Iterator(g, pos, 0); }
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+    };
+
+    BasicCompressedGraph() = default;
+
+    /* Gap-encode every row of g, rows split across `threads`; the bytes do
+       not depend on the thread count. `isa` is DECODE_*. */
+    static BasicCompressedGraph compress(const BasicGraph<Arc>& g, int threads = 0, int isa = DECODE_SCALAR) {
+        BasicCompressedGraph c;
+        c.n_ = g.num_vertices();
+        c.n_right_ = g.num_right();
+        c.bipartite_ = g.is_bipartite();
+        c.num_arcs_ = g.num_arcs();
+        c.isa_ = isa;
+        c.offsets_.assign(g.offsets(), g.offsets() + c.n_ + 1);
+
+        int n = c.n_;
+        int T = threads_for((size_t)g.num_arcs(), threads);
+        std::vector<size_t> size(n);
+        run_parallel(T, [&](int t) {
+            for (int u = (int)chunk_begin(n, T, t); u < (int)chunk_begin(n, T, t + 1); u++)
+                size[u] = detail::encode_row(g.targets() + g.adj_start(u), g.degree(u), nullptr);
+        });
+        std::vector<size_t> start(n + 1, 0);
+        for (int u = 0; u < n; u++) start[u + 1] = start[u] + size[u];
+        size_t total = start[n];
+        c.data_.assign(total + GROUP_PAD, 0);
+        if (total <= UINT32_MAX) c.start32_.assign(start.begin(), start.end());
+        else c.start64_ = start;
+        run_parallel(T, [&](int t) {
+            for (int u = (int)chunk_begin(n, T, t); u < (int)chunk_begin(n, T, t + 1); u++)
+                detail::encode_row(g.targets() + g.adj_start(u), g.degree(u), c.data_.data() + start[u]);
+        });
+        return c;
+    }
+
+    int num_vertices() const { return n_; }
+    int num_right() const { return n_right_; }
+    bool is_bipartite() const { return bipartite_; }
+    Arc num_arcs() const { return num_arcs_; }
+    Arc num_edges() const { return bipartite_ ? num_arcs_ : num_arcs_ / 2; }
+    int decoder() const { return isa_; }
+
+    Arc adj_start(int u) const { return offsets_[u]; }
+    int degree(int u) const { return (int)(offsets_[u + 1] - offsets_[u]); }
+    Row neighbors(int u) const { return {this, row_begin(u), degree(u)}; }
+
+    /* Linear scan of u's row */
+    bool has_edge(int u, int v) const {
+        if (u < 0 || u >= n_) return false;
+        for (int w : neighbors(u)) {
+            if (w >= v) return w == v;
+        }
+        return false;
+    }
+
+    Cursor cursor(int u) const { return {row_begin(u), 0}; }
+
+    /* Decode the group at c into out[0..4) and step c past it. In the last
+       group of a row, slots past the row's end (and c) are meaningless. */
+    void read_group(Cursor& c, int* out) const {
+        const uint8_t* p = data_.data() + c.pos;
+#if defined(MATCHING_DECODE_X86)
+        if (isa_ == DECODE_SSSE3) c.pos += detail::decode_ssse3(p, c.prev, out);
+        else
+#endif
+        c.pos += detail::decode_scalar(p, c.prev, out);
+        c.prev = out[3];
+    }
+
+    /* Decode the next `count` neighbors at c into out, which has room for
+       count rounded up to a multiple of 4. count must be a multiple of 4
+       unless it reaches the end of the row. */
+    void read(Cursor& c, int count, int* out) const {
+        for (int k = 0; k < count; k += 4) read_group(c, out + k);
+    }
+
+    /* Resident bytes: offsets, row starts and encoded rows */
+    size_t bytes() const {
+        return offsets_.size() * sizeof(Arc) + start32_.size() * sizeof(uint32_t)
+             + start64_.size() * sizeof(size_t) + data_.size();
+    }
+
+private:
+    size_t row_begin(int u) const { return start64_.empty() ? start32_[u] : start64_[u]; }
+
+    int n_ = 0;
+    int n_right_ = 0;
+    bool bipartite_ = false;
+    Arc num_arcs_ = 0;
+    int isa_ = DECODE_SCALAR;
+    std::vector<Arc> offsets_ = std::vector<Arc>(1, 0);
+    std::vector<uint32_t> start32_ = std::vector<uint32_t>(1, 0);
+    std::vector<size_t> start64_;
+    std::vector<uint8_t> data_ = std::vector<uint8_t>(GROUP_PAD, 0);
+};
+
+using CompressedGraph = BasicCompressedGraph<int>;
+using CompressedGraph64 = BasicCompressedGraph<int64_t>;
+
+} // namespace matching
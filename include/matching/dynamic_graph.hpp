@@ -0,0 +1,180 @@
+/*
+ * Mutable undirected graph for the dynamic matching engine.
+ *
+ * Every vertex keeps its neighbors in its own vector. An edge table maps
+ * each edge {u, v} to its slot in both lists, so insert and erase are
+ * amortized O(1). An erase moves the last neighbor into the freed slot
+ * and updates that neighbor's table entry in the same step. Neighbor lists
+ * are therefore not sorted, but their order depends only on the sequence
+ * of updates.
+ *
+ * The table uses open addressing with linear probing and a fixed mixing
+ * function, keyed by the 64-bit pair (min, max). Once live plus deleted
+ * slots pass half of its capacity it is rebuilt at four times the live
+ * edge count, so erase-heavy workloads do not grow it.
+ *
+ * General graphs only. All integers, no hash containers, fully
+ * deterministic.
+ */
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace matching {
+
+class DynamicGraph {
+public:
+    DynamicGraph() = default;
+
+    /* Copy of a general CSR graph */
+    explicit DynamicGraph(const Graph& g) {
+        resize(g.num_vertices());
+        rehash(2 * (size_t)g.num_edges() + 16);
+        for (int u = 0; u < n_; u++) {
+            adj_[u].reserve(g.degree(u));
+            for (int v : g.neighbors(u))
+                if (u < v) insert(u, v);
+        }
+    }
+
+    int num_vertices() const { return n_; }
+    long long num_edges() const { return edges_; }
+    int degree(int u) const { return (int)adj_[u].size(); }
+    const std::vector<int>& neighbors(int u) const { return adj_[u]; }
+
+    /* Grow to n vertices; new vertices are isolated */
+    void resize(int n) {
+        if (n <= n_) return;
+        n_ = n;
+        adj_.resize(n);
+    }
+
+    bool has_edge(int u, int v) const {
+        if (!valid(u, v) || keys_.empty()) return false;
+        return keys_[find(key(u, v))] != EMPTY;
+    }
+
+    /* Add {u, v}; false for self-loops, out-of-range ends and existing edges */
+    bool insert(int u, int v) {
+        if (!valid(u, v)) return false;
+        if (keys_.empty()) rehash(16);
+        uint64_t k = key(u, v);
+        size_t s = find(k);
+        if (keys_[s] != EMPTY) return false;
+        if (2 * (used_ + 1) > keys_.size()) {
+            rehash(4 * (size_t)(edges_ + 1));
+            s = find(k);
+        }
+        if (u > v) std::swap(u, v);
+        put(s, k, (int)adj_[u].size(), (int)adj_[v].size());
+        adj_[u].push_back(v);
+        adj_[v].push_back(u);
+        edges_++;
+        return true;
+    }
+
+    /* Remove {u, v}; false if it is not an edge */
+    bool erase(int u, int v) {
+        if (!valid(u, v) || keys_.empty()) return false;
+        size_t s = find(key(u, v));
+        if (keys_[s] == EMPTY) return false;
+        if (u > v) std::swap(u, v);
+        int pu = pos_lo_[s], pv = pos_hi_[s];
+        keys_[s] = DELETED;
+        unlink(u, pu);
+        unlink(v, pv);
+        edges_--;
+        return true;
+    }
+
+    /* CSR snapshot, e.g. for validation or a full solve */
+    Graph snapshot(int threads = 0) const {
+        EdgeList edges;
+        edges.reserve((size_t)edges_);
+        for (int u = 0; u < n_; u++)
+            for (int v : adj_[u])
+                if (u < v) edges.push_back({u, v});
+        return Graph::general(n_, edges, threads);
+    }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ull;
+    static constexpr uint64_t DELETED = ~0ull - 1;
+
+    int n_ = 0;
+    long long edges_ = 0;
+    std::vector<std::vector<int>> adj_;
+    std::vector<uint64_t> keys_;       /* (min << 32) | max, EMPTY or DELETED */
+    std::vector<int> pos_lo_, pos_hi_; /* slot of max in adj_[min], of min in adj_[max] */
+    size_t used_ = 0;                  /* live plus deleted slots */
+
+    bool valid(int u, int v) const { return u != v && u >= 0 && v >= 0 && u < n_ && v < n_; }
+
+    static uint64_t key(int u, int v) {
+        if (u > v) std::swap(u, v);
+        return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v;
+    }
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33; x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33; x *= 0xC4CEB9FE1A85EC53ull;
+        return x ^ (x >> 33);
+    }
+
+    /* Slot holding k, or the EMPTY slot where its probe ends */
+    size_t find(uint64_t k) const {
+        size_t mask = keys_.size() - 1;
+        for (size_t s = mix(k) & mask;; s = (s + 1) & mask)
+            if (keys_[s] == k || keys_[s] == EMPTY) return s;
+    }
+
+    /* Slot for a new key: reuse the first DELETED slot on its probe */
+    void put(size_t empty_slot, uint64_t k, int pu, int pv) {
+        size_t mask = keys_.size() - 1, s = mix(k) & mask;
+        while (s != empty_slot && keys_[s] != DELETED) s = (s + 1) & mask;
+        if (s == empty_slot) used_++;
+        keys_[s] = k;
+        pos_lo_[s] = pu;
+        pos_hi_[s] = pv;
+    }
+
+    /* Fill slot i of adj_[x] with its last entry, fixing that edge's position */
+    void unlink(int x, int i) {
+        std::vector<int>& a = adj_[x];
+        int y = a.back();
+        a.pop_back();
+        if (i == (int)a.size()) return;
+        a[i] = y;
+        size_t s = find(key(x, y));
+        if (x < y) pos_lo_[s] = i;
+        else pos_hi_[s] = i;
+    }
+
+    void rehash(size_t want) {
+        size_t cap = 16;
+        while (cap < want) cap <<= 1;
+        std::vector<uint64_t> old_keys;
+        std::vector<int> old_lo, old_hi;
+        old_keys.swap(keys_);
+        old_lo.swap(pos_lo_);
+        old_hi.swap(pos_hi_);
+        keys_.assign(cap, EMPTY);
+        pos_lo_.assign(cap, 0);
+        pos_hi_.assign(cap, 0);
+        used_ = 0;
+        for (size_t s = 0; s < old_keys.size(); s++) {
+            if (old_keys[s] == EMPTY || old_keys[s] == DELETED) continue;
+            size_t t = find(old_keys[s]);
+            keys_[t] = old_keys[s];
+            pos_lo_[t] = old_lo[s];
+            pos_hi_[t] = old_hi[s];
+            used_++;
+        }
+    }
+};
+
+} // namespace matching
@@ -0,0 +1,125 @@
+/*
+ * Frontier scan kernels for the BFS loops over CSR neighbor lists.
+ *
+ * A BFS step looks at every neighbor v of a frontier vertex with two
+ * dependent loads: the slot v leads to, then that slot's visited state.
+ * Most of those checks fail once the search has spread. These kernels
+ * check a whole block of neighbors with gathers and compact the ones that
+ * pass into a small buffer, and the caller then handles only those.
+ *
+ *     slot(v) = map[v] == NIL ? nil_slot : map[v]
+ *     keep v  when state[slot(v)] == want
+ *
+ * Hopcroft-Karp calls it with map = pair_right, state = dist and want =
+ * INT_MAX. A kept neighbor passed the test when the block was loaded, so
+ * the caller tests it again before acting. As long as the state only moves
+ * away from `want`, results are identical to the scalar loop.
+ *
+ * Versions: scalar, AVX2 (8 lanes, mask bits walked in order) and AVX-512F
+ * (16 lanes, compress-store). resolve_scan() picks the best one the CPU
+ * supports at run time, or the one requested if it is supported. No
+ * -march flag is needed; the vector versions are compiled per function
+ * with target attributes. Non-x86 targets, and compilers without GNU
+ * extensions, get the scalar version only.
+ */
+#pragma once
+
+#include "graph.hpp"
+#include "solver.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MATCHING_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace matching {
+
+static const int SCAN_BLOCK = 256;   /* caller's buffer size, a multiple of 16 */
+
+/* Writes the kept neighbors nb[0..len) (len <= SCAN_BLOCK) to out, in
+   order, and returns how many */
+using ScanFn = int (*)(const int* nb, int len, const int* map, int nil_slot,
+                       const int* state, int want, int* out);
+
+inline int scan_scalar(const int* nb, int len, const int* map, int nil_slot,
+                       const int* state, int want, int* out) {
+    int cnt = 0;
+    for (int k = 0; k < len; k++) {
+        int s = map[nb[k]];
+        if (s == NIL) s = nil_slot;
+        out[cnt] = nb[k];
+        cnt += state[s] == want;
+    }
+    return cnt;
+}
+
+#if defined(MATCHING_SCAN_X86)
+__attribute__((target("avx2")))
+inline int scan_avx2(const int* nb, int len, const int* map, int nil_slot,
+                     const int* state, int want, int* out) {
+    const __m256i vnil = _mm256_set1_epi32(NIL);
+    const __m256i vslot = _mm256_set1_epi32(nil_slot);
+    const __m256i vwant = _mm256_set1_epi32(want);
+    int cnt = 0, k = 0;
+    for (; k + 8 <= len; k += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(nb + k));
+        __m256i s = _mm256_i32gather_epi32(map, v, 4);
+        s = _mm256_blendv_epi8(s, vslot, _mm256_cmpeq_epi32(s, vnil));
+        __m256i st = _mm256_i32gather_epi32(state, s, 4);
+        unsigned m = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(st, vwant)));
+        while (m) {
+            out[cnt++] = nb[k + __builtin_ctz(m)];
+            m &= m - 1;
+        }
+    }
+    return cnt + scan_scalar(nb + k, len - k, map, nil_slot, state, want, out + cnt);
+}
+
+__attribute__((target("avx512f")))
+inline int scan_avx512(const int* nb, int len, const int* map, int nil_slot,
+                       const int* state, int want, int* out) {
+    const __m512i vnil = _mm512_set1_epi32(NIL);
+    const __m512i vslot = _mm512_set1_epi32(nil_slot);
+    const __m512i vwant = _mm512_set1_epi32(want);
+    const __m512i zero = _mm512_setzero_si512();
+    int cnt = 0, k = 0;
+    for (; k + 16 <= len; k += 16) {
+        __m512i v = _mm512_loadu_si512((const void*)(nb + k));
+        __m512i s = _mm512_mask_i32gather_epi32(zero, 0xFFFF, v, (const void*)map, 4);
+        s = _mm512_mask_mov_epi32(s, _mm512_cmpeq_epi32_mask(s, vnil), vslot);
+        __m512i st = _mm512_mask_i32gather_epi32(zero, 0xFFFF, s, (const void*)state, 4);
+        __mmask16 m = _mm512_cmpeq_epi32_mask(st, vwant);
+        _mm512_mask_compressstoreu_epi32((void*)(out + cnt), m, v);
+        cnt += __builtin_popcount((unsigned)m);
+    }
+    return cnt + scan_scalar(nb + k, len - k, map, nil_slot, state, want, out + cnt);
+}
+#endif
+
+/* Best supported kernel no wider than `want` (SCAN_AUTO: the widest) */
+inline int resolve_scan(int want) {
+#if defined(MATCHING_SCAN_X86)
+    if (want == SCAN_AUTO) want = SCAN_AVX512;
+    __builtin_cpu_init();
+    if (want >= SCAN_AVX512 && __builtin_cpu_supports("avx512f")) return SCAN_AVX512;
+    if (want >= SCAN_AVX2 && __builtin_cpu_supports("avx2")) return SCAN_AVX2;
+#else
+    (void)want;
+#endif
+    return SCAN_SCALAR;
+}
+
+inline ScanFn scan_kernel(int isa) {
+#if defined(MATCHING_SCAN_X86)
+    if (isa == SCAN_AVX512) return scan_avx512;
+    if (isa == SCAN_AVX2) return scan_avx2;
+#endif
+    (void)isa;
+    return scan_scalar;
+}
+
+inline const char* scan_name(int isa) {
+    return isa == SCAN_AVX512 ? "avx512" : isa == SCAN_AVX2 ? "avx2" : "scalar";
+}
+
+} // namespace matching
@@ -0,0 +1,345 @@
+/*
+ * Immutable CSR graph shared by every C++ matching solver.
+ *
+ * One offsets array (n + 1 entries) plus one flat neighbor array, the same
+ * layout MVGraph used internally. Built once from an edge list and handed
+ * by const reference to any solver, so several algorithms can run on one
+ * loaded graph without rebuilding it.
+ *
+ * General graphs store both directions of every edge. Bipartite graphs
+ * store left -> right arcs only and remember the right-hand vertex count.
+ *
+ * Neighbor lists are sorted and deduplicated (a suite invariant: greedy
+ * choices and search order depend on it). Construction is two stable
+ * counting-sort passes, O(V + E), with no per-vertex std::sort, split
+ * across threads without changing the result.
+ *
+ * The arrays are either owned by the graph or borrowed from a read-only
+ * mapping (see binary_format.hpp); copies share the same storage.
+ *
+ * BasicGraph is a template over the arc offset type. Vertex ids and
+ * targets are int in both instantiations, so a neighbor list costs the
+ * same; only offsets[] and arc indices widen:
+ *
+ *   Graph     int offsets, up to 2^31 - 1 arcs (the default, every solver)
+ *   Graph64   int64_t offsets, for inputs beyond that (Hopcroft-Karp, MV)
+ *
+ * All integers, no hash containers, fully deterministic.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "parallel.hpp"
+
+namespace matching {
+
+static const int NIL = -1;
+
+using Edge = std::pair<int,int>;
+using EdgeList = std::vector<Edge>;
+
+/* Contiguous neighbor range, usable in range-for and by index */
+struct Neighbors {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return (int)(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](int i) const { return first[i]; }
+};
+
+template <class Arc>
+class BasicGraph {
+public:
+    using arc_type = Arc;   /* arc offsets and indices */
+
+    BasicGraph() = default;
+
+    /* Undirected graph on n vertices. Self-loops, out-of-range endpoints
+       and duplicate edges are dropped. `threads` parallelizes the build
+       (0 = all hardware threads); the result does not depend on it. */
+    static BasicGraph general(int n, const EdgeList& edges, int threads = 0) {
+        BasicGraph g;
+        g.n_ = n;
+        g.n_right_ = n;
+        g.bipartite_ = false;
+        g.build(edges, threads);
+        return g;
+    }
+
+    /* Bipartite graph: left vertices 0..left-1, right vertices 0..right-1,
+       each edge is (left, right). Out-of-range edges and duplicates are dropped. */
+    static BasicGraph bipartite(int left, int right, const EdgeList& edges, int threads = 0) {
+        BasicGraph g;
+        g.n_ = left;
+        g.n_right_ = right;
+        g.bipartite_ = true;
+        g.build(edges, threads);
+        return g;
+    }
+
+    int num_vertices() const { return n_; }       /* left side when bipartite */
+    int num_right() const { return n_right_; }    /* == num_vertices() unless bipartite */
+    bool is_bipartite() const { return bipartite_; }
+
+    /* Number of stored arcs (each general edge is stored twice) */
+    Arc num_arcs() const { return num_arcs_; }
+    /* Number of distinct undirected edges */
+    Arc num_edges() const { return bipartite_ ? num_arcs() : num_arcs() / 2; }
+
+    Arc adj_start(int u) const { return offsets_[u]; }
+    int degree(int u) const { return (int)(offsets_[u + 1] - offsets_[u]); }
+    Neighbors neighbors(int u) const {
+        return {targets_ + offsets_[u], targets_ + offsets_[u + 1]};
+    }
+
+    /* Binary search in u's sorted neighbor list */
+    bool has_edge(int u, int v) const {
+        if (u < 0 || u >= n_) return false;
+        auto nb = neighbors(u);
+        return std::binary_search(nb.begin(), nb.end(), v);
+    }
+
+    /* Reverse of a bipartite graph (right -> left arcs, rows sorted), built
+       by one parallel counting sort. General graphs are symmetric and are
+       returned as is. */
+    BasicGraph transposed(int threads = 0) const {
+        if (!bipartite_) return *this;
+        BasicGraph g;
+        g.n_ = n_right_;
+        g.n_right_ = n_;
+        g.bipartite_ = true;
+        size_t m = (size_t)num_arcs_;
+        int T = threads_for(m, threads);
+        T = std::max(1, std::min<int>(T, (int)(2 * m / ((size_t)n_right_ + 1))));
+
+        /* Threads own source-row ranges of about m / T arcs */
+        std::vector<int> row_lo(T + 1, n_);
+        for (int t = 0; t < T; t++)
+            row_lo[t] = (int)(std::lower_bound(offsets_, offsets_ + n_ + 1,
+                                               (Arc)chunk_begin(m, T, t)) - offsets_);
+        row_lo[0] = 0;
+        std::vector<std::vector<Arc>> hist(T);
+        run_parallel(T, [&](int t) {
+            hist[t].assign(n_right_, 0);
+            for (Arc k = offsets_[row_lo[t]]; k < offsets_[row_lo[t + 1]]; k++) hist[t][targets_[k]]++;
+        });
+        auto arrays = std::make_shared<Arrays>();
+        arrays->offsets.assign(n_right_ + 1, 0);
+        Arc run = 0;
+        for (int v = 0; v < n_right_; v++) {
+            arrays->offsets[v] = run;
+            for (int t = 0; t < T; t++) { Arc h = hist[t][v]; hist[t][v] = run; run += h; }
+        }
+        arrays->offsets[n_right_] = run;
+        arrays->targets.resize(m);
+        run_parallel(T, [&](int t) {
+            std::vector<Arc>& pos = hist[t];
+            for (int u = row_lo[t]; u < row_lo[t + 1]; u++)
+                for (Arc k = offsets_[u]; k < offsets_[u + 1]; k++)
+                    arrays->targets[pos[targets_[k]]++] = u;
+        });
+        g.num_arcs_ = num_arcs_;
+        g.offsets_ = arrays->offsets.data();
+        g.targets_ = arrays->targets.data();
+        g.storage_ = std::move(arrays);
+        return g;
+    }
+
+    const Arc* offsets() const { return offsets_; }
+    const int* targets() const { return targets_; }
+
+    /* Wrap existing CSR arrays (already sorted and deduplicated) without
+       copying. `storage` keeps the memory behind the pointers alive. */
+    static BasicGraph view(int n, int n_right, bool bipartite, Arc num_arcs,
+                           const Arc* offsets, const int* targets,
+                           std::shared_ptr<const void> storage) {
+        BasicGraph g;
+        g.n_ = n;
+        g.n_right_ = n_right;
+        g.bipartite_ = bipartite;
+        g.num_arcs_ = num_arcs;
+        g.offsets_ = offsets;
+        g.targets_ = targets;
+        g.storage_ = std::move(storage);
+        return g;
+    }
+
+private:
+    struct Arrays {
+        std::vector<Arc> offsets;
+        std::vector<int> targets;
+    };
+
+    static const Arc* empty_offsets() {
+        static const Arc zero = 0;
+        return &zero;
+    }
+
+    int n_ = 0;
+    int n_right_ = 0;
+    bool bipartite_ = false;
+    Arc num_arcs_ = 0;
+    const Arc* offsets_ = empty_offsets();
+    const int* targets_ = nullptr;
+    std::shared_ptr<const void> storage_;
+
+    bool keep(const Edge& e) const {
+        int u = e.first, v = e.second;
+        return u >= 0 && u < n_ && v >= 0 && v < n_right_ && (bipartite_ || u != v);
+    }
+
+    /* Two stable counting sorts: bucket arcs by target, then transpose by
+       source. Walking targets in ascending order during the transpose leaves
+       every row sorted; duplicates are then adjacent and compacted.
+
+       Each pass runs on T threads over contiguous ranges with one histogram
+       per thread; the (bucket, thread) prefix sum keeps the scatter stable,
+       so the CSR is identical for every T. Histograms cost T * V ints, so T
+       is capped to keep them within the size of the arc arrays. */
+    void build(const EdgeList& edges, int threads) {
+        int rows = n_, cols = n_right_;
+        int arc_mult = bipartite_ ? 1 : 2;
+        int T = threads_for(edges.size() * arc_mult, threads);
+
+        /* Filter edges into arc arrays (both directions for general graphs) */
+        std::vector<size_t> kept(T + 1, 0);
+        run_parallel(T, [&](int t) {
+            size_t c = 0;
+            for (size_t i = chunk_begin(edges.size(), T, t); i < chunk_begin(edges.size(), T, t + 1); i++)
+                if (keep(edges[i])) c++;
+            kept[t + 1] = c * arc_mult;
+        });
+        for (int t = 0; t < T; t++) kept[t + 1] += kept[t];
+        size_t m = kept[T];
+        std::vector<int> src(m), dst(m);
+        run_parallel(T, [&](int t) {
+            size_t k = kept[t];
+            for (size_t i = chunk_begin(edges.size(), T, t); i < chunk_begin(edges.size(), T, t + 1); i++) {
+                if (!keep(edges[i])) continue;
+                int u = edges[i].first, v = edges[i].second;
+                src[k] = u; dst[k] = v; k++;
+                if (!bipartite_) { src[k] = v; dst[k] = u; k++; }
+            }
+        });
+
+        T = std::max(1, std::min<int>(T, (int)(2 * m / ((size_t)std::max(rows, cols) + 1))));
+        auto arrays = std::make_shared<Arrays>();
+        std::vector<Arc>& offsets = arrays->offsets;
+        std::vector<int>& targets = arrays->targets;
+        std::vector<std::vector<Arc>> hist(T);
+
+        /* Pass 1: by_col = sources bucketed by target, input order kept */
+        std::vector<Arc> col_start(cols + 1, 0);
+        std::vector<int> by_col(m);
+        run_parallel(T, [&](int t) {
+            hist[t].assign(cols, 0);
+            for (size_t i = chunk_begin(m, T, t); i < chunk_begin(m, T, t + 1); i++) hist[t][dst[i]]++;
+        });
+        {
+            Arc run = 0;
+            for (int c = 0; c < cols; c++) {
+                col_start[c] = run;
+                for (int t = 0; t < T; t++) { Arc h = hist[t][c]; hist[t][c] = run; run += h; }
+            }
+            col_start[cols] = run;
+        }
+        run_parallel(T, [&](int t) {
+            std::vector<Arc>& pos = hist[t];
+            for (size_t i = chunk_begin(m, T, t); i < chunk_begin(m, T, t + 1); i++) by_col[pos[dst[i]]++] = src[i];
+        });
+        std::vector<int>().swap(src);
+        std::vector<int>().swap(dst);
+
+        /* Pass 2: transpose by source, threads own column ranges of about m / T arcs */
+        std::vector<int> col_lo(T + 1, cols);
+        for (int t = 0; t < T; t++)
+            col_lo[t] = (int)(std::lower_bound(col_start.begin(), col_start.end(),
+                                               (Arc)chunk_begin(m, T, t)) - col_start.begin());
+        col_lo[0] = 0;
+        offsets.assign(rows + 1, 0);
+        run_parallel(T, [&](int t) {
+            hist[t].assign(rows, 0);
+            for (Arc k = col_start[col_lo[t]]; k < col_start[col_lo[t + 1]]; k++) hist[t][by_col[k]]++;
+        });
+        {
+            Arc run = 0;
+            for (int r = 0; r < rows; r++) {
+                offsets[r] = run;
+                for (int t = 0; t < T; t++) { Arc h = hist[t][r]; hist[t][r] = run; run += h; }
+            }
+            offsets[rows] = run;
+        }
+        targets.resize(m);
+        run_parallel(T, [&](int t) {
+            std::vector<Arc>& pos = hist[t];
+            for (int c = col_lo[t]; c < col_lo[t + 1]; c++)
+                for (Arc k = col_start[c]; k < col_start[c + 1]; k++)
+                    targets[pos[by_col[k]]++] = c;
+            std::vector<Arc>().swap(pos);
+        });
+
+        /* Pass 3: drop adjacent duplicates; rows are split into ranges of about
+           m / T arcs, counted, then compacted into by_col (no longer needed) */
+        std::vector<int> row_lo(T + 1, rows);
+        for (int t = 0; t < T; t++)
+            row_lo[t] = (int)(std::lower_bound(offsets.begin(), offsets.end(),
+                                               (Arc)chunk_begin(m, T, t)) - offsets.begin());
+        row_lo[0] = 0;
+        std::vector<Arc> unique_count(T + 1, 0);
+        run_parallel(T, [&](int t) {
+            Arc c = 0;
+            for (int r = row_lo[t]; r < row_lo[t + 1]; r++)
+                for (Arc k = offsets[r]; k < offsets[r + 1]; k++)
+                    if (k == offsets[r] || targets[k] != targets[k - 1]) c++;
+            unique_count[t + 1] = c;
+        });
+        for (int t = 0; t < T; t++) unique_count[t + 1] += unique_count[t];
+        Arc total = unique_count[T];
+        std::vector<Arc> range_end(T);   /* offsets[row_lo[t + 1]] before it is rewritten */
+        for (int t = 0; t < T; t++) range_end[t] = offsets[row_lo[t + 1]];
+        run_parallel(T, [&](int t) {
+            Arc out = unique_count[t];
+            Arc b = t > 0 ? range_end[t - 1] : 0;
+            for (int r = row_lo[t]; r < row_lo[t + 1]; r++) {
+                Arc e = r + 1 < row_lo[t + 1] ? offsets[r + 1] : range_end[t];
+                offsets[r] = out;
+                for (Arc k = b; k < e; k++)
+                    if (k == b || targets[k] != targets[k - 1]) by_col[out++] = targets[k];
+                b = e;
+            }
+        });
+        offsets[rows] = total;
+        by_col.resize((size_t)total);
+        by_col.shrink_to_fit();
+        targets.swap(by_col);
+
+        num_arcs_ = total;
+        offsets_ = offsets.data();
+        targets_ = targets.data();
+        storage_ = std::move(arrays);
+    }
+};
+
+using Graph = BasicGraph<int>;
+using Graph64 = BasicGraph<int64_t>;
+
+/* Arcs a graph with `edges` stored edges would hold, before deduplication */
+inline size_t arcs_for(size_t edges, bool bipartite) {
+    return bipartite ? edges : 2 * edges;
+}
+
+/* True when `arcs` arcs need Graph64 */
+inline bool needs_wide_offsets(size_t arcs) {
+    return arcs > (size_t)INT32_MAX;
+}
+
+} // namespace matching
@@ -0,0 +1,148 @@
+/*
+ * Edge-list loaders.
+ *
+ * General format:    "V E" header, then E lines "u v"
+ * Bipartite format:  "L R E" header, then E lines "left right"
+ *
+ * Text files are parsed by the parallel chunked scanner (text_parser.hpp).
+ *
+ * Binary:            .csr files written by tools/graph_convert, detected
+ *                    by their magic bytes and memory-mapped (binary_format.hpp)
+ *
+ * write_text_graph() writes a graph back out as a text edge list.
+ *
+ * Errors are reported on stderr and signalled by a false return value.
+ */
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "binary_format.hpp"
+#include "graph.hpp"
+#include "text_parser.hpp"
+
+namespace matching {
+
+struct EdgeListFile {
+    int n = 0;         /* vertices (general) or left vertices (bipartite) */
+    int n_right = 0;   /* right vertices, bipartite only */
+    EdgeList edges;
+};
+
+/* Text loaders parse on `threads` threads (0 = all hardware threads);
+   the edge list read does not depend on the thread count. */
+inline bool read_edge_list(const char* path, EdgeListFile& out, int threads = 0) {
+    long long h[3];
+    if (!parse_edge_list_file(path, 2, threads, h, out.edges)) return false;
+    out.n = out.n_right = (int)h[0];
+    return true;
+}
+
+inline bool read_bipartite_edge_list(const char* path, EdgeListFile& out, int threads = 0) {
+    long long h[3];
+    if (!parse_edge_list_file(path, 3, threads, h, out.edges)) return false;
+    out.n = (int)h[0];
+    out.n_right = (int)h[1];
+    return true;
+}
+
+/* Solver input: a mapped binary graph (ready to use) or a parsed text
+   edge list whose CSR is built by build_graph() or build_graph64().
+   A binary file with 64-bit offsets is kept in graph64. */
+struct GraphInput {
+    bool binary = false;
+    bool wide = false;    /* binary input with 64-bit offsets */
+    Graph graph;          /* binary input */
+    Graph64 graph64;      /* wide binary input */
+    EdgeListFile text;    /* text input */
+
+    int num_vertices() const {
+        return !binary ? text.n : wide ? graph64.num_vertices() : graph.num_vertices();
+    }
+    int num_right() const {
+        return !binary ? text.n_right : wide ? graph64.num_right() : graph.num_right();
+    }
+    long long num_edges() const {
+        return !binary ? (long long)text.edges.size() : wide ? graph64.num_edges() : graph.num_edges();
+    }
+    /* True when the CSR would overflow int offsets, so only Graph64 can hold it */
+    bool needs_wide(bool bipartite) const {
+        return binary ? wide : needs_wide_offsets(arcs_for(text.edges.size(), bipartite));
+    }
+};
+
+/* With allow_wide false (solvers built on Graph only), inputs beyond
+   2^31 - 1 arcs are rejected here rather than overflowing later. */
+inline bool read_graph_input(const char* path, bool bipartite, GraphInput& in, int threads = 0,
+                             bool allow_wide = false) {
+    if (is_binary_graph(path)) {
+        in.binary = true;
+        in.wide = is_wide_binary_graph(path);
+        bool ok = in.wide && allow_wide ? map_binary_graph(path, in.graph64, threads)
+                                             : map_binary_graph(path, in.graph, threads);
+        if (!ok) return false;
+        bool is_bip = in.wide ? in.graph64.is_bipartite() : in.graph.is_bipartite();
+        if (is_bip != bipartite) {
+            fprintf(stderr, "%s: expected a %s graph\n", path, bipartite ? "bipartite" : "general");
+            return false;
+        }
+        return true;
+    }
+    in.binary = in.wide = false;
+    bool ok = bipartite ? read_bipartite_edge_list(path, in.text, threads)
+                        : read_edge_list(path, in.text, threads);
+    if (ok && !allow_wide && in.needs_wide(bipartite)) {
+        fprintf(stderr, "%s: %zu arcs need 64-bit offsets, which this solver does not support\n",
+                path, arcs_for(in.text.edges.size(), bipartite));
+        return false;
+    }
+    return ok;
+}
+
+/* Zero-copy for binary input; parallel counting-sort CSR build for text input */
+inline Graph build_graph(const GraphInput& in, bool bipartite, int threads = 0) {
+    if (in.binary) return in.graph;
+    return bipartite ? Graph::bipartite(in.text.n, in.text.n_right, in.text.edges, threads)
+                     : Graph::general(in.text.n, in.text.edges, threads);
+}
+
+/* The same with 64-bit offsets; a narrow binary graph gets its offsets
+   widened, its targets stay mapped */
+inline Graph64 build_graph64(const GraphInput& in, bool bipartite, int threads = 0) {
+    if (in.binary && in.wide) return in.graph64;
+    if (in.binary) {
+        const Graph& g = in.graph;
+        struct Widened {
+            Graph source;
+            std::vector<int64_t> offsets;
+        };
+        auto w = std::make_shared<Widened>();
+        w->source = g;
+        w->offsets.assign(g.offsets(), g.offsets() + g.num_vertices() + 1);
+        return Graph64::view(g.num_vertices(), g.num_right(), g.is_bipartite(), g.num_arcs(),
+                             w->offsets.data(), g.targets(), w);
+    }
+    return bipartite ? Graph64::bipartite(in.text.n, in.text.n_right, in.text.edges, threads)
+                     : Graph64::general(in.text.n, in.text.edges, threads);
+}
+
+/* g as a text edge list in the format the loaders read: each edge once,
+   sorted. False (with a message) on I/O error. */
+template <class Arc>
+inline bool write_text_graph(const char* path, const BasicGraph<Arc>& g) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "Cannot open file for writing: %s\n", path); return false; }
+    long long m = (long long)g.num_edges();
+    if (g.is_bipartite()) fprintf(f, "%d %d %lld\n", g.num_vertices(), g.num_right(), m);
+    else fprintf(f, "%d %lld\n", g.num_vertices(), m);
+    for (int u = 0; u < g.num_vertices(); u++)
+        for (int v : g.neighbors(u))
+            if (g.is_bipartite() || u < v) fprintf(f, "%d %d\n", u, v);
+    bool ok = fclose(f) == 0;
+    if (!ok) fprintf(stderr, "Write failed: %s\n", path);
+    return ok;
+}
+
+} // namespace matching
@@ -0,0 +1,293 @@
+/*
+ * NUMA placement for the parallel engines (Linux only): where threads run
+ * and where the pages of the shared arrays live.
+ *
+ * Topology comes from /sys/devices/system/node (no libnuma): the CPUs of
+ * each node, restricted to those the process may run on when first
+ * asked. A machine without that directory, or any other platform, is one
+ * node holding every hardware thread, and every call below is then a
+ * no-op that succeeds.
+ *
+ * Threads (--pin, Options::pin): cpu_plan() lists one CPU per thread,
+ * compact (the first node's CPUs, then the next node's) or spread (one
+ * CPU of each node in turn). apply_affinity() installs the plan
+ * (parallel.hpp, set_thread_cpus): thread t of every ThreadPool and
+ * run_parallel() then runs on the plan's CPU t.
+ *
+ * Memory (--numa, Options::numa), applied to the CSR in solve_graph()
+ * and to the matching arrays of the engines that split work by vertex
+ * range (hopcroft_karp):
+ *
+ *   first-touch  the part t of the chunk_begin() split of [0, n) goes to
+ *                the node of thread t, where first touch by the thread
+ *                that works on it would have put it. Arrays that are
+ *                already written (mates, the CSR) have their pages moved
+ *                there; new ones are first written by their own thread.
+ *                Without --pin this pins threads spread, so that thread t
+ *                stays next to its part.
+ *   interleave   pages round-robin over the nodes, for arrays every
+ *                thread reads at random.
+ *
+ * Placement goes through mbind(2) with MPOL_MF_MOVE and is best effort:
+ * the kernel leaves pages it cannot move (a page-cache page of a mapped
+ * .csr that another process maps too) where they are. It never changes
+ * a result, only where it is computed from.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "parallel.hpp"
+#include "solver.hpp"
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace matching {
+
+/* Nodes and their CPUs, in node order; never empty */
+struct NumaTopology {
+    std::vector<int> node_id;                 /* kernel node number */
+    std::vector<std::vector<int>> node_cpus;  /* allowed CPUs of each node, ascending */
+    std::vector<int> cpu_node;                /* per CPU: index into node_cpus, -1 = not allowed */
+
+    int nodes() const { return (int)node_cpus.size(); }
+    int node_of(int cpu) const { return cpu >= 0 && cpu < (int)cpu_node.size() ? cpu_node[cpu] : -1; }
+};
+
+/* "0-3,8,10-11" (sysfs cpulist) as a list of CPUs */
+inline std::vector<int> parse_cpu_list(const std::string& s) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t end = s.find(',', pos);
+        if (end == std::string::npos) end = s.size();
+        std::string item = s.substr(pos, end - pos);
+        size_t dash = item.find('-');
+        if (!item.empty() && item[0] >= '0' && item[0] <= '9') {
+            int lo = atoi(item.c_str()), hi = dash == std::string::npos ? lo : atoi(item.c_str() + dash + 1);
+            for (int c = lo; c <= hi; c++) cpus.push_back(c);
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+inline NumaTopology read_numa_topology() {
+    NumaTopology topo;
+    std::vector<int> allowed;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    bool masked = sched_getaffinity(0, sizeof set, &set) == 0;
+    std::vector<int> ids;
+    if (DIR* d = opendir("/sys/devices/system/node")) {
+        while (dirent* e = readdir(d))
+            if (strncmp(e->d_name, "node", 4) == 0 && e->d_name[4] >= '0' && e->d_name[4] <= '9')
+                ids.push_back(atoi(e->d_name + 4));
+        closedir(d);
+    }
+    std::sort(ids.begin(), ids.end());
+    for (int id : ids) {
+        std::string path = "/sys/devices/system/node/node" + std::to_string(id) + "/cpulist";
+        FILE* f = fopen(path.c_str(), "r");
+        if (!f) continue;
+        char line[4096];
+        std::string list = fgets(line, sizeof line, f) ? line : "";
+        fclose(f);
+        std::vector<int> cpus;
+        for (int c : parse_cpu_list(list))
+            if (c < CPU_SETSIZE && (!masked || CPU_ISSET(c, &set))) cpus.push_back(c);
+        if (cpus.empty()) continue;   /* memory-only node, or none of its CPUs allowed */
+        topo.node_id.push_back(id);
+        topo.node_cpus.push_back(cpus);
+    }
+    if (topo.node_cpus.empty() && masked)
+        for (int c = 0; c < CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &set)) allowed.push_back(c);
+#endif
+    if (topo.node_cpus.empty()) {
+        if (allowed.empty())
+            for (int c = 0; c < resolve_threads(0); c++) allowed.push_back(c);
+        topo.node_id.push_back(0);
+        topo.node_cpus.push_back(allowed);
+    }
+    for (int k = 0; k < topo.nodes(); k++)
+        for (int c : topo.node_cpus[k]) {
+            if (c >= (int)topo.cpu_node.size()) topo.cpu_node.resize(c + 1, -1);
+            topo.cpu_node[c] = k;
+        }
+    return topo;
+}
+
+/* The topology, read once */
+inline const NumaTopology& numa_topology() {
+    static const NumaTopology topo = read_numa_topology();
+    return topo;
+}
+
+/* One CPU per thread under `policy` (PIN_COMPACT or PIN_SPREAD), on the
+   first `nodes` nodes only when nodes > 0; more threads than CPUs wrap
+   around. Empty for PIN_NONE. */
+inline std::vector<int> cpu_plan(int threads, int policy, int nodes = 0) {
+    const NumaTopology& topo = numa_topology();
+    int k = nodes > 0 ? std::min(nodes, topo.nodes()) : topo.nodes();
+    std::vector<int> order;
+    if (policy == PIN_COMPACT) {
+        for (int i = 0; i < k; i++) order.insert(order.end(), topo.node_cpus[i].begin(), topo.node_cpus[i].end());
+    } else if (policy == PIN_SPREAD) {
+        for (size_t j = 0; (int)order.size() < threads; j++) {
+            bool any = false;
+            for (int i = 0; i < k; i++)
+                if (j < topo.node_cpus[i].size()) { order.push_back(topo.node_cpus[i][j]); any = true; }
+            if (!any) break;
+        }
+    }
+    std::vector<int> plan;
+    for (int t = 0; t < threads && !order.empty(); t++) plan.push_back(order[t % order.size()]);
+    return plan;
+}
+
+/* Node (topology index) of thread t under the current plan; -1 without one */
+inline int plan_node(int t) {
+    const std::vector<int>& cpus = thread_cpus();
+    if (cpus.empty()) return -1;
+    return numa_topology().node_of(cpus[t % cpus.size()]);
+}
+
+/* Install the plan --pin asks for (spread for --numa first-touch without
+   --pin) for resolve_threads(opt.threads) threads. Reports on stderr and
+   returns false if the kernel refuses it; threads then run unpinned. */
+inline bool apply_affinity(const Options& opt, int threads = 0) {
+    int policy = opt.pin != PIN_NONE ? opt.pin : opt.numa == NUMA_FIRST_TOUCH ? PIN_SPREAD : PIN_NONE;
+    if (policy == PIN_NONE) return true;
+    std::vector<int> plan = cpu_plan(threads > 0 ? threads : resolve_threads(opt.threads), policy);
+    if (set_thread_cpus(plan)) return true;
+    fprintf(stderr, "Could not pin threads (--pin %s); running unpinned\n",
+            policy == PIN_COMPACT ? "compact" : "spread");
+    set_thread_cpus({});
+    return false;
+}
+
+/* Threads of the plan grouped by node, for per-socket queues. One group
+   when there is no plan or it stays on one node. */
+struct SocketGroups {
+    int count = 1;
+    std::vector<int> socket;   /* per thread: its group */
+    std::vector<int> rank;     /* per thread: its index inside the group */
+    std::vector<int> size;     /* per group: threads */
+    std::vector<int> leader;   /* per group: lowest thread */
+};
+
+inline SocketGroups socket_groups(int threads) {
+    SocketGroups g;
+    std::vector<int> index(numa_topology().nodes() + 1, -1);
+    g.count = 0;
+    for (int t = 0; t < threads; t++) {
+        int node = plan_node(t) + 1;   /* 0: unpinned, or a CPU outside the topology */
+        if (index[node] < 0) {
+            index[node] = g.count++;
+            g.size.push_back(0);
+            g.leader.push_back(t);
+        }
+        g.socket.push_back(index[node]);
+        g.rank.push_back(g.size[index[node]]++);
+    }
+    if (g.count == 0) { g.count = 1; g.size.push_back(0); g.leader.push_back(0); }
+    return g;
+}
+
+/* ---- memory placement ---- */
+
+static const int MBIND_PREFERRED = 1;    /* MPOL_PREFERRED */
+static const int MBIND_INTERLEAVE = 3;   /* MPOL_INTERLEAVE */
+static const unsigned MBIND_MOVE = 2;    /* MPOL_MF_MOVE */
+
+/* mbind [begin, end) to `nodes` (topology indices) under `mode`, moving
+   the pages already there; the range grows to whole pages */
+inline bool mbind_range(const void* begin, const void* end, int mode, const std::vector<int>& nodes) {
+#if defined(__linux__) && defined(SYS_mbind)
+    static const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    uintptr_t a = (uintptr_t)begin & ~(uintptr_t)(page - 1), b = (uintptr_t)end;
+    if (b <= a || nodes.empty()) return true;
+    const NumaTopology& topo = numa_topology();
+    const int bits = 8 * (int)sizeof(unsigned long);
+    std::vector<unsigned long> mask(1);
+    for (int k : nodes) {
+        int id = topo.node_id[k];
+        if (id / bits >= (int)mask.size()) mask.resize(id / bits + 1, 0);
+        mask[id / bits] |= 1UL << (id % bits);
+    }
+    return syscall(SYS_mbind, a, b - a, mode, mask.data(), (unsigned long)mask.size() * bits + 1, MBIND_MOVE) == 0;
+#else
+    (void)begin;
+    (void)end;
+    (void)mode;
+    (void)nodes;
+    return false;
+#endif
+}
+
+/* Place bytes [cut[t], cut[t + 1]) of `base` as part t of parts =
+   cut.size() - 1 under `placement`. Parts meet at page boundaries, a
+   shared page going to the later part. */
+inline bool numa_place_bytes(const char* base, const std::vector<size_t>& cut, int placement) {
+    const NumaTopology& topo = numa_topology();
+    int parts = (int)cut.size() - 1;
+    if (placement == NUMA_NONE || topo.nodes() < 2 || parts < 1 || cut[parts] == cut[0]) return true;
+    std::vector<int> all;
+    for (int t = 0; t < parts; t++) {
+        int k = plan_node(t);
+        if (k < 0) k = (int)((long long)t * topo.nodes() / parts);   /* no plan: blocks of parts per node */
+        if (std::find(all.begin(), all.end(), k) == all.end()) all.push_back(k);
+    }
+    if (placement == NUMA_INTERLEAVE)
+        return mbind_range(base + cut[0], base + cut[parts], MBIND_INTERLEAVE, all);
+    static const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    bool ok = true;
+    for (int t = 0; t < parts; t++) {
+        size_t lo = t == 0 ? cut[0] : cut[t] & ~(page - 1);
+        size_t hi = t + 1 == parts ? cut[parts] : cut[t + 1] & ~(page - 1);
+        if (hi <= lo) continue;   /* part inside a page that a later part takes */
+        int k = plan_node(t);
+        if (k < 0) k = (int)((long long)t * topo.nodes() / parts);
+        ok = mbind_range(base + lo, base + hi, MBIND_PREFERRED, {k}) && ok;
+    }
+    return ok;
+}
+
+/* a[0, n), split into `parts` vertex ranges as chunk_begin() splits work */
+template <class T>
+inline bool numa_place(const T* a, size_t n, int placement, int parts) {
+    if (placement == NUMA_NONE || numa_topology().nodes() < 2) return true;
+    std::vector<size_t> cut(parts + 1);
+    for (int t = 0; t <= parts; t++) cut[t] = chunk_begin(n, parts, t) * sizeof(T);
+    return numa_place_bytes((const char*)a, cut, placement);
+}
+
+/* A CSR graph: offsets by vertex range, each range's arcs with it */
+template <class G>
+inline bool numa_place_graph(const G& g, int placement, int parts) {
+    if (placement == NUMA_NONE || numa_topology().nodes() < 2) return true;
+    size_t n = (size_t)g.num_vertices();
+    std::vector<size_t> vcut(parts + 1), acut(parts + 1);
+    for (int t = 0; t <= parts; t++) {
+        size_t v = chunk_begin(n, parts, t);
+        vcut[t] = (t == parts ? n + 1 : v) * sizeof(*g.offsets());
+        acut[t] = (size_t)g.offsets()[v] * sizeof(int);
+    }
+    bool ok = numa_place_bytes((const char*)g.offsets(), vcut, placement);
+    return numa_place_bytes((const char*)g.targets(), acut, placement) && ok;
+}
+
+} // namespace matching
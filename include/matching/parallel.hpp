@@ -0,0 +1,171 @@
+/*
+ * Fork-join helpers over std::thread.
+ *
+ * Work is split into contiguous, statically assigned ranges; per-range
+ * results are combined in range order, so output never depends on the
+ * thread count or on scheduling.
+ *
+ * run_parallel() starts fresh threads and suits one-off passes (loading,
+ * CSR build). ThreadPool keeps its workers for algorithms that fork and
+ * join many times, e.g. once per BFS level.
+ *
+ * pin_to_cpus() binds the calling thread, and every thread it starts
+ * afterwards, to a CPU range (Linux only), for stable benchmark timings.
+ * set_thread_cpus() instead gives each thread its own CPU: thread t of
+ * run_parallel() and of every ThreadPool pins itself to the plan's CPU t
+ * when it starts (numa.hpp builds the plans).
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace matching {
+
+/* Items per thread below which spawning threads does not pay off */
+static const size_t PARALLEL_GRAIN = 1 << 16;
+
+/* Requested thread count; 0 (or less) means all hardware threads */
+inline int resolve_threads(int requested) {
+    if (requested > 0) return requested;
+    unsigned hc = std::thread::hardware_concurrency();
+    return hc > 0 ? (int)hc : 1;
+}
+
+/* Threads worth using for `work` items, at most `threads` */
+inline int threads_for(size_t work, int threads) {
+    size_t useful = std::max<size_t>(1, work / PARALLEL_GRAIN);
+    return (int)std::min<size_t>((size_t)resolve_threads(threads), useful);
+}
+
+/* Start of the t-th of `parts` contiguous chunks of [0, n) */
+inline size_t chunk_begin(size_t n, int parts, int t) {
+    return n / parts * t + std::min<size_t>((size_t)t, n % parts);
+}
+
+/* Restrict the calling thread to CPUs [first, first + count); threads it
+   starts later inherit the mask. False if unsupported or refused. */
+inline bool pin_to_cpus(int first, int count) {
+#if defined(__linux__)
+    if (first < 0 || count < 1 || first + count > CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c = first; c < first + count; c++) CPU_SET(c, &set);
+    return sched_setaffinity(0, sizeof set, &set) == 0;
+#else
+    (void)first;
+    (void)count;
+    return false;
+#endif
+}
+
+/* The per-thread CPU plan; empty (the default) leaves threads unpinned.
+   Set it between parallel runs only. */
+inline std::vector<int>& thread_cpus() {
+    static std::vector<int> cpus;
+    return cpus;
+}
+
+/* Pin the calling thread as thread t of the plan (CPU cpus[t % size]);
+   true when there is no plan */
+inline bool pin_thread(int t) {
+    const std::vector<int>& cpus = thread_cpus();
+    return cpus.empty() || pin_to_cpus(cpus[t % cpus.size()], 1);
+}
+
+/* Install a plan and pin the caller, which runs t = 0 of every fork */
+inline bool set_thread_cpus(std::vector<int> cpus) {
+    thread_cpus() = std::move(cpus);
+    return pin_thread(0);
+}
+
+/* Run fn(t) for t in [0, threads) and wait; the caller runs t = 0 */
+template <class F>
+inline void run_parallel(int threads, F&& fn) {
+    if (threads <= 1) { fn(0); return; }
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; t++) pool.emplace_back([&fn, t] { pin_thread(t); fn(t); });
+    fn(0);
+    for (auto& th : pool) th.join();
+}
+
+/* Persistent fork-join pool: run(fn) calls fn(t) for t in [0, size()),
+   the caller taking t = 0, and returns when every call has finished. */
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads) {
+        int n = resolve_threads(threads);
+        for (int t = 1; t < n; t++) workers_.emplace_back([this, t] { work(t); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& th : workers_) th.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers_.size() + 1; }
+
+    template <class F>
+    void run(F&& fn) {
+        if (workers_.empty()) { fn(0); return; }
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            job_ = std::ref(fn);
+            pending_ = (int)workers_.size();
+            generation_++;
+        }
+        start_.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> lock(mu_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mu_;
+    std::condition_variable start_, done_;
+    std::function<void(int)> job_;
+    uint64_t generation_ = 0;
+    int pending_ = 0;
+    bool stop_ = false;
+
+    void work(int t) {
+        pin_thread(t);
+        uint64_t seen = 0;
+        for (;;) {
+            std::function<void(int)> job;
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+            }
+            job(t);
+            std::lock_guard<std::mutex> lock(mu_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+};
+
+} // namespace matching
@@ -0,0 +1,110 @@
+/*
+ * Hardware event counters around a region of code (Linux perf_event).
+ *
+ * The counters follow the calling thread and every thread it creates
+ * while they run (inherit), user space only. A child's counts are added
+ * when it exits, so a solver's thread pool is counted once the solver is
+ * gone. Each event is opened on its own, so a kernel that lacks one event
+ * still reports the others.
+ *
+ *   cycles         CPU cycles
+ *   cache_misses   last-level cache misses on most CPUs (the generic
+ *                  PERF_COUNT_HW_CACHE_MISSES event)
+ *   branch_misses  mispredicted branches
+ *
+ * Opening fails without perf_event support or when
+ * /proc/sys/kernel/perf_event_paranoid forbids it (common in containers);
+ * an event that could not be opened reads as -1. Other platforms get the
+ * same interface with nothing available.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace matching {
+
+static const int PERF_CYCLES = 0;
+static const int PERF_CACHE_MISSES = 1;
+static const int PERF_BRANCH_MISSES = 2;
+static const int PERF_EVENTS = 3;
+
+inline const char* perf_event_name(int e) {
+    return e == PERF_CYCLES ? "cycles" : e == PERF_CACHE_MISSES ? "cache_misses" : "branch_misses";
+}
+
+class PerfCounters {
+public:
+    PerfCounters() {
+        for (int e = 0; e < PERF_EVENTS; e++) fd_[e] = -1;
+#if defined(__linux__)
+        static const uint64_t config[PERF_EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            perf_event_attr a;
+            memset(&a, 0, sizeof a);
+            a.size = sizeof a;
+            a.type = PERF_TYPE_HARDWARE;
+            a.config = config[e];
+            a.disabled = 1;
+            a.inherit = 1;
+            a.exclude_kernel = 1;
+            a.exclude_hv = 1;
+            fd_[e] = (int)syscall(SYS_perf_event_open, &a, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int e = 0; e < PERF_EVENTS; e++)
+            if (fd_[e] >= 0) close(fd_[e]);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(int e) const { return fd_[e] >= 0; }
+    bool any_available() const {
+        for (int e = 0; e < PERF_EVENTS; e++)
+            if (available(e)) return true;
+        return false;
+    }
+
+    /* Zero and start every open counter */
+    void start() {
+#if defined(__linux__)
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            if (fd_[e] < 0) continue;
+            ioctl(fd_[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /* Stop counting and store the counts in out[PERF_EVENTS] (-1: unavailable) */
+    void stop(long long* out) {
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            out[e] = -1;
+#if defined(__linux__)
+            if (fd_[e] < 0) continue;
+            ioctl(fd_[e], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t v = 0;
+            if (read(fd_[e], &v, sizeof v) == (ssize_t)sizeof v) out[e] = (long long)v;
+#endif
+        }
+    }
+
+private:
+    int fd_[PERF_EVENTS];
+};
+
+} // namespace matching
@@ -0,0 +1,172 @@
+/*
+ * Vertex reordering before the solve (--reorder rcm|degree|bfs).
+ *
+ * Inputs arrive in arbitrary numbering, and every per-vertex array a
+ * solver touches (mate, label, base, dist, ...) follows that numbering. A
+ * numbering in which neighbors get nearby ids keeps those accesses close
+ * together. The graph is relabeled once, solved, and the matching is mapped
+ * back to the input ids.
+ *
+ *   rcm       reverse Cuthill-McKee: BFS from a minimum-degree vertex of
+ *             each component, visiting neighbors by ascending degree, then
+ *             the whole order reversed
+ *   degree    by descending degree, so the hubs share cache lines
+ *   bfs       plain BFS order from the lowest unvisited id, neighbors in
+ *             adjacency (ascending id) order
+ *
+ * Bipartite graphs are ordered on the combined vertex set (right vertex v
+ * is num_vertices() + v). Each side is then numbered by its own
+ * vertices' positions in that order.
+ *
+ * Every tie breaks by the input id, so the permutation, and with it the
+ * matching, depends only on the graph. The matching can differ from an
+ * unreordered run, because greedy choices and search order follow vertex
+ * ids.
+ */
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "graph.hpp"
+#include "solver.hpp"
+
+namespace matching {
+
+/* new id of every vertex; right is empty for general graphs */
+struct Permutation {
+    std::vector<int> left, right;
+};
+
+namespace detail {
+
+/* Combined adjacency: right vertex v of a bipartite graph is left + v */
+template <class G>
+struct OrderView {
+    const G& g;
+    G rev;
+    int left, nv;
+
+    OrderView(const G& graph, int threads)
+        : g(graph), left(graph.num_vertices()),
+          nv(graph.is_bipartite() ? graph.num_vertices() + graph.num_right() : graph.num_vertices()) {
+        if (g.is_bipartite()) rev = g.transposed(threads);
+    }
+    int degree(int x) const { return x < left ? g.degree(x) : rev.degree(x - left); }
+    template <class F> void for_neighbors(int x, F&& f) const {
+        if (!g.is_bipartite()) { for (int v : g.neighbors(x)) f(v); return; }
+        if (x < left) for (int v : g.neighbors(x)) f(left + v);
+        else for (int u : rev.neighbors(x - left)) f(u);
+    }
+};
+
+/* Vertices 0..nv-1 stably sorted by degree (counting sort) */
+template <class G>
+inline std::vector<int> by_degree(const OrderView<G>& view, bool descending) {
+    int maxd = 0;
+    for (int x = 0; x < view.nv; x++) maxd = std::max(maxd, view.degree(x));
+    std::vector<int> count(maxd + 2, 0), out(view.nv);
+    auto key = [&](int x) { return descending ? maxd - view.degree(x) : view.degree(x); };
+    for (int x = 0; x < view.nv; x++) count[key(x) + 1]++;
+    for (int d = 0; d <= maxd; d++) count[d + 1] += count[d];
+    for (int x = 0; x < view.nv; x++) out[count[key(x)]++] = x;
+    return out;
+}
+
+/* BFS over every component, roots taken in `roots` sequence; with
+   by_deg, each vertex's unvisited neighbors are queued by ascending
+   degree (ties: by id) */
+template <class G>
+inline std::vector<int> bfs_order(const OrderView<G>& view, const std::vector<int>& roots, bool by_deg) {
+    std::vector<int> order;
+    order.reserve(view.nv);
+    std::vector<char> seen(view.nv, 0);
+    std::vector<int> fresh;
+    for (int r : roots) {
+        if (seen[r]) continue;
+        seen[r] = 1;
+        order.push_back(r);
+        for (size_t qh = order.size() - 1; qh < order.size(); qh++) {
+            fresh.clear();
+            view.for_neighbors(order[qh], [&](int y) {
+                if (!seen[y]) { seen[y] = 1; fresh.push_back(y); }
+            });
+            if (by_deg)
+                std::stable_sort(fresh.begin(), fresh.end(), [&](int a, int b) {
+                    return view.degree(a) < view.degree(b);
+                });
+            order.insert(order.end(), fresh.begin(), fresh.end());
+        }
+    }
+    return order;
+}
+
+} // namespace detail
+
+/* Permutation for `method` (REORDER_*) */
+template <class G>
+inline Permutation vertex_order(const G& g, int method, int threads = 0) {
+    detail::OrderView<G> view(g, threads);
+    std::vector<int> order;
+    if (method == REORDER_DEGREE) {
+        order = detail::by_degree(view, true);
+    } else if (method == REORDER_RCM) {
+        order = detail::bfs_order(view, detail::by_degree(view, false), true);
+        std::reverse(order.begin(), order.end());
+    } else {
+        std::vector<int> ids(view.nv);
+        for (int x = 0; x < view.nv; x++) ids[x] = x;
+        order = detail::bfs_order(view, ids, false);
+    }
+
+    Permutation p;
+    p.left.resize(view.left);
+    if (g.is_bipartite()) p.right.resize(g.num_right());
+    int nl = 0, nr = 0;
+    for (int x : order) {
+        if (x < view.left) p.left[x] = nl++;
+        else p.right[x - view.left] = nr++;
+    }
+    return p;
+}
+
+/* g with vertex x renamed to p[x] */
+template <class G>
+inline G permute_graph(const G& g, const Permutation& p, int threads = 0) {
+    EdgeList edges;
+    edges.reserve((size_t)g.num_edges());
+    for (int u = 0; u < g.num_vertices(); u++)
+        for (int v : g.neighbors(u)) {
+            if (g.is_bipartite()) edges.push_back({p.left[u], p.right[v]});
+            else if (u < v) edges.push_back({p.left[u], p.left[v]});
+        }
+    if (g.is_bipartite()) return G::bipartite(g.num_vertices(), g.num_right(), edges, threads);
+    return G::general(g.num_vertices(), edges, threads);
+}
+
+/* Pairs renamed by p (forward) or by its inverse, normalized and sorted;
+   pairs with out-of-range ends are dropped */
+inline Matching permute_matching(const Matching& m, const Permutation& p, bool inverse) {
+    const std::vector<int>& second = p.right.empty() ? p.left : p.right;
+    std::vector<int> inv_left, inv_right;
+    if (inverse) {
+        inv_left.resize(p.left.size());
+        for (size_t x = 0; x < p.left.size(); x++) inv_left[p.left[x]] = (int)x;
+        inv_right.resize(second.size());
+        for (size_t x = 0; x < second.size(); x++) inv_right[second[x]] = (int)x;
+    }
+    const std::vector<int>& a = inverse ? inv_left : p.left;
+    const std::vector<int>& b = inverse ? inv_right : second;
+    Matching out;
+    out.reserve(m.size());
+    for (const auto& e : m) {
+        if (e.first < 0 || e.second < 0 || e.first >= (int)a.size() || e.second >= (int)b.size()) continue;
+        int x = a[e.first], y = b[e.second];
+        if (p.right.empty() && x > y) std::swap(x, y);
+        out.push_back({x, y});
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+} // namespace matching
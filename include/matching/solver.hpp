@@ -0,0 +1,117 @@
+/*
+ * Common solver interface.
+ *
+ * Every algorithm header exposes
+ *
+ *     matching::Result <algorithm>::solve(const matching::Graph&, const matching::Options&);
+ *
+ * so one loaded graph can be handed to any solver.
+ */
+#pragma once
+
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+#include "stats.hpp"
+
+namespace matching {
+
+/* Initial matching heuristics (greedy_mode) */
+static const int GREEDY_NONE = 0;
+static const int GREEDY_FIRST = 1;       /* --greedy: first free neighbor */
+static const int GREEDY_MIN_DEGREE = 2;  /* --greedy-md: lowest-degree free neighbor */
+static const int GREEDY_KARP_SIPSER = 3; /* --karp-sipser: degree-1 rule, else random edge */
+
+/* BFS scan kernels (scan, frontier_scan.hpp) */
+static const int SCAN_AUTO = 0;          /* widest the CPU supports */
+static const int SCAN_SCALAR = 1;        /* --scan scalar */
+static const int SCAN_AVX2 = 2;          /* --scan avx2 */
+static const int SCAN_AVX512 = 3;        /* --scan avx512 */
+
+/* Vertex reordering before the solve (reorder, reorder.hpp) */
+static const int REORDER_NONE = 0;
+static const int REORDER_RCM = 1;        /* --reorder rcm: reverse Cuthill-McKee */
+static const int REORDER_DEGREE = 2;     /* --reorder degree: descending degree */
+static const int REORDER_BFS = 3;        /* --reorder bfs: BFS order */
+
+/* Memory placement over NUMA nodes (numa, numa.hpp) */
+static const int NUMA_NONE = 0;
+static const int NUMA_FIRST_TOUCH = 1;   /* --numa first-touch: vertex range t on thread t's node */
+static const int NUMA_INTERLEAVE = 2;    /* --numa interleave: pages round-robin over the nodes */
+
+/* Thread affinity (pin, numa.hpp) */
+static const int PIN_NONE = 0;
+static const int PIN_COMPACT = 1;        /* --pin compact: fill one node before the next */
+static const int PIN_SPREAD = 2;         /* --pin spread: one CPU per node in turn */
+
+/* Matched pairs (u, v), sorted. For general graphs u < v; for
+   bipartite graphs u is the left vertex and v the right one. */
+using Matching = std::vector<std::pair<int,int>>;
+
+struct Options {
+    int greedy_mode = GREEDY_NONE;
+    int threads = 0;       /* --threads N: worker threads; 0 = all hardware threads for loading, 1 for the solve */
+    bool deterministic = false;  /* --deterministic: parallel runs reproduce the serial matching */
+    bool components = false;     /* --components: solve each connected component separately */
+    const Matching* initial = nullptr;  /* --initial FILE: prior matching to start from (warm_start.hpp) */
+    int scan = SCAN_AUTO;  /* --scan ISA: BFS scan kernel (frontier_scan.hpp) */
+    int reorder = REORDER_NONE;  /* --reorder: relabel vertices first (solve_graph) */
+    bool compressed = false;     /* --compressed: search on gap-encoded rows (compressed_graph.hpp) */
+    bool index64 = false;        /* --index64: 64-bit arc offsets (Graph64) even when int would do */
+    bool stats_json = false;     /* --stats=json: print the counters and timers (stats.hpp) */
+    double epsilon = 0;          /* --epsilon E: stop once the matching is within 1 - E of maximum */
+    int numa = NUMA_NONE;        /* --numa: placement of the CSR and matching arrays (numa.hpp) */
+    int pin = PIN_NONE;          /* --pin: one CPU per worker thread (numa.hpp, apply_affinity) */
+};
+
+struct Result {
+    Matching matching;
+    int greedy_size = 0;   /* size of the initial matching, 0 without greedy */
+    double greedy_ms = 0;  /* time spent building it (summed over components) */
+    int components = 0;    /* components with edges, with --components */
+    int initial_size = 0;  /* pairs of opt.initial still valid and kept */
+    double reorder_ms = 0; /* computing and applying --reorder, and mapping back */
+    double compress_ms = 0;       /* encoding the rows, with --compressed */
+    long long csr_bytes = 0;      /* CSR the compressed graph was built from */
+    long long compressed_bytes = 0;  /* the compressed graph */
+    Stats stats;           /* counters and stage timers, with MATCHING_STATS (stats.hpp) */
+    int path_bound = 0;    /* --epsilon stopped early: no augmenting path has fewer edges; 0 = ran to the end */
+};
+
+/* Threads for a solver's own parallel phases: --threads N when given,
+   else 1. Loading and building use every hardware thread by default
+   (threads = 0), which cannot change a result; a parallel search can, so
+   it runs only on request. */
+inline int solve_threads(const Options& opt) {
+    return opt.threads > 0 ? opt.threads : 1;
+}
+
+/* Threads for the initial matching: parallel only with --threads N > 1
+   and without --deterministic, the runs that need not be reproducible */
+inline int init_threads(const Options& opt) {
+    return opt.deterministic ? 1 : solve_threads(opt);
+}
+
+/* --epsilon: when every augmenting path has at least 2k + 1 edges, the
+   matching holds at least k / (k + 1) of a maximum one (Hopcroft and
+   Karp). The phase solvers (hk, gabow-opt, mv-pure) stop before a phase
+   whose paths would be this long, the least 2k + 1 with
+   k / (k + 1) >= 1 - eps; k >= 1, so the matching is always maximal.
+   INT_MAX (never stop) for eps <= 0. */
+inline int epsilon_path_length(double eps) {
+    if (!(eps > 0)) return INT_MAX;
+    double k = std::ceil((1 - eps) / eps - 1e-9);
+    if (k < 1) k = 1;
+    return k >= INT_MAX / 2 ? INT_MAX : 2 * (int)k + 1;
+}
+
+/* Milliseconds since `start` */
+inline double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace matching
@@ -0,0 +1,112 @@
+/*
+ * Per-phase counters and stage timers (--stats=json).
+ *
+ * Solvers count what their searches do (phases, BFS and DFS passes, arcs
+ * scanned, blossoms, bridges) and time their stages, so a run can be
+ * explained rather than just timed. Everything goes through the
+ * MATCHING_STAT macros below, which expand to nothing unless the binary is
+ * built with -DMATCHING_STATS=1: a default build keeps no counters and
+ * reads no clocks. With stats compiled in, --stats=json prints one line
+ *
+ *   Stats: {"phases": 12, "bfs_arcs": 81234, ..., "search_ns": 40512345}
+ *
+ * Values are integers in one flat object, in order of first use. Every
+ * solver reports the same four stage timers (StageTimes), in nanoseconds:
+ *
+ *   setup_ns    allocating the solver's state
+ *   init_ns     --initial and the greedy / Karp-Sipser matching
+ *   search_ns   looking for augmenting paths (BFS, DFS, blossom search)
+ *   augment_ns  flipping the paths found and cleaning up after them
+ *
+ * Counters and timers are plain members the hot loops bump; a solver
+ * hands them to its Stats once, at the end, so counting costs an add and
+ * timing two clock reads. With --components the parts' values are summed.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef MATCHING_STATS
+#define MATCHING_STATS 0
+#endif
+
+#if MATCHING_STATS
+#define MATCHING_STAT(...) __VA_ARGS__
+#define MATCHING_STAT_JOIN2(a, b) a##b
+#define MATCHING_STAT_JOIN(a, b) MATCHING_STAT_JOIN2(a, b)
+#define MATCHING_STAT_TIMER(total) \
+    ::matching::StatTimer MATCHING_STAT_JOIN(stat_timer_, __LINE__)(total)
+#define MATCHING_STAT_TIMER_IN(total, outer) \
+    ::matching::StatTimer MATCHING_STAT_JOIN(stat_timer_, __LINE__)(total, &(outer))
+#else
+#define MATCHING_STAT(...)
+#define MATCHING_STAT_TIMER(total)
+#define MATCHING_STAT_TIMER_IN(total, outer)
+#endif
+
+namespace matching {
+
+static const bool STATS_ENABLED = MATCHING_STATS != 0;
+
+/* Named integer values, summed per name */
+struct Stats {
+    std::vector<std::pair<std::string, long long>> values;
+
+    void add(const char* name, long long v) {
+        for (auto& e : values)
+            if (e.first == name) { e.second += v; return; }
+        values.push_back({name, v});
+    }
+
+    void merge(const Stats& o) {
+        for (const auto& e : o.values) add(e.first.c_str(), e.second);
+    }
+};
+
+/* Nanoseconds per solver stage */
+struct StageTimes {
+    long long setup = 0, init = 0, search = 0, augment = 0;
+
+    void add_to(Stats& s) const {
+        s.add("setup_ns", setup);
+        s.add("init_ns", init);
+        s.add("search_ns", search);
+        s.add("augment_ns", augment);
+    }
+};
+
+/* Adds the nanoseconds between construction and destruction to `total`.
+   A timer nested in another stage's timer names that stage's total as
+   `outer` and takes its time back out of it, so stages stay disjoint. */
+class StatTimer {
+public:
+    explicit StatTimer(long long& total, long long* outer = nullptr)
+        : total_(total), outer_(outer), t0_(std::chrono::steady_clock::now()) {}
+    ~StatTimer() {
+        long long ns = (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - t0_).count();
+        total_ += ns;
+        if (outer_) *outer_ -= ns;
+    }
+    StatTimer(const StatTimer&) = delete;
+    StatTimer& operator=(const StatTimer&) = delete;
+
+private:
+    long long& total_;
+    long long* outer_;
+    std::chrono::steady_clock::time_point t0_;
+};
+
+/* The "Stats:" line; names are identifiers, so nothing needs escaping */
+inline void print_stats(const Stats& s) {
+    printf("Stats: {");
+    for (size_t i = 0; i < s.values.size(); i++)
+        printf("%s\"%s\": %lld", i ? ", " : "", s.values[i].first.c_str(), s.values[i].second);
+    printf("}\n");
+}
+
+} // namespace matching
@@ -0,0 +1,222 @@
+/*
+ * Parallel text edge-list parser.
+ *
+ * The file is memory-mapped, split into T chunks at whitespace boundaries
+ * (a chunk never starts inside a number) and each chunk is scanned for
+ * integers on its own thread. Chunk results are stitched together in file
+ * order, so the edge list is exactly what a sequential fscanf("%d %d")
+ * loop reads: the first E pairs, stopping early at EOF or at the first
+ * malformed token.
+ *
+ * The scanner classifies 16 bytes at a time with SSE2 (part of the x86-64
+ * baseline, no -march flag needed) to skip whitespace runs and to find the
+ * length of each digit run; the last 16 bytes of a chunk use the scalar
+ * path. Other targets use the scalar path throughout.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "graph.hpp"
+#include "parallel.hpp"
+
+namespace matching {
+
+/* Whitespace as accepted by scanf: ' ', \t, \n, \v, \f, \r */
+inline bool is_space_char(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+#if defined(__SSE2__)
+/* Bit i set when byte i of x lies in [lo, hi] (unsigned) */
+inline unsigned byte_range_mask(__m128i x, char lo, char hi) {
+    __m128i ge = _mm_cmpeq_epi8(_mm_max_epu8(x, _mm_set1_epi8(lo)), x);
+    __m128i le = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(hi)), x);
+    return (unsigned)_mm_movemask_epi8(_mm_and_si128(ge, le));
+}
+
+inline unsigned space_mask16(const char* p) {
+    __m128i x = _mm_loadu_si128((const __m128i*)p);
+    return byte_range_mask(x, '\t', '\r') |
+           (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+}
+
+inline unsigned digit_mask16(const char* p) {
+    return byte_range_mask(_mm_loadu_si128((const __m128i*)p), '0', '9');
+}
+#endif
+
+/* Sequential scanner over [p, end) */
+struct IntScanner {
+    const char* p;
+    const char* end;
+
+    void skip_space() {
+#if defined(__SSE2__)
+        while (p + 16 <= end) {
+            unsigned non_space = ~space_mask16(p) & 0xFFFFu;
+            if (non_space) { p += __builtin_ctz(non_space); return; }
+            p += 16;
+        }
+#endif
+        while (p < end && is_space_char(*p)) p++;
+    }
+
+    /* Length of the digit run starting at p */
+    size_t digit_run() const {
+        const char* q = p;
+#if defined(__SSE2__)
+        while (q + 16 <= end) {
+            unsigned non_digit = ~digit_mask16(q) & 0xFFFFu;
+            if (non_digit) return (size_t)(q - p) + __builtin_ctz(non_digit);
+            q += 16;
+        }
+#endif
+        while (q < end && *q >= '0' && *q <= '9') q++;
+        return (size_t)(q - p);
+    }
+
+    /* Next integer; false at end of input or on a malformed token */
+    bool next(long long& x) {
+        skip_space();
+        if (p >= end) return false;
+        bool neg = false;
+        if (*p == '-' || *p == '+') { neg = *p == '-'; p++; }
+        size_t len = digit_run();
+        if (len == 0) return false;
+        long long v = 0;
+        for (size_t i = 0; i < len; i++) v = v * 10 + (p[i] - '0');
+        p += len;
+        x = neg ? -v : v;
+        return true;
+    }
+
+    bool next(int& x) {
+        long long v;
+        if (!next(v)) return false;
+        x = (int)v;
+        return true;
+    }
+};
+
+/* Integers of one chunk; `ok` is false when the chunk hit a malformed token */
+struct ParsedChunk {
+    std::vector<int> values;
+    bool ok = true;
+};
+
+/* Scan [begin, end) for integers on up to `threads` threads, one chunk
+   per thread. Returns the number of chunks to use: the chunks in file
+   order up to and including the first one that hit a malformed token.
+   first[t] is the index of chunk t's first value in that sequence, and
+   first[used] the number of values. */
+inline int scan_int_chunks(const char* begin, const char* end, int threads,
+                           std::vector<ParsedChunk>& chunks, std::vector<size_t>& first) {
+    size_t len = (size_t)(end - begin);
+    int T = threads_for(len / 8, threads);
+
+    std::vector<const char*> cut(T + 1, end);
+    cut[0] = begin;
+    for (int t = 1; t < T; t++) {
+        const char* c = begin + chunk_begin(len, T, t);
+        if (c < cut[t - 1]) c = cut[t - 1];
+        while (c < end && !is_space_char(*c)) c++;
+        cut[t] = c;
+    }
+
+    chunks.assign(T, ParsedChunk());
+    run_parallel(T, [&](int t) {
+        IntScanner sc{cut[t], cut[t + 1]};
+        ParsedChunk& pc = chunks[t];
+        pc.values.reserve((size_t)(cut[t + 1] - cut[t]) / 8 + 2);
+        int x;
+        while (sc.next(x)) pc.values.push_back(x);
+        sc.skip_space();
+        pc.ok = sc.p >= sc.end;
+    });
+
+    /* Stitch in file order, up to and including the first failing chunk */
+    first.assign(T + 1, 0);
+    int used = 0;
+    while (used < T) {
+        first[used + 1] = first[used] + chunks[used].values.size();
+        used++;
+        if (!chunks[used - 1].ok) break;
+    }
+    return used;
+}
+
+/* Parse up to `max_pairs` integer pairs from [begin, end) on `threads` threads.
+   With `weights`, records are triples "u v w" and the third integers go there. */
+inline void parse_edge_pairs(const char* begin, const char* end, long long max_pairs,
+                             int threads, EdgeList& edges, std::vector<int>* weights = nullptr) {
+    edges.clear();
+    if (weights) weights->clear();
+    if (max_pairs <= 0) return;
+    std::vector<ParsedChunk> chunks;
+    std::vector<size_t> first;
+    int used = scan_int_chunks(begin, end, threads, chunks, first);
+
+    size_t width = weights ? 3 : 2;
+    size_t pairs = first[used] / width;
+    if ((long long)pairs > max_pairs) pairs = (size_t)max_pairs;
+    edges.resize(pairs);
+    if (weights) weights->resize(pairs);
+    run_parallel(used, [&](int t) {
+        const std::vector<int>& vals = chunks[t].values;
+        size_t limit = width * pairs;
+        for (size_t i = 0; i < vals.size() && first[t] + i < limit; i++) {
+            size_t k = first[t] + i;
+            if (!weights) {
+                if (k & 1) edges[k / 2].second = vals[i];
+                else edges[k / 2].first = vals[i];
+                continue;
+            }
+            size_t r = k % 3;
+            if (r == 0) edges[k / 3].first = vals[i];
+            else if (r == 1) edges[k / 3].second = vals[i];
+            else (*weights)[k / 3] = vals[i];
+        }
+        std::vector<int>().swap(chunks[t].values);
+    });
+}
+
+/* Parse a text edge list with `header_ints` header integers (2 for "V E",
+   3 for "L R E"; the last one is the edge count, which may pass INT_MAX).
+   With `weights`, every edge line carries a third integer, its weight. */
+inline bool parse_edge_list_file(const char* path, int header_ints, int threads,
+                                 long long header[3], EdgeList& edges,
+                                 std::vector<int>* weights = nullptr) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "Cannot open file: %s\n", path); return false; }
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); fprintf(stderr, "Cannot open file: %s\n", path); return false; }
+    size_t size = (size_t)st.st_size;
+    void* addr = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    close(fd);
+    if (addr == MAP_FAILED) { fprintf(stderr, "mmap failed: %s\n", path); return false; }
+    const char* data = (const char*)addr;
+
+    IntScanner sc{data, data + size};
+    bool ok = true;
+    for (int i = 0; i < header_ints && ok; i++) ok = sc.next(header[i]);
+    /* Vertex ids are int; only the edge count may be wider */
+    for (int i = 0; i + 1 < header_ints && ok; i++) ok = header[i] >= 0 && header[i] < INT32_MAX;
+    if (!ok) fprintf(stderr, "Bad header\n");
+    else parse_edge_pairs(sc.p, data + size, header[header_ints - 1], threads, edges, weights);
+
+    if (addr) munmap(addr, size);
+    return ok;
+}
+
+} // namespace matching
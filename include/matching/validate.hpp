@@ -0,0 +1,78 @@
+/*
+ * Matching validation and the "=== Validation Report ===" block every
+ * binary prints. Checks edge existence and vertex uniqueness.
+ */
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "graph.hpp"
+#include "solver.hpp"
+
+namespace matching {
+
+/* Returns the number of errors found (0 = valid); the report block is
+   printed unless `report` is false, errors always go to stderr */
+template <class G>
+inline int validate_matching(const G& g, const Matching& matching, bool report = true) {
+    int n = g.num_vertices();
+    int errors = 0;
+
+    if (g.is_bipartite()) {
+        int rc = g.num_right();
+        std::vector<int> ldeg(n, 0), rdeg(rc, 0);
+        for (auto& e : matching) {
+            if (e.first < 0 || e.first >= n || e.second < 0 || e.second >= rc ||
+                !g.has_edge(e.first, e.second)) {
+                fprintf(stderr, "ERROR: Edge (%d, %d) not in graph!\n", e.first, e.second);
+                errors++;
+                continue;
+            }
+            ldeg[e.first]++;
+            rdeg[e.second]++;
+        }
+        for (int i = 0; i < n; i++)
+            if (ldeg[i] > 1) { fprintf(stderr, "ERROR: Left %d in %d edges!\n", i, ldeg[i]); errors++; }
+        for (int i = 0; i < rc; i++)
+            if (rdeg[i] > 1) { fprintf(stderr, "ERROR: Right %d in %d edges!\n", i, rdeg[i]); errors++; }
+        int matched_l = 0, matched_r = 0;
+        for (int i = 0; i < n; i++) if (ldeg[i] > 0) matched_l++;
+        for (int i = 0; i < rc; i++) if (rdeg[i] > 0) matched_r++;
+
+        if (report) {
+            printf("\n=== Validation Report ===\n");
+            printf("Matching size: %d\n", (int)matching.size());
+            printf("Left matched: %d, Right matched: %d\n", matched_l, matched_r);
+        }
+    } else {
+        std::vector<int> deg(n, 0);
+        for (auto& e : matching) {
+            if (e.first < 0 || e.first >= n || e.second < 0 || e.second >= n ||
+                !g.has_edge(e.first, e.second)) {
+                fprintf(stderr, "ERROR: Edge (%d, %d) not in graph!\n", e.first, e.second);
+                errors++;
+                continue;
+            }
+            deg[e.first]++;
+            deg[e.second]++;
+        }
+        for (int i = 0; i < n; i++)
+            if (deg[i] > 1) { fprintf(stderr, "ERROR: Vertex %d in %d edges!\n", i, deg[i]); errors++; }
+        int matched = 0;
+        for (int i = 0; i < n; i++) if (deg[i] > 0) matched++;
+
+        if (report) {
+            printf("\n=== Validation Report ===\n");
+            printf("Matching size: %d\n", (int)matching.size());
+            printf("Matched vertices: %d\n", matched);
+        }
+    }
+    if (report) {
+        printf("%s\n", errors > 0 ? "VALIDATION FAILED" : "VALIDATION PASSED");
+        printf("=========================\n\n");
+    }
+    return errors;
+}
+
+} // namespace matching
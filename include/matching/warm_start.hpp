@@ -0,0 +1,74 @@
+/*
+ * Warm start from a prior matching (--initial FILE, Options::initial).
+ *
+ * Graphs that change by a few edges between runs keep most of their
+ * previous matching. Each solver seeds its mates from that matching before
+ * the greedy step, which then only extends it, and augments from there, so
+ * a nearly valid prior leaves a few phases of work instead of a full solve.
+ *
+ * A prior pair is kept when both ends are in range, (u, v) is still an
+ * edge, and neither end was already taken by an earlier pair. Everything
+ * else (deleted edges, vertices that disappeared, duplicates) is dropped.
+ *
+ * Matching file:     "M" header, then M lines "u v", as --save-matching
+ *                    writes them (u < v, or left right for bipartite)
+ */
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "graph.hpp"
+#include "solver.hpp"
+#include "text_parser.hpp"
+
+namespace matching {
+
+inline bool read_matching(const char* path, Matching& out, int threads = 0) {
+    long long h[3];
+    return parse_edge_list_file(path, 1, threads, h, out);
+}
+
+inline bool write_matching(const char* path, const Matching& m) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "Cannot open file for writing: %s\n", path); return false; }
+    bool ok = fprintf(f, "%d\n", (int)m.size()) > 0;
+    for (size_t i = 0; i < m.size() && ok; i++) ok = fprintf(f, "%d %d\n", m[i].first, m[i].second) > 0;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) fprintf(stderr, "Write failed: %s\n", path);
+    return ok;
+}
+
+/* General graph: match the kept pairs of `initial` into mate (NIL = free).
+   Returns the number kept. */
+template <class G>
+inline int seed_matching(const G& g, const Matching& initial, std::vector<int>& mate) {
+    int n = g.num_vertices(), kept = 0;
+    for (const auto& e : initial) {
+        int u = e.first, v = e.second;
+        if (u < 0 || v < 0 || u >= n || v >= n || u == v) continue;
+        if (mate[u] != NIL || mate[v] != NIL || !g.has_edge(u, v)) continue;
+        mate[u] = v;
+        mate[v] = u;
+        kept++;
+    }
+    return kept;
+}
+
+/* Bipartite graph: pairs are (left, right) */
+template <class G>
+inline int seed_matching(const G& g, const Matching& initial,
+                         std::vector<int>& pair_left, std::vector<int>& pair_right) {
+    int left = g.num_vertices(), right = g.num_right(), kept = 0;
+    for (const auto& e : initial) {
+        int u = e.first, v = e.second;
+        if (u < 0 || v < 0 || u >= left || v >= right) continue;
+        if (pair_left[u] != NIL || pair_right[v] != NIL || !g.has_edge(u, v)) continue;
+        pair_left[u] = v;
+        pair_right[v] = u;
+        kept++;
+    }
+    return kept;
+}
+
+} // namespace matching
@@ -0,0 +1,165 @@
+/*
+ * Edge weights for the weighted engine (algorithms/weighted-blossom).
+ *
+ * The CSR stays unweighted; weights are one int per arc, aligned with
+ * targets(), so arc k of row u has weight w[k] and both arcs of an edge
+ * carry the same value. One loaded graph thus serves the cardinality
+ * solvers and the weighted engine alike.
+ *
+ * Weighted text format: "V E" header, then E lines "u v w" with integer
+ * weights w >= 0. A duplicate edge keeps its largest weight.
+ *
+ * Unweighted inputs (text or .csr) get generated weights, --weights MODE:
+ *
+ *   unit         every edge weighs 1, so a maximum weight matching is a
+ *                maximum cardinality matching and its size can be checked
+ *                against the other solvers
+ *   random[:M]   weights in [1, M] (default 1000), hashed from the edge's
+ *                endpoints, so a graph always gets the same weights
+ *
+ * Errors are reported on stderr and signalled by a false return value.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "graph.hpp"
+#include "io.hpp"
+#include "parallel.hpp"
+#include "solver.hpp"
+#include "text_parser.hpp"
+
+namespace matching {
+
+static const int WEIGHTS_FILE = 0;    /* "u v w" text input */
+static const int WEIGHTS_UNIT = 1;    /* --weights unit */
+static const int WEIGHTS_RANDOM = 2;  /* --weights random[:M] */
+
+static const int DEFAULT_RANDOM_WEIGHT = 1000;
+
+/* --weights value: "unit", "random" or "random:M". False for anything else. */
+inline bool parse_weights_mode(const std::string& s, int& mode, int& max_weight) {
+    max_weight = DEFAULT_RANDOM_WEIGHT;
+    if (s == "unit") { mode = WEIGHTS_UNIT; return true; }
+    if (s == "random") { mode = WEIGHTS_RANDOM; return true; }
+    if (s.compare(0, 7, "random:") == 0) {
+        max_weight = atoi(s.c_str() + 7);
+        mode = WEIGHTS_RANDOM;
+        return max_weight >= 1;
+    }
+    return false;
+}
+
+/* True when the first edge line of a text edge list has three integers */
+inline bool is_weighted_edge_list(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[4096];
+    bool weighted = false;
+    if (fgets(line, sizeof line, f) && fgets(line, sizeof line, f)) {
+        IntScanner sc{line, line + strlen(line)};
+        long long x;
+        int fields = 0;
+        while (sc.next(x)) fields++;
+        weighted = fields == 3;
+    }
+    fclose(f);
+    return weighted;
+}
+
+/* "V E" header, then E lines "u v w" */
+inline bool read_weighted_edge_list(const char* path, EdgeListFile& out, std::vector<int>& weights,
+                                    int threads = 0) {
+    long long h[3];
+    if (!parse_edge_list_file(path, 2, threads, h, out.edges, &weights)) return false;
+    out.n = out.n_right = (int)h[0];
+    for (size_t i = 0; i < weights.size(); i++) {
+        if (weights[i] < 0) {
+            fprintf(stderr, "%s: edge %zu has negative weight %d\n", path, i + 1, weights[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Arc index of v in u's sorted row, or -1 */
+template <class Arc>
+inline Arc find_arc(const BasicGraph<Arc>& g, int u, int v) {
+    const int* row = g.targets() + g.adj_start(u);
+    const int* end = row + g.degree(u);
+    const int* p = std::lower_bound(row, end, v);
+    return p != end && *p == v ? (Arc)(p - g.targets()) : (Arc)-1;
+}
+
+/* Per-arc weights of g from the edge list it was built from (edges[i]
+   weighs w[i]). Edges the build dropped are skipped; duplicates keep the
+   largest weight, so the result does not depend on the thread count. */
+template <class Arc>
+inline std::vector<int> arc_weights(const BasicGraph<Arc>& g, const EdgeList& edges,
+                                    const std::vector<int>& w, int threads = 0) {
+    std::vector<int> out((size_t)g.num_arcs(), 0);
+    int n = g.num_vertices();
+    size_t m = edges.size();
+    int T = threads_for(m, threads);
+    auto store_max = [&](Arc k, int x) {
+        if (k < 0) return;
+        int cur = __atomic_load_n(&out[(size_t)k], __ATOMIC_RELAXED);
+        while (x > cur && !__atomic_compare_exchange_n(&out[(size_t)k], &cur, x, true,
+                                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+    };
+    run_parallel(T, [&](int t) {
+        for (size_t i = chunk_begin(m, T, t); i < chunk_begin(m, T, t + 1); i++) {
+            int u = edges[i].first, v = edges[i].second;
+            if (u < 0 || v < 0 || u >= n || v >= n || u == v) continue;
+            store_max(find_arc(g, u, v), w[i]);
+            store_max(find_arc(g, v, u), w[i]);
+        }
+    });
+    return out;
+}
+
+/* Weight of edge {u, v} under --weights random:M, symmetric in u and v */
+inline int hashed_weight(int u, int v, int max_weight) {
+    uint64_t x = ((uint64_t)(uint32_t)std::min(u, v) << 32) | (uint32_t)std::max(u, v);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return 1 + (int)(x % (uint64_t)max_weight);
+}
+
+/* Generated per-arc weights (WEIGHTS_UNIT or WEIGHTS_RANDOM) */
+template <class Arc>
+inline std::vector<int> generated_arc_weights(const BasicGraph<Arc>& g, int mode, int max_weight,
+                                              int threads = 0) {
+    std::vector<int> out((size_t)g.num_arcs(), 1);
+    if (mode != WEIGHTS_RANDOM) return out;
+    int n = g.num_vertices();
+    int T = threads_for((size_t)g.num_arcs(), threads);
+    run_parallel(T, [&](int t) {
+        for (int u = (int)chunk_begin(n, T, t); u < (int)chunk_begin(n, T, t + 1); u++)
+            for (Arc k = g.adj_start(u); k < g.adj_start(u + 1); k++)
+                out[(size_t)k] = hashed_weight(u, g.targets()[k], max_weight);
+    });
+    return out;
+}
+
+/* Total weight of the matched pairs that are edges of g */
+template <class Arc>
+inline long long matching_weight(const BasicGraph<Arc>& g, const std::vector<int>& w, const Matching& m) {
+    long long total = 0;
+    for (const auto& e : m) {
+        if (e.first < 0 || e.first >= g.num_vertices()) continue;
+        Arc k = find_arc(g, e.first, e.second);
+        if (k >= 0) total += w[(size_t)k];
+    }
+    return total;
+}
+
+} // namespace matching
@@ -0,0 +1,48 @@
+/*
+ * Reusable solver workspaces, for callers that solve many graphs in a row
+ * (benchmarks/matching_batch).
+ *
+ * A solver that takes a Workspace keeps its scratch arrays there instead
+ * of allocating them per solve; the solver binds to the arrays by
+ * reference, so its search code is the same either way. The protocol:
+ *
+ *   - Between solves every array is idle: each entry holds the value a
+ *     fresh solve expects (NIL mates, unlabeled vertices, union-find
+ *     parents equal to their index, empty buckets). Before it lets go of
+ *     the workspace, a solver restores what it changed, from the lists of
+ *     touched vertices it keeps for its per-phase resets anyway; the
+ *     mates take one pass over the graph's vertices, as the result does.
+ *   - Binding a graph grows an array only when the graph is larger than
+ *     any before, filling the new tail with the idle value. Otherwise it
+ *     writes nothing: O(1), no allocation and no page faults.
+ *   - Stamp arrays (LCA tags) are compared against an epoch that lives in
+ *     the workspace too and keeps counting across solves, so a stamp left
+ *     by an earlier graph never matches.
+ *   - Arrays a solver fills before every read (BFS distances, phase
+ *     scratch) have no idle value and are only grown.
+ *
+ * Arrays never shrink; assigning a fresh Workspace frees them. A
+ * workspace serves one solve at a time.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace matching {
+
+/* Size v to at least n, new entries idle */
+template <class T>
+inline void grow_idle(std::vector<T>& v, size_t n, const T& idle) {
+    if (v.size() < n) v.resize(n, idle);
+}
+
+/* The same for a union-find parent array, idle when v[i] == i */
+inline void grow_identity(std::vector<int>& v, size_t n) {
+    size_t k = v.size();
+    if (k >= n) return;
+    v.resize(n);
+    for (size_t i = k; i < n; i++) v[i] = (int)i;
+}
+
+} // namespace matching
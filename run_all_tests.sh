@@ -48,9 +48,9 @@ rm -rf "$RESULTS"
 mkdir -p "$RESULTS/raw"
 
 # ── general matching algorithms ──────────────────────────────────────────
-GENERAL_ALGOS="edmonds-blossom-simple edmonds-blossom-optimized gabow-simple gabow-optimized micali-vazirani"
+GENERAL_ALGOS="edmonds-blossom-simple edmonds-blossom-optimized gabow-simple gabow-optimized micali-vazirani dynamic-matching weighted-blossom parallel-blossom streaming-matching"
 MV_PURE="micali-vazirani-pure"
-BIPARTITE_ALGOS="hopcroft-karp"
+BIPARTITE_ALGOS="hopcroft-karp pothen-fan streaming-matching"
 LANGS="cpp rust python"
 
 # derive source filename from algorithm directory name
@@ -66,7 +66,7 @@ echo ""
 
 compile_errors=0
 
-for alg in $GENERAL_ALGOS $MV_PURE $BIPARTITE_ALGOS; do
+for alg in $(echo $GENERAL_ALGOS $MV_PURE $BIPARTITE_ALGOS | tr ' ' '\n' | awk '!seen[$0]++'); do
     base="$(src_name "$alg")"
     alg_dir="$ALGO/$alg"
 
@@ -75,7 +75,7 @@ for alg in $GENERAL_ALGOS $MV_PURE $BIPARTITE_ALGOS; do
     bin="$alg_dir/cpp/${base}_cpp"
     if [ -f "$src" ]; then
         printf "  compile  %-45s" "$alg/cpp"
-        if g++ -O3 -std=c++17 "$src" -o "$bin" 2>"$RESULTS/raw/${base}_cpp_compile.log"; then
+        if g++ -O3 -std=c++17 -pthread -I"$REPO/include" "$src" -o "$bin" 2>"$RESULTS/raw/${base}_cpp_compile.log"; then
             echo "✓"
         else
             echo "✗  (see results/raw/${base}_cpp_compile.log)"
@@ -136,6 +136,26 @@ echo ""
 CSV="$RESULTS/raw/all_results.csv"
 echo "algo,graph,lang,size,time_ms,valid,status" > "$CSV"
 
+# engine flags for a cardinality run: weighted-blossom with unit weights
+# finds a maximum-cardinality matching; parallel-blossom gets several
+# threads so its concurrent search runs (it is serial by default);
+# streaming-matching with no degree cap keeps every edge and is exact
+algo_flags() {
+    case "$1" in
+        weighted-blossom) echo "--weights unit" ;;
+        parallel-blossom) echo "--threads 4" ;;
+        streaming-matching) echo "--complete mv --degree-cap 0" ;;
+    esac
+}
+
+# dynamic-matching replays an update file: delete up to 50 edges of the
+# graph, then insert them again, so the final maximum is the graph's own
+dynamic_updates() {
+    awk 'NR > 1 && NF >= 2 && n < 50 { e[n++] = $1 " " $2 }
+         END { for (i = 0; i < n; i++) print "- " e[i]; print "="
+               for (i = 0; i < n; i++) print "+ " e[i] }' "$1"
+}
+
 run_one() {
     alg="$1"       # e.g. edmonds-blossom-simple
     graph="$2"     # full path to .txt
@@ -149,7 +169,17 @@ run_one() {
         cpp)
             bin="$ALGO/$alg/cpp/${base}_cpp"
             [ -x "$bin" ] || { echo "skip" > "$logfile"; return; }
-            run_with_timeout 300 "$bin" "$graph" > "$logfile"
+            case "$alg" in
+                dynamic-matching)
+                    updates="$RESULTS/raw/${base}_${gname}.updates"
+                    dynamic_updates "$graph" > "$updates"
+                    # exits 1 on CHECK FAILED, which is recorded below
+                    run_with_timeout 300 "$bin" "$graph" "$updates" --check > "$logfile" || true
+                    ;;
+                *)
+                    run_with_timeout 300 "$bin" "$graph" $(algo_flags "$alg") > "$logfile"
+                    ;;
+            esac
             ;;
         rust)
             bin="$ALGO/$alg/rust/${base}_rust"
@@ -165,8 +195,12 @@ run_one() {
 
     # parse output
     size=$(grep "^Matching size:" "$logfile" | tail -1 | awk '{print $3}')
-    tms=$(grep "^Time:" "$logfile" | awk '{print $2}')
+    case "$alg" in
+        dynamic-matching)   tms=$(grep "^Update time:" "$logfile" | awk '{print $3}') ;;
+        *)                  tms=$(grep "^Time:" "$logfile" | awk '{print $2}') ;;
+    esac
     valid=$(grep "VALIDATION" "$logfile" | head -1)
+    grep -q "^CHECK FAILED" "$logfile" && valid="FAILED"
 
     case "$valid" in
         *PASSED*) vflag="PASS" ;;
@@ -316,10 +350,10 @@ for graph in $GENERAL_GRAPHS; do
     echo "|-----------|----------|--------|-----------|---------|-------------|-----------|" >> "$REPORT"
 
     for alg in $GENERAL_ALGOS $MV_PURE; do
-        aname="$(echo "$alg" | sed 's/micali-vazirani-pure/mv-pure/' | sed 's/micali-vazirani/mv-hybrid/' | sed 's/edmonds-blossom-/eb-/' | sed 's/gabow-/g-/')"
+        aname="$(echo "$alg" | sed 's/micali-vazirani-pure/mv-pure/' | sed 's/micali-vazirani/mv-hybrid/' | sed 's/edmonds-blossom-/eb-/' | sed 's/gabow-/g-/' | sed 's/dynamic-matching/dynamic/' | sed 's/weighted-blossom/weighted-unit/' | sed 's/parallel-blossom/parallel-t4/' | sed 's/streaming-matching/streaming/')"
         row="| $aname"
         for lang in cpp rust python; do
-            line="$(grep "^$alg,$gname,$lang," "$CSV")"
+            line="$(grep "^$alg,$gname,$lang," "$CSV" || true)"
             if [ -n "$line" ]; then
                 sz="$(echo "$line" | cut -d, -f4)"
                 tm="$(echo "$line" | cut -d, -f5)"
@@ -349,7 +383,7 @@ for graph in $BIPARTITE_GRAPHS; do
     for alg in $BIPARTITE_ALGOS; do
         row="| $alg"
         for lang in cpp rust python; do
-            line="$(grep "^$alg,$gname,$lang," "$CSV")"
+            line="$(grep "^$alg,$gname,$lang," "$CSV" || true)"
             if [ -n "$line" ]; then
                 sz="$(echo "$line" | cut -d, -f4)"
                 tm="$(echo "$line" | cut -d, -f5)"
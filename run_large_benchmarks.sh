@@ -5,22 +5,50 @@
 #   ./run_large_benchmarks.sh                                    # defaults
 #   ./run_large_benchmarks.sh --sizes 100k 1m --langs cpp rust
 #   ./run_large_benchmarks.sh --algos hk mv-pure gabow-opt
-#   ./run_large_benchmarks.sh --mode plain greedy greedy-md
+#   ./run_large_benchmarks.sh --algos hk pf --langs cpp
+#   ./run_large_benchmarks.sh --mode plain greedy greedy-md karp-sipser
 #   ./run_large_benchmarks.sh --runs 5 --timeout 600
+#   ./run_large_benchmarks.sh --max-threads 16
+#   ./run_large_benchmarks.sh --no-scaling
+#   ./run_large_benchmarks.sh --no-compressed
+#   ./run_large_benchmarks.sh --stats
 #   ./run_large_benchmarks.sh --list
 #
 # Defaults:
 #   sizes:    all found in data/large-benchmarks/
 #   langs:    cpp rust python
 #   algos:    all (filtered by feasibility)
-#   mode:     plain (options: plain, greedy, greedy-md)
+#   mode:     plain (options: plain, greedy, greedy-md, karp-sipser[C++ only])
 #   runs:     3 (reports median)
 #   timeout:  300s per run
 #   datadir:  data/large-benchmarks
+#   scaling:  C++ solvers with a parallel phase (hk, pf, par-blossom) are re-run with
+#             --threads 1, 2, 4, ... up to --max-threads (default: all cores)
+#   compressed: C++ solvers with a compressed-adjacency mode (hk, mv-pure)
+#             are re-run with --compressed, next to their uncompressed times
+#   stats:    off; --stats builds the C++ solvers with -DMATCHING_STATS=1
+#             and runs them with --stats=json (per-phase counters, stage
+#             timers; see include/matching/stats.hpp)
+#
+# C++ runs read <graph>.csr instead of <graph>.txt when it exists; create it
+# with tools/graph_convert (memory-mapped, no parse cost). A .csr without a
+# .txt next to it (e.g. written by tools/graph_gen) is run by the C++
+# solvers only.
+#
+# results.csv times (median_ms, runN_ms) are the solve alone; load_ms is the
+# C++ solvers' separately reported input + CSR build time (NA otherwise).
+# init_ms is the part of median_ms spent on the initial matching (C++, modes
+# other than plain), to judge parallel initializers against --threads 1.
+# stats is the --stats=json object of the median run as key=value pairs
+# joined by ';' (NA without --stats, or for solvers that print none). A
+# stats build counts as it goes, so its times run a little slower than a
+# plain build's.
 #
 # Produces:
 #   results/large-benchmarks/<timestamp>/report.md
 #   results/large-benchmarks/<timestamp>/results.csv
+#   results/large-benchmarks/<timestamp>/scaling.csv   (thread scaling curve)
+#   results/large-benchmarks/<timestamp>/compressed.csv (memory, decode overhead)
 #   results/large-benchmarks/<timestamp>/raw/          (individual run logs)
 
 set -e
@@ -34,6 +62,10 @@ OUTDIR="$REPO/results/large-benchmarks"
 RUNS=3
 TIMEOUT=300
 LIST_ONLY=0
+SCALING=1
+COMPRESSED=1
+STATS=0
+MAX_THREADS=""
 
 # Filters (empty = all)
 F_SIZES=""
@@ -44,10 +76,10 @@ F_MODE=""
 # ── algorithm registry ────────────────────────────────────────────────
 # Short name → directory name, graph type, complexity class
 # Graph type: general | bipartite
-# Complexity: ve (O(VE)) | fast (O(E√V))
+# Complexity: ve (O(VE)) | fast (O(E√V), or near-linear in practice)
 
-ALL_GENERAL="edmonds-simple edmonds-opt gabow-simple gabow-opt mv-pure"
-ALL_BIPARTITE="hk"
+ALL_GENERAL="edmonds-simple edmonds-opt gabow-simple gabow-opt mv-pure par-blossom weighted"
+ALL_BIPARTITE="hk pf"
 ALL_ALGOS="$ALL_GENERAL $ALL_BIPARTITE"
 
 alg_dir() {
@@ -58,6 +90,9 @@ alg_dir() {
         gabow-opt)      echo "gabow-optimized" ;;
         mv-pure)        echo "micali-vazirani-pure" ;;
         hk)             echo "hopcroft-karp" ;;
+        pf)             echo "pothen-fan" ;;
+        par-blossom)    echo "parallel-blossom" ;;
+        weighted)       echo "weighted-blossom" ;;
     esac
 }
 
@@ -68,14 +103,20 @@ alg_src() {
 
 alg_complexity() {
     case "$1" in
-        edmonds-simple|edmonds-opt|gabow-simple) echo "ve" ;;
-        gabow-opt|mv-pure|hk) echo "fast" ;;
+        edmonds-simple|edmonds-opt|gabow-simple|par-blossom|weighted) echo "ve" ;;
+        gabow-opt|mv-pure|hk|pf) echo "fast" ;;
     esac
 }
 
+# Algorithms whose C++ solver has a parallel phase (--threads N)
+SCALING_ALGOS="hk pf par-blossom"
+
+# Algorithms whose C++ solver can search gap-encoded rows (--compressed)
+COMPRESSED_ALGOS="hk mv-pure"
+
 alg_type() {
     case "$1" in
-        hk) echo "bipartite" ;;
+        hk|pf) echo "bipartite" ;;
         *)  echo "general" ;;
     esac
 }
@@ -112,6 +153,10 @@ while [ $# -gt 0 ]; do
         --datadir) shift; DATADIR="$1"; shift ;;
         --outdir)  shift; OUTDIR="$1"; shift ;;
         --list)    LIST_ONLY=1; shift ;;
+        --max-threads) shift; MAX_THREADS="$1"; shift ;;
+        --no-scaling)  SCALING=0; shift ;;
+        --no-compressed) COMPRESSED=0; shift ;;
+        --stats)   STATS=1; shift ;;
         --help|-h)
             sed -n '2,/^$/p' "$0" | grep '^#' | sed 's/^# \?//'
             exit 0
@@ -123,6 +168,18 @@ done
 # Apply defaults
 [ -z "$F_LANGS" ] && F_LANGS="cpp rust python"
 
+# Thread counts for the scaling curve: 1, 2, 4, ... plus the maximum itself
+if [ -z "$MAX_THREADS" ]; then
+    MAX_THREADS="$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 1)"
+fi
+THREAD_COUNTS=""
+tc=1
+while [ "$tc" -lt "$MAX_THREADS" ]; do
+    THREAD_COUNTS="$THREAD_COUNTS $tc"
+    tc=$((tc * 2))
+done
+THREAD_COUNTS="$THREAD_COUNTS $MAX_THREADS"
+
 # Timestamp the output directory
 TIMESTAMP="$(date '+%Y%m%d_%H%M%S')"
 OUTDIR="${OUTDIR}/${TIMESTAMP}"
@@ -148,26 +205,43 @@ run_with_timeout() {
 # ── discover available graph files ────────────────────────────────────
 if [ ! -d "$DATADIR" ]; then
     echo "ERROR: Data directory not found: $DATADIR"
-    echo "Run generate_large_benchmarks.py first."
+    echo "Generate graphs with tools/graph_gen first (see README.md)."
     exit 1
 fi
 
 GENERAL_FILES=""
 BIPARTITE_FILES=""
 
-for f in "$DATADIR"/general_sparse_*.txt; do
+# Graph file name without its directory and .txt / .csr extension
+graph_name() {
+    basename "$1" | sed 's/\.txt$//; s/\.csr$//'
+}
+
+# Vertex count (left side when bipartite): the text header's first field,
+# or the n field at byte 16 of a .csr header
+graph_vertices() {
+    case "$1" in
+        *.csr) od -An -t u8 -j 16 -N 8 "$1" | tr -d ' ' ;;
+        *)     head -1 "$1" | awk '{print $1}' ;;
+    esac
+}
+
+for f in "$DATADIR"/general_sparse_*.txt "$DATADIR"/general_sparse_*.csr; do
     [ -f "$f" ] || continue
+    # A .csr next to its .txt is only the C++ copy of that graph
+    case "$f" in *.csr) [ -f "${f%.csr}.txt" ] && continue ;; esac
     # Extract size tag: general_sparse_100k_3.txt → 100k
-    tag="$(basename "$f" .txt | sed 's/general_sparse_//' | sed 's/_[0-9]*$//')"
+    tag="$(graph_name "$f" | sed 's/general_sparse_//' | sed 's/_[0-9]*$//')"
     if [ -n "$F_SIZES" ]; then
         echo "$F_SIZES" | grep -qw "$tag" || continue
     fi
     GENERAL_FILES="$GENERAL_FILES $f"
 done
 
-for f in "$DATADIR"/bipartite_sparse_*.txt; do
+for f in "$DATADIR"/bipartite_sparse_*.txt "$DATADIR"/bipartite_sparse_*.csr; do
     [ -f "$f" ] || continue
-    tag="$(basename "$f" .txt | sed 's/bipartite_sparse_//' | sed 's/_[0-9]*$//')"
+    case "$f" in *.csr) [ -f "${f%.csr}.txt" ] && continue ;; esac
+    tag="$(graph_name "$f" | sed 's/bipartite_sparse_//' | sed 's/_[0-9]*$//')"
     if [ -n "$F_SIZES" ]; then
         echo "$F_SIZES" | grep -qw "$tag" || continue
     fi
@@ -179,7 +253,7 @@ done
 max_v=0
 for f in $GENERAL_FILES $BIPARTITE_FILES; do
     # Parse header line for vertex count
-    v="$(head -1 "$f" | awk '{print $1}')"
+    v="$(graph_vertices "$f")"
     [ "$v" -gt "$max_v" ] 2>/dev/null && max_v="$v"
 done
 
@@ -207,8 +281,8 @@ BIPARTITE_ALGOS="$(select_algos bipartite)"
 # Validate mode values
 for m in $F_MODE; do
     case "$m" in
-        plain|greedy|greedy-md) ;;
-        *) echo "ERROR: --mode values must be plain, greedy, or greedy-md (got: $m)"; exit 1 ;;
+        plain|greedy|greedy-md|karp-sipser) ;;
+        *) echo "ERROR: --mode values must be plain, greedy, greedy-md, or karp-sipser (got: $m)"; exit 1 ;;
     esac
 done
 
@@ -218,23 +292,45 @@ plan_count=0
 
 add_to_plan() {
     alg="$1"; graph="$2"; lang="$3"; mode="$4"
-    gname="$(basename "$graph" .txt)"
+    gname="$(graph_name "$graph")"
 
     # Parse V from header
-    v="$(head -1 "$graph" | awk '{print $1}')"
+    v="$(graph_vertices "$graph")"
+
+    # Only the C++ solvers read the binary format
+    case "$graph" in
+        *.csr) if [ "$lang" != "cpp" ]; then return; fi ;;
+    esac
 
     # Skip O(VE) algorithms on large graphs (> 200K vertices) unless explicitly requested
     if [ -z "$F_ALGOS" ] && [ "$(alg_complexity "$alg")" = "ve" ] && [ "$v" -gt 200000 ]; then
         return
     fi
 
+    # Karp-Sipser initialization exists in the C++ solvers only
+    if [ "$mode" = "karp-sipser" ] && [ "$lang" != "cpp" ]; then
+        return
+    fi
+
     plan_count=$((plan_count + 1))
     PLAN="$PLAN
 $alg|$graph|$lang|$gname|$v|$mode"
 }
 
+# Not every algorithm exists in every language (pf is C++ only)
+has_source() {
+    alg="$1"; lang="$2"
+    case "$lang" in
+        cpp)    ext="cpp" ;;
+        rust)   ext="rs" ;;
+        python) ext="py" ;;
+    esac
+    [ -f "$ALGO/$(alg_dir "$alg")/$lang/$(alg_src "$alg").$ext" ]
+}
+
 add_modes() {
     alg="$1"; graph="$2"; lang="$3"
+    has_source "$alg" "$lang" || return 0
     for m in $F_MODE; do
         add_to_plan "$alg" "$graph" "$lang" "$m"
     done
@@ -292,6 +388,8 @@ echo ""
 
 compiled=""
 compile_errors=0
+stats_flags=""
+[ "$STATS" -eq 1 ] && stats_flags="-DMATCHING_STATS=1"
 
 needs_compile() {
     alg="$1"; lang="$2"
@@ -317,7 +415,7 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
             bin="$ALGO/$dir/cpp/${base}_cpp"
             [ -f "$src" ] || continue
             printf "  compile %-20s %-6s " "$alg" "cpp"
-            if g++ -O3 -std=c++17 "$src" -o "$bin" 2>/dev/null; then
+            if g++ -O3 -std=c++17 -pthread $stats_flags -I"$REPO/include" "$src" -o "$bin" 2>/dev/null; then
                 echo "✓"
             else
                 echo "✗"
@@ -350,7 +448,7 @@ echo ""
 
 mkdir -p "$OUTDIR/raw"
 CSV="$OUTDIR/results.csv"
-echo "algo,graph,lang,vertices,mode,matching_size,greedy_init_size,greedy_pct,median_ms,run1_ms,run2_ms,run3_ms,validation" > "$CSV"
+echo "algo,graph,lang,vertices,mode,matching_size,greedy_init_size,greedy_pct,median_ms,run1_ms,run2_ms,run3_ms,validation,load_ms,init_ms,stats" > "$CSV"
 
 job=0
 echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
@@ -363,12 +461,15 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
 
     printf "  [%3d/%d] %-18s %-6s %-10s %-30s " "$job" "$plan_count" "$alg" "$lang" "$greedy" "$gname"
 
-    # Determine executable
+    # Determine executable and input file
+    input="$graph"
     case "$lang" in
         cpp)
             bin="$ALGO/$dir/cpp/${base}_cpp"
             [ -x "$bin" ] || { echo "SKIP (not compiled)"; continue; }
             cmd="$bin"
+            # Prefer the pre-built binary CSR next to the text file (tools/graph_convert)
+            [ -f "${graph%.txt}.csr" ] && input="${graph%.txt}.csr"
             ;;
         rust)
             bin="$ALGO/$dir/rust/${base}_rust"
@@ -386,9 +487,14 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
     extra_args=""
     [ "$greedy" = "greedy" ] && extra_args="--greedy"
     [ "$greedy" = "greedy-md" ] && extra_args="--greedy-md"
+    [ "$greedy" = "karp-sipser" ] && extra_args="--karp-sipser"
+    [ "$STATS" -eq 1 ] && [ "$lang" = "cpp" ] && extra_args="$extra_args --stats=json"
 
     # Run N times
     times=""
+    loads=""
+    inits=""
+    run_stats=""
     size="ERR"
     greedy_init="NA"
     greedy_pct="NA"
@@ -400,17 +506,24 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
         run_i=$((run_i + 1))
         logfile="${logbase}_run${run_i}.log"
 
-        if run_with_timeout "$TIMEOUT" $cmd "$graph" $extra_args > "$logfile" 2>&1; then
+        if run_with_timeout "$TIMEOUT" $cmd "$input" $extra_args > "$logfile" 2>&1; then
             t="$(grep '^Time:' "$logfile" | awk '{print $2}')"
+            lt="$(grep '^Load time:' "$logfile" | awk '{print $3}')"
             s="$(grep '^Matching size:' "$logfile" | tail -1 | awk '{print $3}')"
             gi="$(grep '^Greedy init size:' "$logfile" | awk '{print $4}')"
             gp="$(grep '^Greedy/Final:' "$logfile" | awk '{print $2}')"
+            it="$(grep '^Greedy init time:' "$logfile" | awk '{print $4}')"
             vl="$(grep 'VALIDATION' "$logfile" | head -1)"
+            # Stats: {"phases": 12, "bfs_arcs": 81234} -> phases=12;bfs_arcs=81234
+            st="$(grep '^Stats: {.' "$logfile" | sed 's/^Stats: {//; s/}$//; s/"//g; s/: /=/g; s/, /;/g')"
 
             [ -n "$t" ] && times="$times $t" || times="$times ERR"
+            [ -n "$lt" ] && loads="$loads $lt"
+            [ -n "$it" ] && inits="$inits $it"
             [ -n "$s" ] && size="$s"
             [ -n "$gi" ] && greedy_init="$gi"
             [ -n "$gp" ] && greedy_pct="$gp"
+            [ -n "$t" ] && [ -n "$st" ] && run_stats="$run_stats $t|$st"
 
             case "$vl" in
                 *PASSED*) valid="PASS" ;;
@@ -423,7 +536,7 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
     done
 
     # Compute median
-    clean_times="$(echo "$times" | tr ' ' '\n' | grep -v ERR | grep -v TIMEOUT | sort -n)"
+    clean_times="$(echo "$times" | tr ' ' '\n' | grep -v ERR | grep -v TIMEOUT | grep . | sort -n)"
     n_good="$(echo "$clean_times" | grep -c . || true)"
 
     if [ "$n_good" -gt 0 ]; then
@@ -432,6 +545,25 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
         med="ERR"
     fi
 
+    # Load time (input + CSR build) is reported separately by the C++ solvers
+    load_med="NA"
+    if [ -n "$loads" ]; then
+        n_load="$(echo "$loads" | wc -w | tr -d ' ')"
+        load_med="$(echo "$loads" | tr ' ' '\n' | grep . | sort -n | awk -v n="$n_load" 'NR==int((n+1)/2){print;exit}')"
+    fi
+    init_med="NA"
+    if [ -n "$inits" ]; then
+        n_init="$(echo "$inits" | wc -w | tr -d ' ')"
+        init_med="$(echo "$inits" | tr ' ' '\n' | grep . | sort -n | awk -v n="$n_init" 'NR==int((n+1)/2){print;exit}')"
+    fi
+
+    # Counters of the run that gave the median time
+    stats_med="NA"
+    if [ -n "$run_stats" ] && [ "$med" != "ERR" ]; then
+        stats_med="$(echo "$run_stats" | tr ' ' '\n' | awk -F'|' -v m="$med" '$1 == m {print $2; exit}')"
+        [ -z "$stats_med" ] && stats_med="NA"
+    fi
+
     # Pad times to 3 fields for CSV
     t1="$(echo "$times" | awk '{print $1}')"
     t2="$(echo "$times" | awk '{print $2}')"
@@ -440,15 +572,181 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
     [ -z "$t2" ] && t2="-"
     [ -z "$t3" ] && t3="-"
 
-    echo "$alg,$gname,$lang,$v,$greedy,$size,$greedy_init,$greedy_pct,$med,$t1,$t2,$t3,$valid" >> "$CSV"
+    echo "$alg,$gname,$lang,$v,$greedy,$size,$greedy_init,$greedy_pct,$med,$t1,$t2,$t3,$valid,$load_med,$init_med,$stats_med" >> "$CSV"
 
-    if [ "$greedy" = "greedy" ] || [ "$greedy" = "greedy-md" ]; then
+    if [ "$greedy" != "plain" ]; then
         printf "size=%-8s median=%-8s %-6s greedy_init=%-8s (%s)\n" "$size" "${med}ms" "$valid" "$greedy_init" "$greedy_pct"
     else
         printf "size=%-8s median=%-8s %s\n" "$size" "${med}ms" "$valid"
     fi
 done
 
+# ── thread scaling ────────────────────────────────────────────────────
+SCALE_CSV="$OUTDIR/scaling.csv"
+echo "algo,graph,mode,threads,median_ms,speedup,matching_size,validation" > "$SCALE_CSV"
+
+if [ "$SCALING" -eq 1 ]; then
+    echo ""
+    echo "============================================="
+    echo "  Thread Scaling (threads:$THREAD_COUNTS)"
+    echo "============================================="
+    echo ""
+
+    echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
+        [ -z "$alg" ] && continue
+        [ "$lang" = "cpp" ] || continue
+        echo "$SCALING_ALGOS" | grep -qw "$alg" || continue
+
+        dir="$(alg_dir "$alg")"
+        base="$(alg_src "$alg")"
+        bin="$ALGO/$dir/cpp/${base}_cpp"
+        [ -x "$bin" ] || continue
+        input="$graph"
+        [ -f "${graph%.txt}.csr" ] && input="${graph%.txt}.csr"
+        extra_args=""
+        [ "$greedy" = "greedy" ] && extra_args="--greedy"
+        [ "$greedy" = "greedy-md" ] && extra_args="--greedy-md"
+        [ "$greedy" = "karp-sipser" ] && extra_args="--karp-sipser"
+    [ "$greedy" = "karp-sipser" ] && extra_args="--karp-sipser"
+
+        base_med=""
+        base_size=""
+        for nt in $THREAD_COUNTS; do
+            printf "  %-10s %-10s %-30s threads=%-4s " "$alg" "$greedy" "$gname" "$nt"
+            times=""
+            size="ERR"
+            valid="NONE"
+            run_i=0
+            while [ "$run_i" -lt "$RUNS" ]; do
+                run_i=$((run_i + 1))
+                logfile="$OUTDIR/raw/${base}_cpp_${gname}_${greedy}_t${nt}_run${run_i}.log"
+                if run_with_timeout "$TIMEOUT" "$bin" "$input" $extra_args --threads "$nt" > "$logfile" 2>&1; then
+                    t="$(grep '^Time:' "$logfile" | awk '{print $2}')"
+                    s="$(grep '^Matching size:' "$logfile" | tail -1 | awk '{print $3}')"
+                    [ -n "$t" ] && times="$times $t"
+                    [ -n "$s" ] && size="$s"
+                    case "$(grep 'VALIDATION' "$logfile" | head -1)" in
+                        *PASSED*) [ "$valid" = "FAIL" ] || valid="PASS" ;;
+                        *FAILED*) valid="FAIL" ;;
+                    esac
+                else
+                    valid="FAIL"
+                fi
+            done
+
+            n_good="$(echo "$times" | wc -w | tr -d ' ')"
+            if [ "$n_good" -gt 0 ]; then
+                med="$(echo "$times" | tr ' ' '\n' | grep . | sort -n | awk -v n="$n_good" 'NR==int((n+1)/2){print;exit}')"
+            else
+                med="ERR"
+            fi
+
+            # The matching must not depend on the thread count
+            [ -z "$base_size" ] && base_size="$size"
+            [ "$size" = "$base_size" ] || valid="FAIL"
+
+            [ -z "$base_med" ] && base_med="$med"
+            if [ "$med" != "ERR" ] && [ "$base_med" != "ERR" ] && [ "$med" -gt 0 ] 2>/dev/null; then
+                speedup="$(awk "BEGIN{printf \"%.2f\", $base_med / $med}")"
+            else
+                speedup="NA"
+            fi
+
+            echo "$alg,$gname,$greedy,$nt,$med,$speedup,$size,$valid" >> "$SCALE_CSV"
+            printf "median=%-8s speedup=%-6s size=%-8s %s\n" "${med}ms" "${speedup}x" "$size" "$valid"
+        done
+    done
+fi
+
+scale_fail="$(grep -c ',FAIL$' "$SCALE_CSV" || true)"
+
+# ── compressed adjacency ──────────────────────────────────────────────
+# Same job with --compressed: graph memory from the "Graph memory:" line,
+# decode overhead = compressed median / uncompressed median (results.csv)
+COMP_CSV="$OUTDIR/compressed.csv"
+echo "algo,graph,mode,csr_bytes,compressed_bytes,ratio,median_ms,compressed_ms,overhead,matching_size,validation" > "$COMP_CSV"
+
+if [ "$COMPRESSED" -eq 1 ]; then
+    echo ""
+    echo "============================================="
+    echo "  Compressed Adjacency"
+    echo "============================================="
+    echo ""
+
+    echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
+        [ -z "$alg" ] && continue
+        [ "$lang" = "cpp" ] || continue
+        echo "$COMPRESSED_ALGOS" | grep -qw "$alg" || continue
+
+        dir="$(alg_dir "$alg")"
+        base="$(alg_src "$alg")"
+        bin="$ALGO/$dir/cpp/${base}_cpp"
+        [ -x "$bin" ] || continue
+        input="$graph"
+        [ -f "${graph%.txt}.csr" ] && input="${graph%.txt}.csr"
+        extra_args=""
+        [ "$greedy" = "greedy" ] && extra_args="--greedy"
+        [ "$greedy" = "greedy-md" ] && extra_args="--greedy-md"
+        [ "$greedy" = "karp-sipser" ] && extra_args="--karp-sipser"
+
+        printf "  %-10s %-10s %-30s " "$alg" "$greedy" "$gname"
+        times=""
+        size="ERR"
+        valid="NONE"
+        csr_b="NA"
+        comp_b="NA"
+        run_i=0
+        while [ "$run_i" -lt "$RUNS" ]; do
+            run_i=$((run_i + 1))
+            logfile="$OUTDIR/raw/${base}_cpp_${gname}_${greedy}_compressed_run${run_i}.log"
+            if run_with_timeout "$TIMEOUT" "$bin" "$input" $extra_args --compressed > "$logfile" 2>&1; then
+                t="$(grep '^Time:' "$logfile" | awk '{print $2}')"
+                s="$(grep '^Matching size:' "$logfile" | tail -1 | awk '{print $3}')"
+                mem="$(grep '^Graph memory:' "$logfile" | head -1)"
+                [ -n "$t" ] && times="$times $t"
+                [ -n "$s" ] && size="$s"
+                [ -n "$mem" ] && csr_b="$(echo "$mem" | awk '{print $3}')" && comp_b="$(echo "$mem" | awk '{print $6}')"
+                case "$(grep 'VALIDATION' "$logfile" | head -1)" in
+                    *PASSED*) [ "$valid" = "FAIL" ] || valid="PASS" ;;
+                    *FAILED*) valid="FAIL" ;;
+                esac
+            else
+                valid="FAIL"
+            fi
+        done
+
+        n_good="$(echo "$times" | wc -w | tr -d ' ')"
+        if [ "$n_good" -gt 0 ]; then
+            med="$(echo "$times" | tr ' ' '\n' | grep . | sort -n | awk -v n="$n_good" 'NR==int((n+1)/2){print;exit}')"
+        else
+            med="ERR"
+        fi
+
+        # The uncompressed run of the same job, and its matching size
+        plain_line="$(grep "^$alg,$gname,cpp,.*,$greedy," "$CSV" | head -1 || true)"
+        plain_med="$(echo "$plain_line" | cut -d, -f9)"
+        plain_size="$(echo "$plain_line" | cut -d, -f6)"
+        [ -z "$plain_med" ] && plain_med="NA"
+        [ -n "$plain_size" ] && [ "$size" != "$plain_size" ] && valid="FAIL"
+
+        if [ "$csr_b" != "NA" ] && [ "$comp_b" != "NA" ] && [ "$csr_b" -gt 0 ] 2>/dev/null; then
+            ratio="$(awk "BEGIN{printf \"%.3f\", $comp_b / $csr_b}")"
+        else
+            ratio="NA"
+        fi
+        if [ "$med" != "ERR" ] && [ "$plain_med" -gt 0 ] 2>/dev/null; then
+            overhead="$(awk "BEGIN{printf \"%.2f\", $med / $plain_med}")"
+        else
+            overhead="NA"
+        fi
+
+        echo "$alg,$gname,$greedy,$csr_b,$comp_b,$ratio,$plain_med,$med,$overhead,$size,$valid" >> "$COMP_CSV"
+        printf "memory=%-6s median=%-8s (plain %s) overhead=%-6s %s\n" "$ratio" "${med}ms" "${plain_med}ms" "${overhead}x" "$valid"
+    done
+fi
+
+comp_fail="$(grep -c ',FAIL$' "$COMP_CSV" || true)"
+
 # ── cross-validation ──────────────────────────────────────────────────
 echo ""
 echo "============================================="
@@ -512,6 +810,8 @@ cat >> "$REPORT" << EOF
 | Validation FAIL | $fail_count |
 | Cross-validation OK | $cross_ok |
 | Cross-validation FAIL | $cross_fail |
+| Thread scaling FAIL | $scale_fail |
+| Compressed FAIL | $comp_fail |
 
 EOF
 
@@ -545,9 +845,9 @@ for gname in $graphs; do
         row="| $alg"
         alg_size=""
         for lang in $graph_langs; do
-            plain_line="$(grep "^$alg,$gname,$lang,.*,plain," "$CSV")"
-            greedy_line="$(grep "^$alg,$gname,$lang,.*,greedy," "$CSV" | grep -v greedy-md)"
-            greedymd_line="$(grep "^$alg,$gname,$lang,.*,greedy-md," "$CSV")"
+            plain_line="$(grep "^$alg,$gname,$lang,.*,plain," "$CSV" || true)"
+            greedy_line="$(grep "^$alg,$gname,$lang,.*,greedy," "$CSV" | grep -v greedy-md || true)"
+            greedymd_line="$(grep "^$alg,$gname,$lang,.*,greedy-md," "$CSV" || true)"
 
             if [ -n "$plain_line" ]; then
                 plain_ms="$(echo "$plain_line" | cut -d, -f9)"
@@ -671,6 +971,33 @@ for gname in $graphs; do
 done
 
 echo "" >> "$REPORT"
+
+# Thread scaling curve (speedup relative to --threads 1)
+if [ "$(wc -l < "$SCALE_CSV" | tr -d ' ')" -gt 1 ]; then
+    echo "## Thread Scaling (C++, speedup vs. 1 thread)" >> "$REPORT"
+    echo "" >> "$REPORT"
+    echo "| Algorithm | Graph | Mode | Threads | Median ms | Speedup | Size | Validation |" >> "$REPORT"
+    echo "|-----------|-------|------|--------:|----------:|--------:|-----:|------------|" >> "$REPORT"
+    tail -n +2 "$SCALE_CSV" | while IFS=',' read -r alg gname mode nt med speedup size valid; do
+        short_gname="$(echo "$gname" | sed 's/general_sparse_/g_/' | sed 's/bipartite_sparse_/b_/')"
+        echo "| $alg | $short_gname | $mode | $nt | $med | ${speedup}× | $size | $valid |" >> "$REPORT"
+    done
+    echo "" >> "$REPORT"
+fi
+
+# Compressed adjacency: memory and decode overhead next to the CSR times
+if [ "$(wc -l < "$COMP_CSV" | tr -d ' ')" -gt 1 ]; then
+    echo "## Compressed Adjacency (C++, --compressed vs. CSR)" >> "$REPORT"
+    echo "" >> "$REPORT"
+    echo "| Algorithm | Graph | Mode | CSR bytes | Compressed bytes | Memory | CSR ms | Compressed ms | Overhead | Size | Validation |" >> "$REPORT"
+    echo "|-----------|-------|------|----------:|-----------------:|-------:|-------:|--------------:|---------:|-----:|------------|" >> "$REPORT"
+    tail -n +2 "$COMP_CSV" | while IFS=',' read -r alg gname mode csr_b comp_b ratio plain_med med overhead size valid; do
+        short_gname="$(echo "$gname" | sed 's/general_sparse_/g_/' | sed 's/bipartite_sparse_/b_/')"
+        echo "| $alg | $short_gname | $mode | $csr_b | $comp_b | $ratio | $plain_med | $med | ${overhead}× | $size | $valid |" >> "$REPORT"
+    done
+    echo "" >> "$REPORT"
+fi
+
 echo "---" >> "$REPORT"
 echo "*Median of $RUNS runs. Wall-clock ms reported by each implementation. Timeout: ${TIMEOUT}s.*" >> "$REPORT"
 
@@ -678,6 +1005,8 @@ echo ""
 echo "  Run:     $TIMESTAMP"
 echo "  Report:  $OUTDIR/report.md"
 echo "  CSV:     $OUTDIR/results.csv"
+echo "  Scaling: $OUTDIR/scaling.csv"
+echo "  Compressed: $OUTDIR/compressed.csv"
 echo "  Logs:    $OUTDIR/raw/"
 
 # Create/update 'latest' symlink
@@ -687,7 +1016,7 @@ echo "  Latest:  $BASEDIR/latest -> $TIMESTAMP"
 echo ""
 
 # ── verdict ───────────────────────────────────────────────────────────
-if [ "$cross_fail" -eq 0 ] && [ "$fail_count" -eq 0 ]; then
+if [ "$cross_fail" -eq 0 ] && [ "$fail_count" -eq 0 ] && [ "$scale_fail" -eq 0 ] && [ "$comp_fail" -eq 0 ]; then
     echo "============================================="
     echo "  ALL VALIDATIONS PASSED ✓"
     echo "============================================="
@@ -5,7 +5,7 @@
 #   ./run_suitesparse_benchmarks.sh                                    # defaults
 #   ./run_suitesparse_benchmarks.sh --langs cpp rust
 #   ./run_suitesparse_benchmarks.sh --algos gabow-opt mv-pure
-#   ./run_suitesparse_benchmarks.sh --mode plain greedy greedy-md
+#   ./run_suitesparse_benchmarks.sh --mode plain greedy greedy-md karp-sipser
 #   ./run_suitesparse_benchmarks.sh --graphs fe_body auto ecology1
 #   ./run_suitesparse_benchmarks.sh --runs 5 --timeout 600
 #   ./run_suitesparse_benchmarks.sh --list
@@ -18,6 +18,14 @@
 #   runs:     3 (reports median)
 #   timeout:  600s per run
 #
+# C++ runs read <graph>.csr instead of <graph>.txt when it exists; create it
+# with tools/graph_convert (memory-mapped, no parse cost).
+#
+# results.csv times (median_ms, runN_ms) are the solve alone; load_ms is the
+# C++ solvers' separately reported input + CSR build time (NA otherwise).
+# init_ms is the part of median_ms spent on the initial matching (C++, modes
+# other than plain), to judge parallel initializers against --threads 1.
+#
 # Produces:
 #   results/suitesparse/<timestamp>/report.md
 #   results/suitesparse/<timestamp>/results.csv
@@ -112,8 +120,8 @@ done
 # Validate mode values
 for m in $F_MODE; do
     case "$m" in
-        plain|greedy|greedy-md) ;;
-        *) echo "ERROR: --mode values must be plain, greedy, or greedy-md (got: $m)"; exit 1 ;;
+        plain|greedy|greedy-md|karp-sipser) ;;
+        *) echo "ERROR: --mode values must be plain, greedy, greedy-md, or karp-sipser (got: $m)"; exit 1 ;;
     esac
 done
 
@@ -187,6 +195,11 @@ add_to_plan() {
         return
     fi
 
+    # Karp-Sipser initialization exists in the C++ solvers only
+    if [ "$mode" = "karp-sipser" ] && [ "$lang" != "cpp" ]; then
+        return
+    fi
+
     plan_count=$((plan_count + 1))
     PLAN="$PLAN
 $alg|$graph|$lang|$gname|$v|$mode"
@@ -267,7 +280,7 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
             bin="$ALGO/$dir/cpp/${base}_cpp"
             [ -f "$src" ] || continue
             printf "  compile %-20s %-6s " "$alg" "cpp"
-            if g++ -O3 -std=c++17 "$src" -o "$bin" 2>/dev/null; then
+            if g++ -O3 -std=c++17 -pthread -I"$REPO/include" "$src" -o "$bin" 2>/dev/null; then
                 echo "✓"
             else
                 echo "✗"
@@ -298,7 +311,7 @@ echo ""
 
 mkdir -p "$OUTDIR/raw"
 CSV="$OUTDIR/results.csv"
-echo "algo,graph,lang,vertices,mode,matching_size,greedy_init_size,greedy_pct,median_ms,run1_ms,run2_ms,run3_ms,validation" > "$CSV"
+echo "algo,graph,lang,vertices,mode,matching_size,greedy_init_size,greedy_pct,median_ms,run1_ms,run2_ms,run3_ms,validation,load_ms,init_ms" > "$CSV"
 
 job=0
 echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
@@ -311,12 +324,15 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
 
     printf "  [%3d/%d] %-18s %-6s %-10s %-25s " "$job" "$plan_count" "$alg" "$lang" "$greedy" "$gname"
 
-    # Determine executable
+    # Determine executable and input file
+    input="$graph"
     case "$lang" in
         cpp)
             bin="$ALGO/$dir/cpp/${base}_cpp"
             [ -x "$bin" ] || { echo "SKIP (not compiled)"; continue; }
             cmd="$bin"
+            # Prefer the pre-built binary CSR next to the text file (tools/graph_convert)
+            [ -f "${graph%.txt}.csr" ] && input="${graph%.txt}.csr"
             ;;
         rust)
             bin="$ALGO/$dir/rust/${base}_rust"
@@ -334,9 +350,12 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
     extra_args=""
     [ "$greedy" = "greedy" ] && extra_args="--greedy"
     [ "$greedy" = "greedy-md" ] && extra_args="--greedy-md"
+    [ "$greedy" = "karp-sipser" ] && extra_args="--karp-sipser"
 
     # Run N times
     times=""
+    loads=""
+    inits=""
     size="ERR"
     greedy_init="NA"
     greedy_pct="NA"
@@ -347,14 +366,18 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
         run_i=$((run_i + 1))
         logfile="${logbase}_run${run_i}.log"
 
-        if run_with_timeout "$TIMEOUT" $cmd "$graph" $extra_args > "$logfile" 2>&1; then
+        if run_with_timeout "$TIMEOUT" $cmd "$input" $extra_args > "$logfile" 2>&1; then
             t="$(grep '^Time:' "$logfile" | awk '{print $2}')"
+            lt="$(grep '^Load time:' "$logfile" | awk '{print $3}')"
             s="$(grep '^Matching size:' "$logfile" | tail -1 | awk '{print $3}')"
             gi="$(grep '^Greedy init size:' "$logfile" | awk '{print $4}')"
             gp="$(grep '^Greedy/Final:' "$logfile" | awk '{print $2}')"
+            it="$(grep '^Greedy init time:' "$logfile" | awk '{print $4}')"
             vl="$(grep 'VALIDATION' "$logfile" | head -1)"
 
             [ -n "$t" ] && times="$times $t" || times="$times ERR"
+            [ -n "$lt" ] && loads="$loads $lt"
+            [ -n "$it" ] && inits="$inits $it"
             [ -n "$s" ] && size="$s"
             [ -n "$gi" ] && greedy_init="$gi"
             [ -n "$gp" ] && greedy_pct="$gp"
@@ -369,7 +392,7 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
     done
 
     # Compute median
-    clean_times="$(echo "$times" | tr ' ' '\n' | grep -v ERR | grep -v TIMEOUT | sort -n)"
+    clean_times="$(echo "$times" | tr ' ' '\n' | grep -v ERR | grep -v TIMEOUT | grep . | sort -n)"
     n_good="$(echo "$clean_times" | grep -c . || true)"
 
     if [ "$n_good" -gt 0 ]; then
@@ -378,6 +401,18 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
         med="ERR"
     fi
 
+    # Load time (input + CSR build) is reported separately by the C++ solvers
+    load_med="NA"
+    if [ -n "$loads" ]; then
+        n_load="$(echo "$loads" | wc -w | tr -d ' ')"
+        load_med="$(echo "$loads" | tr ' ' '\n' | grep . | sort -n | awk -v n="$n_load" 'NR==int((n+1)/2){print;exit}')"
+    fi
+    init_med="NA"
+    if [ -n "$inits" ]; then
+        n_init="$(echo "$inits" | wc -w | tr -d ' ')"
+        init_med="$(echo "$inits" | tr ' ' '\n' | grep . | sort -n | awk -v n="$n_init" 'NR==int((n+1)/2){print;exit}')"
+    fi
+
     # Pad times to 3 fields for CSV
     t1="$(echo "$times" | awk '{print $1}')"
     t2="$(echo "$times" | awk '{print $2}')"
@@ -386,9 +421,9 @@ echo "$PLAN" | while IFS='|' read -r alg graph lang gname v greedy; do
     [ -z "$t2" ] && t2="-"
     [ -z "$t3" ] && t3="-"
 
-    echo "$alg,$gname,$lang,$v,$greedy,$size,$greedy_init,$greedy_pct,$med,$t1,$t2,$t3,$valid" >> "$CSV"
+    echo "$alg,$gname,$lang,$v,$greedy,$size,$greedy_init,$greedy_pct,$med,$t1,$t2,$t3,$valid,$load_med,$init_med" >> "$CSV"
 
-    if [ "$greedy" = "greedy" ] || [ "$greedy" = "greedy-md" ]; then
+    if [ "$greedy" != "plain" ]; then
         printf "size=%-8s median=%-8s %-6s greedy_init=%-8s (%s)\n" "$size" "${med}ms" "$valid" "$greedy_init" "$greedy_pct"
     else
         printf "size=%-8s median=%-8s %s\n" "$size" "${med}ms" "$valid"
@@ -501,9 +536,9 @@ for gname in $graphs; do
         row="| $alg"
         alg_size=""
         for lang in $graph_langs; do
-            plain_line="$(grep "^$alg,$gname,$lang,.*,plain," "$CSV")"
-            greedy_line="$(grep "^$alg,$gname,$lang,.*,greedy," "$CSV" | grep -v greedy-md)"
-            greedymd_line="$(grep "^$alg,$gname,$lang,.*,greedy-md," "$CSV")"
+            plain_line="$(grep "^$alg,$gname,$lang,.*,plain," "$CSV" || true)"
+            greedy_line="$(grep "^$alg,$gname,$lang,.*,greedy," "$CSV" | grep -v greedy-md || true)"
+            greedymd_line="$(grep "^$alg,$gname,$lang,.*,greedy-md," "$CSV" || true)"
 
             if [ -n "$plain_line" ]; then
                 plain_ms="$(echo "$plain_line" | cut -d, -f9)"
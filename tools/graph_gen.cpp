@@ -0,0 +1,380 @@
+/*
+ * graph_gen — seeded synthetic graph generator for scaling benchmarks
+ *
+ * Writes the binary CSR format (binary_format.hpp) directly, or a text
+ * edge list with --text. Edges are drawn into fixed-size blocks, each from
+ * its own random stream derived from the seed and the block number, and
+ * blocks are split across threads; the graph depends on the seed and the
+ * parameters only, never on --threads. The CSR is built by Graph's
+ * parallel counting sort, which drops the self-loops and duplicate edges a
+ * random draw produces, so the edge count written can be a little below
+ * the one requested. Past 2^31 - 1 arcs it is built as a Graph64 and
+ * written with 64-bit offsets.
+ *
+ * Families (--bipartite: left vertices --n, right vertices --right,
+ * default --n):
+ *
+ *   er        Erdos-Renyi G(n, m): m uniform random pairs
+ *   rmat      R-MAT with the Graph500 quadrant probabilities
+ *             (0.57, 0.19, 0.19, 0.05) over ceil(log2 n) levels, vertex ids
+ *             shuffled afterwards so hubs do not cluster at low ids
+ *   regular   random d-regular: the union of d/2 random permutations
+ *             (edges i - p(i)), plus a random perfect matching when d is
+ *             odd; bipartite: d permutations of n left onto n right.
+ *             Nearly regular once repeated edges are dropped.
+ *   grid      2D grid of about n cells in floor(sqrt(n)) rows,
+ *             4-neighborhood, each edge kept with probability --keep
+ *             (road-like below 1); the bipartite variant splits the n
+ *             cells by color, as a checkerboard
+ *   blossom   odd cycles of --cycle vertices (default 5), each linked to
+ *             the previous cycle and by one random chord to an earlier
+ *             cycle: every cycle leaves one vertex exposed, and augmenting
+ *             paths run through nested blossoms (Edmonds, Gabow and MV
+ *             shrink and expand constantly). General graphs only.
+ *
+ * Sizes accept k, m and b suffixes (100k, 1m, 1b).
+ *
+ * Usage:
+ *   graph_gen <family> [--bipartite] --n N [--right R] [--degree D]
+ *             [--edges M] [--keep P] [--cycle L] [--seed S] [--threads T]
+ *             [--text] <output>
+ *
+ *   --degree D   average degree (er, rmat; default 4): m = n * D / 2, or
+ *                n * D for bipartite graphs (D per left vertex); the degree
+ *                d of regular (default 4)
+ *   --edges M    edge count for er and rmat, instead of --degree
+ *   --seed S     default 1
+ *
+ * Examples (the names run_large_benchmarks.sh looks for):
+ *   graph_gen er --n 1m --degree 8 data/large-benchmarks/general_sparse_1m_1.csr
+ *   graph_gen rmat --bipartite --n 1m --degree 8 data/large-benchmarks/bipartite_sparse_1m_1.csr
+ *
+ * Build: g++ -O3 -std=c++17 -pthread -I../include graph_gen.cpp -o graph_gen
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <chrono>
+#include <vector>
+
+#include "matching/binary_format.hpp"
+#include "matching/graph.hpp"
+#include "matching/io.hpp"
+#include "matching/parallel.hpp"
+
+using matching::NIL;
+
+/* Slots per random stream for er and rmat; fixed, so the output does not
+   depend on the thread count */
+static const size_t EDGE_BLOCK = 1 << 16;
+/* Rows (grid) or cycles (blossom) per random stream */
+static const int ROW_BLOCK = 64;
+static const int CYCLE_BLOCK = 4096;
+
+/* Graph500 R-MAT quadrant thresholds out of 65536: a, a + b, a + b + c */
+static const uint32_t RMAT_A = 37356;     /* 0.57 */
+static const uint32_t RMAT_AB = 49807;    /* 0.76 */
+static const uint32_t RMAT_ABC = 62259;   /* 0.95 */
+
+/* xoshiro256**, seeded through splitmix64 from (seed, stream) */
+struct Rng {
+    uint64_t s[4];
+
+    Rng(uint64_t seed, uint64_t stream) {
+        uint64_t x = seed * 0x9E3779B97F4A7C15ull ^ (stream + 1) * 0xD1B54A32D192ED03ull;
+        for (int i = 0; i < 4; i++) {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t r = rotl(s[1] * 5, 7) * 9, t = s[1] << 17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return r;
+    }
+
+    /* Uniform in [0, n), n < 2^32 (multiply-shift) */
+    uint32_t below(uint64_t n) { return (uint32_t)(((next() >> 32) * n) >> 32); }
+
+    double uniform() { return (double)(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+/* Streams above this are the vertex shuffles, below it the edge blocks */
+static const uint64_t SHUFFLE_STREAM = 1ull << 62;
+
+struct Params {
+    std::string family;
+    bool bipartite = false;
+    long long n = 0, right = 0, edges = 0;
+    double degree = 4, keep = 1.0;
+    int cycle = 5;
+    uint64_t seed = 1;
+    int threads = 0;
+    bool text = false;
+    const char* output = nullptr;
+};
+
+/* Generated graph before the CSR build */
+struct Generated {
+    int n = 0, right = 0;
+    matching::EdgeList edges;   /* {NIL, NIL} slots are dropped by the build */
+};
+
+/* Run fn(b) for every block b in [0, blocks), contiguous ranges per thread */
+template <class F>
+static void for_blocks(size_t blocks, int threads, F&& fn) {
+    int T = (int)std::min<size_t>((size_t)matching::resolve_threads(threads), std::max<size_t>(blocks, 1));
+    matching::run_parallel(T, [&](int t) {
+        for (size_t b = matching::chunk_begin(blocks, T, t); b < matching::chunk_begin(blocks, T, t + 1); b++) fn(b);
+    });
+}
+
+/* Uniform random permutation of [0, n) from `stream` (Fisher-Yates) */
+static std::vector<int> random_permutation(int n, uint64_t seed, uint64_t stream) {
+    std::vector<int> p(n);
+    for (int i = 0; i < n; i++) p[i] = i;
+    Rng rng(seed, stream);
+    for (int i = n - 1; i > 0; i--) std::swap(p[i], p[rng.below((uint64_t)i + 1)]);
+    return p;
+}
+
+/* m random edges from draw(rng), in EDGE_BLOCK streams */
+template <class Draw>
+static void fill_random(Generated& out, size_t m, const Params& p, Draw&& draw) {
+    out.edges.resize(m);
+    for_blocks((m + EDGE_BLOCK - 1) / EDGE_BLOCK, p.threads, [&](size_t b) {
+        Rng rng(p.seed, b);
+        size_t hi = std::min(m, (b + 1) * EDGE_BLOCK);
+        for (size_t i = b * EDGE_BLOCK; i < hi; i++) out.edges[i] = draw(rng);
+    });
+}
+
+static size_t edge_target(const Params& p) {
+    if (p.edges > 0) return (size_t)p.edges;
+    double m = p.bipartite ? p.n * p.degree : p.n * p.degree / 2;
+    return (size_t)std::llround(m);
+}
+
+static void gen_er(const Params& p, Generated& out) {
+    int n = out.n, right = out.right;
+    if (n == 0 || right == 0 || (!p.bipartite && n < 2)) return;
+    fill_random(out, edge_target(p), p, [&](Rng& rng) {
+        int u = (int)rng.below(n);
+        if (p.bipartite) return matching::Edge(u, (int)rng.below(right));
+        int v = (int)rng.below(n - 1);
+        return matching::Edge(u, v >= u ? v + 1 : v);
+    });
+}
+
+static void gen_rmat(const Params& p, Generated& out) {
+    int n = out.n, right = out.right;
+    if (n == 0 || right == 0 || (!p.bipartite && n < 2)) return;
+    int levels = 0;
+    while ((1ll << levels) < std::max(n, right)) levels++;
+    std::vector<int> perm_left, perm_right;
+    matching::run_parallel(p.bipartite ? 2 : 1, [&](int side) {
+        if (side == 0) perm_left = random_permutation(n, p.seed, SHUFFLE_STREAM);
+        else perm_right = random_permutation(right, p.seed, SHUFFLE_STREAM + 1);
+    });
+    const std::vector<int>& pr = p.bipartite ? perm_right : perm_left;
+    fill_random(out, edge_target(p), p, [&](Rng& rng) {
+        for (;;) {
+            long long u = 0, v = 0;
+            uint64_t bits = 0;
+            for (int l = 0; l < levels; l++) {
+                if (l % 4 == 0) bits = rng.next();
+                uint32_t r = (uint32_t)(bits & 0xFFFF);
+                bits >>= 16;
+                int du = r >= RMAT_AB, dv = (r >= RMAT_A && r < RMAT_AB) || r >= RMAT_ABC;
+                u = 2 * u + du;
+                v = 2 * v + dv;
+            }
+            if (u < n && v < right && (p.bipartite || u != v))
+                return matching::Edge(perm_left[u], pr[v]);
+        }
+    });
+}
+
+static bool gen_regular(const Params& p, Generated& out) {
+    int n = out.n, d = (int)p.degree;
+    if (d != p.degree || d < 1) { fprintf(stderr, "regular: --degree must be a positive integer\n"); return false; }
+    if (p.bipartite && out.right != n) { fprintf(stderr, "regular: --right must equal --n\n"); return false; }
+    if (n < 2) return true;
+    int perms = p.bipartite ? d : d / 2;
+    bool matching_round = !p.bipartite && d % 2 == 1;
+    out.edges.resize((size_t)perms * n + (matching_round ? (size_t)n / 2 : 0));
+    for_blocks((size_t)perms + matching_round, p.threads, [&](size_t k) {
+        std::vector<int> q = random_permutation(n, p.seed, SHUFFLE_STREAM + k);
+        matching::Edge* e = out.edges.data() + k * n;
+        if ((int)k < perms)
+            for (int i = 0; i < n; i++) e[i] = {i, q[i]};
+        else
+            for (int i = 0; i + 1 < n; i += 2) e[i / 2] = {q[i], q[i + 1]};
+    });
+    return true;
+}
+
+static void gen_grid(const Params& p, Generated& out) {
+    int rows = (int)std::sqrt((double)p.n);
+    while ((long long)(rows + 1) * (rows + 1) <= p.n) rows++;
+    int cols = rows > 0 ? (int)(p.n / rows) : 0;
+    long long cells = (long long)rows * cols;
+
+    /* Bipartite: cell (r, c) is left when r + c is even. Either color
+       takes every other column of a row, so its rank in the row is c / 2. */
+    std::vector<long long> even_before(rows + 1, 0);
+    for (int r = 0; r < rows; r++) even_before[r + 1] = even_before[r] + (cols + 1 - (r & 1)) / 2;
+    auto id = [&](int r, int c) -> int {
+        if (!p.bipartite) return r * cols + c;
+        long long before = (r + c) % 2 == 0 ? even_before[r] : (long long)r * cols - even_before[r];
+        return (int)(before + c / 2);
+    };
+    if (p.bipartite) {
+        out.n = (int)even_before[rows];
+        out.right = (int)(cells - even_before[rows]);
+    } else {
+        out.n = out.right = (int)cells;
+    }
+    out.edges.assign((size_t)cells * 2, {NIL, NIL});
+    for_blocks(((size_t)rows + ROW_BLOCK - 1) / ROW_BLOCK, p.threads, [&](size_t b) {
+        Rng rng(p.seed, b);
+        for (int r = (int)(b * ROW_BLOCK); r < std::min(rows, (int)((b + 1) * ROW_BLOCK)); r++)
+            for (int c = 0; c < cols; c++) {
+                matching::Edge* slot = out.edges.data() + 2 * ((size_t)r * cols + c);
+                int ax[2] = {r, r + 1}, ay[2] = {c + 1, c};
+                for (int k = 0; k < 2; k++) {
+                    if (ax[k] >= rows || ay[k] >= cols || (p.keep < 1.0 && rng.uniform() >= p.keep)) continue;
+                    bool swap = p.bipartite && (r + c) % 2 == 1;
+                    int a = id(r, c), z = id(ax[k], ay[k]);
+                    slot[k] = swap ? matching::Edge(z, a) : matching::Edge(a, z);
+                }
+            }
+    });
+}
+
+static bool gen_blossom(const Params& p, Generated& out) {
+    int L = p.cycle;
+    if (p.bipartite) { fprintf(stderr, "blossom: bipartite graphs have no odd cycles\n"); return false; }
+    if (L < 3 || L % 2 == 0) { fprintf(stderr, "blossom: --cycle must be odd and at least 3\n"); return false; }
+    int cycles = (int)(p.n / L);
+    out.n = out.right = cycles * L;
+    size_t per = (size_t)L + 2;
+    out.edges.assign((size_t)cycles * per, {NIL, NIL});
+    for_blocks(((size_t)cycles + CYCLE_BLOCK - 1) / CYCLE_BLOCK, p.threads, [&](size_t b) {
+        Rng rng(p.seed, b);
+        for (int k = (int)(b * CYCLE_BLOCK); k < std::min(cycles, (int)((b + 1) * CYCLE_BLOCK)); k++) {
+            matching::Edge* slot = out.edges.data() + (size_t)k * per;
+            int base = k * L;
+            for (int i = 0; i < L; i++) slot[i] = {base + i, base + (i + 1) % L};
+            if (k == 0) continue;
+            slot[L] = {base, base - L + L / 2};
+            int earlier = (int)rng.below((uint64_t)k);
+            slot[L + 1] = {base + 1 + (int)rng.below((uint64_t)L - 1), earlier * L + (int)rng.below((uint64_t)L)};
+        }
+    });
+    return true;
+}
+
+/* 100k, 1m, 2b; false if malformed */
+static bool parse_count(const char* s, long long& out) {
+    char* end;
+    double v = strtod(s, &end);
+    double mult = 1;
+    if (*end == 'k' || *end == 'K') mult = 1e3, end++;
+    else if (*end == 'm' || *end == 'M') mult = 1e6, end++;
+    else if (*end == 'b' || *end == 'B' || *end == 'g' || *end == 'G') mult = 1e9, end++;
+    if (end == s || *end != '\0' || v < 0) return false;
+    out = std::llround(v * mult);
+    return true;
+}
+
+static bool parse_params(int argc, char* argv[], Params& p) {
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        bool ok = true;
+        if (a == "--bipartite") p.bipartite = true;
+        else if (a == "--text") p.text = true;
+        else if (a == "--n" && has_value) ok = parse_count(argv[++i], p.n);
+        else if (a == "--right" && has_value) ok = parse_count(argv[++i], p.right);
+        else if (a == "--edges" && has_value) ok = parse_count(argv[++i], p.edges);
+        else if (a == "--degree" && has_value) p.degree = atof(argv[++i]);
+        else if (a == "--keep" && has_value) p.keep = atof(argv[++i]);
+        else if (a == "--cycle" && has_value) p.cycle = atoi(argv[++i]);
+        else if (a == "--seed" && has_value) p.seed = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--threads" && has_value) p.threads = atoi(argv[++i]);
+        else if (p.family.empty()) p.family = a;
+        else if (!p.output) p.output = argv[i];
+        else ok = false;
+        if (!ok) { fprintf(stderr, "Bad argument: %s\n", argv[i]); return false; }
+    }
+    if (p.right == 0) p.right = p.n;
+    if (p.n <= 0 || p.n > INT32_MAX || p.right > INT32_MAX) {
+        fprintf(stderr, "--n and --right must be in [1, 2^31 - 1]\n");
+        return false;
+    }
+    return !p.family.empty() && p.output;
+}
+
+int main(int argc, char* argv[]) {
+    Params p;
+    if (!parse_params(argc, argv, p)) {
+        fprintf(stderr, "Usage: %s er|rmat|regular|grid|blossom [--bipartite] --n N [--right R] [--degree D] "
+                        "[--edges M] [--keep P] [--cycle L] [--seed S] [--threads T] [--text] <output>\n", argv[0]);
+        return 1;
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    Generated g;
+    g.n = (int)p.n;
+    g.right = p.bipartite ? (int)p.right : (int)p.n;
+    bool ok = true;
+    if (p.family == "er") gen_er(p, g);
+    else if (p.family == "rmat") gen_rmat(p, g);
+    else if (p.family == "regular") ok = gen_regular(p, g);
+    else if (p.family == "grid") gen_grid(p, g);
+    else if (p.family == "blossom") ok = gen_blossom(p, g);
+    else { fprintf(stderr, "Unknown family: %s\n", p.family.c_str()); return 1; }
+    if (!ok) return 1;
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    /* Build, write and report with int offsets, or int64_t past 2^31 - 1 arcs */
+    auto emit = [&](auto graph) {
+        graph = p.bipartite ? decltype(graph)::bipartite(g.n, g.right, g.edges, p.threads)
+                            : decltype(graph)::general(g.n, g.edges, p.threads);
+        matching::EdgeList().swap(g.edges);
+        auto t2 = std::chrono::high_resolution_clock::now();
+
+        if (!(p.text ? matching::write_text_graph(p.output, graph) : matching::write_binary_graph(p.output, graph)))
+            return 1;
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        auto ms = [](auto d) { return (long)std::chrono::duration_cast<std::chrono::milliseconds>(d).count(); };
+        long long m = (long long)graph.num_edges();
+        if (graph.is_bipartite())
+            fprintf(stderr, "%s: %s, %d left, %d right, %lld edges (generate %ld ms, build %ld ms, write %ld ms)\n",
+                    p.output, p.family.c_str(), graph.num_vertices(), graph.num_right(), m, ms(t1 - t0),
+                    ms(t2 - t1), ms(t3 - t2));
+        else
+            fprintf(stderr, "%s: %s, %d vertices, %lld edges, avg degree %.1f (generate %ld ms, build %ld ms, write %ld ms)\n",
+                    p.output, p.family.c_str(), graph.num_vertices(), m,
+                    graph.num_vertices() > 0 ? 2.0 * m / graph.num_vertices() : 0.0, ms(t1 - t0), ms(t2 - t1),
+                    ms(t3 - t2));
+        return 0;
+    };
+    if (matching::needs_wide_offsets(matching::arcs_for(g.edges.size(), p.bipartite)))
+        return emit(matching::Graph64());
+    return emit(matching::Graph());
+}